@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/generation/circuit_generator.hpp"
+#include "src/utility/logger.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+std::string const AIG_BASIS   = "AIG";
+std::string const BENCH_BASIS = "BENCH";
+
+// Size of the output stream buffer. Large buffer speeds up writing of huge circuits.
+constexpr size_t OUTPUT_BUFFER_SIZE = 1 << 22;
+
+/**
+ * Generates synthetic circuit of a parameterized family and writes it to a `.bench` file.
+ * Gates are written as soon as they are generated, so circuits of hundreds of millions of
+ * gates may be produced without keeping them in memory.
+ */
+int main(int argn, char** argv)
+{
+    csat::Logger logger("CircuitGenerator");
+
+    argparse::ArgumentParser program("circuit_generator");
+    program.add_argument("-f", "--family")
+        .required()
+        .help("circuit family [adder|multiplier|multiplier_miter|random|parity]");
+    program.add_argument("-o", "--output").required().help("path to resulting .BENCH file");
+    program.add_argument("-b", "--basis").default_value(std::string(BENCH_BASIS)).help("Choose basis [AIG|BENCH]");
+    program.add_argument("-n", "--size")
+        .default_value(std::size_t{1'000})
+        .scan<'u', std::size_t>()
+        .help("bit width of adders and multipliers, number of operations of random circuits, or number of parity "
+              "inputs");
+    program.add_argument("--inputs")
+        .default_value(std::size_t{1'000})
+        .scan<'u', std::size_t>()
+        .help("number of inputs of random circuits");
+    program.add_argument("--outputs")
+        .default_value(std::size_t{1})
+        .scan<'u', std::size_t>()
+        .help("number of outputs of random and parity circuits");
+    program.add_argument("--depth")
+        .default_value(std::size_t{100})
+        .scan<'u', std::size_t>()
+        .help("number of levels of random circuits");
+    program.add_argument("--max-fanout")
+        .default_value(std::size_t{8})
+        .scan<'u', std::size_t>()
+        .help("soft limit of fan-out of random circuits nodes");
+    program.add_argument("--width")
+        .default_value(std::size_t{0})
+        .scan<'u', std::size_t>()
+        .help("number of inputs of each parity tree, all inputs if zero");
+    program.add_argument("--seed").default_value(std::size_t{42}).scan<'u', std::size_t>().help("random seed");
+
+    program.add_description(
+        "Generates synthetic circuits, which are used to measure how the simplifier scales\n"
+        "with the circuit size. Families are:\n"
+        "\n"
+        "    adder            -- ripple carry adder of two `--size`-bit numbers;\n"
+        "    multiplier       -- array multiplier of two `--size`-bit numbers;\n"
+        "    multiplier_miter -- unsatisfiable miter of two multipliers, which sum\n"
+        "                        partial products in different order;\n"
+        "    random           -- random circuit of `--size` operations, split into `--depth`\n"
+        "                        levels, whose fan-out is limited by `--max-fanout`;\n"
+        "    parity           -- `--outputs` XOR trees over `--width` of `--size` inputs.\n"
+        "\n"
+        "Circuits of `AIG` basis consist of AND and NOT gates only.\n"
+        "\n"
+        "Example usage command:\n"
+        "\n"
+        "    ./build/circuit_generator -f multiplier_miter -n 1300 -b AIG -o miter.bench\n"
+        "");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    csat::generation::GeneratorParameters parameters{};
+    parameters.family = csat::generation::stringToFamily(program.get<std::string>("--family"));
+    std::string const basis = program.get<std::string>("--basis");
+    if (basis == AIG_BASIS)
+    {
+        parameters.basis = csat::Basis::AIG;
+    }
+    else if (basis == BENCH_BASIS)
+    {
+        parameters.basis = csat::Basis::BENCH;
+    }
+    else
+    {
+        std::cerr << "Incorrect basis! Choose one of [AIG, BENCH]" << std::endl;
+        std::abort();
+    }
+    parameters.size       = program.get<std::size_t>("--size");
+    parameters.inputs     = program.get<std::size_t>("--inputs");
+    parameters.outputs    = program.get<std::size_t>("--outputs");
+    parameters.depth      = program.get<std::size_t>("--depth");
+    parameters.max_fanout = program.get<std::size_t>("--max-fanout");
+    parameters.width      = program.get<std::size_t>("--width");
+    parameters.seed       = program.get<std::size_t>("--seed");
+
+    std::string const output_path = program.get<std::string>("--output");
+    std::vector<char> buffer(OUTPUT_BUFFER_SIZE);
+    std::ofstream file_out;
+    file_out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file_out.open(output_path);
+    if (!file_out)
+    {
+        std::cerr << "Can't open output file " << output_path << std::endl;
+        std::abort();
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    csat::generation::BenchSink sink(file_out);
+    csat::generation::generateCircuit(sink, parameters);
+    sink.finish();
+    double const duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    logger.info("Generated ", sink.getNumberOfGates(), " gates to ", output_path, " in ", duration, " sec.");
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/simplification/utils/circuits_db.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+std::string const DEFAULT_DATABASES_PATH = "databases/";
+
+/**
+ * Compiles text databases of (nearly) optimal small circuits into binary images,
+ * which `simplifier` memory-maps without parsing. For each basis the text database
+ * `database_<basis>.txt` is compiled into `database_<basis>.bin` in the same directory.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("db_compiler");
+    program.add_argument("-d", "--databases")
+        .default_value(std::string(DEFAULT_DATABASES_PATH))
+        .help("path to directory with text databases, images are written next to them");
+    program.add_argument("-b", "--basis").help("compile only database of given basis [AIG|BENCH]");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    // Name of basis, name of its database file and basis itself.
+    std::vector<std::tuple<std::string, std::string, csat::Basis>> databases{
+        {"BENCH", "database_bench", csat::Basis::BENCH},
+        {"AIG", "database_aig", csat::Basis::AIG}};
+    if (program.is_used("--basis"))
+    {
+        auto const basis = program.get<std::string>("--basis");
+        std::erase_if(databases, [&basis](auto const& database) { return std::get<0>(database) != basis; });
+        if (databases.empty())
+        {
+            std::cerr << "Incorrect basis! Choose one of [AIG, BENCH]" << std::endl;
+            std::abort();
+        }
+    }
+
+    std::filesystem::path const databases_path = program.get<std::string>("--databases");
+    bool compiled_any                          = false;
+    for (auto const& [basis_name, file_name, basis] : databases)
+    {
+        std::filesystem::path const text_path  = databases_path / (file_name + ".txt");
+        std::filesystem::path const image_path = databases_path / (file_name + ".bin");
+        if (!std::filesystem::exists(text_path))
+        {
+            continue;
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        csat::simplification::CircuitDB const database(text_path, basis);
+        database.writeImage(image_path);
+        double const duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << text_path.string() << " -> " << image_path.string() << ": " << database.size() << " circuits, "
+                  << std::filesystem::file_size(image_path) << " bytes, " << duration << " sec." << std::endl;
+        compiled_any = true;
+    }
+
+    if (!compiled_any)
+    {
+        std::cerr << "There are no text databases at " << databases_path.string() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,86 +1,104 @@
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #include "src/parser/bench_to_circuit.hpp"
-#include "src/simplification/composition.hpp"
-#include "src/simplification/nest.hpp"
-#include "src/simplification/strategy.hpp"
-#include "src/simplification/three_inputs_optimization.hpp"
-#include "src/simplification/three_inputs_optimization_bench.hpp"
+#include "src/simplification/pass_profile.hpp"
+#include "src/simplification/script.hpp"
+#include "src/simplification/transformer_registry.hpp"
+#include "src/structures/circuit/csr_dag.hpp"
+#include "src/structures/circuit/dag.hpp"
 #include "src/utility/encoder.hpp"
+#include "src/utility/profiler.hpp"
+#include "src/utility/thread_pool.hpp"
 #include "src/utility/write_utils.hpp"
 #include "third_party/argparse/include/argparse/argparse.hpp"
 
-// Controls the number of subcircuit minimization iterations.
-constexpr size_t NUMBER_OF_ITERATIONS = 5;
-
 std::string const AIG_BASIS              = "AIG";
 std::string const BENCH_BASIS            = "BENCH";
 std::string const DEFAULT_BASIS          = BENCH_BASIS;
+std::string const DAG_CIRCUIT            = "DAG";
+std::string const CSR_CIRCUIT            = "CSR";
+std::string const DEFAULT_CIRCUIT        = DAG_CIRCUIT;
 std::string const DEFAULT_DATABASES_PATH = "databases/";
+std::string const DEFAULT_SCRIPT         = "repeat(5){dup_ops; 3in_min}; dup_ops";
+std::string const INCREMENTAL_SCRIPT     = "incremental";
 
 /**
- * Helper for file stream opening.
+ * @return basis, chosen by the `--basis` parameter.
  */
-std::ifstream openFileStream(std::string const& file_path, csat::Logger& logger)
+csat::Basis getBasis(argparse::ArgumentParser const& program)
 {
-    std::ifstream file(file_path);
-    if (!file.is_open())
+    std::string const basis = program.get<std::string>("--basis");
+    if (basis == AIG_BASIS)
     {
-        std::cerr << "Can't open file, path is incorrect." << std::endl;
-        std::abort();
+        return csat::Basis::AIG;
     }
-    logger.debug("File opened.");
-    return file;
+    if (basis == BENCH_BASIS)
+    {
+        return csat::Basis::BENCH;
+    }
+    std::cerr << "Incorrect basis! Choose one of [AIG, BENCH]" << std::endl;
+    std::abort();
 }
 
 /**
- * Helper to run specific simplification strategies on the circuit in the provided basis.
+ * @return simplification script, chosen by the `--script` and `--incremental` parameters.
  */
-std::tuple<std::unique_ptr<csat::DAG>, std::unique_ptr<csat::utils::GateEncoder<std::string> > > applySimplification(
-    std::string const& basis,
-    std::unique_ptr<csat::DAG>& csat_instance,
-    csat::utils::GateEncoder<std::string>& encoder)
+std::string getScript(argparse::ArgumentParser const& program)
 {
-    if (basis == AIG_BASIS)
+    if (auto script = program.present("--script"))
     {
-        return csat::simplification::Composition<
-                   csat::DAG,
-                   csat::simplification::Nest<
-                       csat::DAG,
-                       NUMBER_OF_ITERATIONS,
-                       csat::simplification::DuplicateOperandsCleaner<csat::DAG>,
-                       csat::simplification::ThreeInputsSubcircuitMinimization<csat::DAG> >,
-                   csat::simplification::DuplicateOperandsCleaner<csat::DAG> >()
-            .apply(*csat_instance, encoder);
+        return *script;
     }
-    else if (basis == BENCH_BASIS)
+    return program.get<bool>("--incremental") ? INCREMENTAL_SCRIPT : DEFAULT_SCRIPT;
+}
+
+/**
+ * @return true iff circuits are to be represented by `CsrDAG`, chosen by the `--circuit` parameter.
+ */
+bool useCsrCircuit(argparse::ArgumentParser const& program)
+{
+    std::string const circuit = program.get<std::string>("--circuit");
+    if (circuit == DAG_CIRCUIT)
     {
-        return csat::simplification::Composition<
-                   csat::DAG,
-                   csat::simplification::Nest<
-                       csat::DAG,
-                       NUMBER_OF_ITERATIONS,
-                       csat::simplification::DuplicateOperandsCleaner<csat::DAG>,
-                       csat::simplification::ThreeInputsSubcircuitMinimizationBench<csat::DAG> >,
-                   csat::simplification::DuplicateOperandsCleaner<csat::DAG> >()
-            .apply(*csat_instance, encoder);
+        return false;
     }
-    else
+    if (circuit == CSR_CIRCUIT)
     {
-        std::cerr << "Incorrect basis! Choose one of [AIG, BENCH]" << std::endl;
-        std::abort();
+        return true;
     }
+    std::cerr << "Incorrect circuit representation! Choose one of [DAG, CSR]" << std::endl;
+    std::abort();
+}
+
+/**
+ * Builds simplification pipeline of the script from transformers, suitable for the basis.
+ * Transformers carry state of a single run, so each circuit gets its own pipeline.
+ */
+template<class CircuitT>
+std::unique_ptr<csat::simplification::ITransformer<CircuitT> > buildPipeline(argparse::ArgumentParser const& program)
+{
+    return csat::simplification::buildScript<CircuitT>(
+        getScript(program), csat::simplification::makeTransformerRegistry<CircuitT>(getBasis(program)));
 }
 
 /**
  * Writes resulting circuit either to an output file, or to the stdout if first is not given.
  */
+template<class CircuitT>
 void writeResult(
     argparse::ArgumentParser const& program,
-    csat::DAG const& simplified_circuit,
+    CircuitT const& simplified_circuit,
     csat::utils::GateEncoder<std::string> const& encoder,
     std::string const& file_path)
 {
@@ -89,14 +107,9 @@ void writeResult(
         std::filesystem::path output_path{*output_dir};
         std::string input_dir = program.get<std::string>("--input-path");
         // If input is a directory, treat output as directory as well.
+        // Note that output directory is created in advance by `main`.
         if (std::filesystem::is_directory(input_dir))
         {
-            // Create output directory if it doesn't exist yet.
-            if (!std::filesystem::exists(output_path))
-            {
-                std::filesystem::create_directories(output_path);
-            }
-
             // Write resulting circuit to an output path by original name.
             std::ofstream file_out(output_path / std::filesystem::path(file_path).filename());
             writeBenchFile(simplified_circuit, encoder, file_out);
@@ -110,6 +123,8 @@ void writeResult(
     }
     else
     {
+        // Circuits simplified by concurrent workers must not be interleaved in stdout.
+        std::lock_guard<std::mutex> const lock(csat::getLogStreamMutex_());
         csat::printCircuit(simplified_circuit, encoder);
     }
 }
@@ -125,36 +140,20 @@ void writeResult(
  */
 std::optional<std::ofstream> openFileStat(argparse::ArgumentParser const& program)
 {
-    std::string basis = program.get<std::string>("--basis");
-
     if (auto output_file = program.present("-s"))
     {
         std::ofstream statistics_stream(*output_file);
         statistics_stream << std::setprecision(3) << std::fixed;
         statistics_stream << "File path,Gates before,Gates after,Simplificaton time";
 
-        // The following statistics is currently supported only for AIG basis.
-        if (basis == AIG_BASIS)
-        {
-            statistics_stream << ",Reduced subcircuits by iter";
-            for (std::size_t i = 0; i < NUMBER_OF_ITERATIONS; ++i)
-            {
-                statistics_stream << ",subcircuits_number_" << i;
-            }
-            for (std::size_t i = 0; i < NUMBER_OF_ITERATIONS; ++i)
-            {
-                statistics_stream << ",skipped_subcircuits_" << i;
-            }
-            for (std::size_t i = 0; i < NUMBER_OF_ITERATIONS; ++i)
-            {
-                statistics_stream << ",max_subcircuits_size_" << i;
-            }
-            for (std::size_t i = 0; i < NUMBER_OF_ITERATIONS; ++i)
-            {
-                statistics_stream << ",circuit_size_" << i;
-            }
-            statistics_stream << ",iter_number,total_gates_in_subcircuits";
-        }
+        // Number of iterations depends on the script, so each of these columns is a `;` separated list.
+        statistics_stream << ",Reduced subcircuits by iter";
+        statistics_stream << ",subcircuits_number,skipped_subcircuits,max_subcircuits_size,circuit_size";
+        statistics_stream << ",iter_number,total_gates_in_subcircuits";
+        statistics_stream << ",sweep_candidates,sweep_equivalent_merges,sweep_complementary_merges";
+        statistics_stream << ",sweep_unproven,sweep_time";
+        statistics_stream << ",worklist_processed_gates,worklist_rewritten_gates,worklist_replaced_gates";
+        statistics_stream << ",worklist_resubstituted_gates,worklist_time";
         statistics_stream << "\n";
 
         return statistics_stream;
@@ -166,7 +165,7 @@ std::optional<std::ofstream> openFileStat(argparse::ArgumentParser const& progra
  * Helper to dump a vector to ofstream.
  */
 template<class T>
-void dumpVector(std::ofstream& stream, std::vector<T> const& vec)
+void dumpVector(std::ostream& stream, std::vector<T> const& vec)
 {
     stream << "," << "[";
     if (!vec.empty())
@@ -181,68 +180,99 @@ void dumpVector(std::ofstream& stream, std::vector<T> const& vec)
 }
 
 /**
- * Dumps current subcircuit simplification statistics to the stats file.
+ * Helper to dump one statistics value of each performed iteration as a list.
+ */
+template<class Getter>
+void dumpIterationsValue(
+    std::ostream& stream,
+    std::vector<csat::simplification::IterationStats> const& iterations,
+    Getter getter)
+{
+    std::vector<std::size_t> values{};
+    values.reserve(iterations.size());
+    for (auto const& iteration : iterations)
+    {
+        values.push_back(getter(iteration));
+    }
+    dumpVector(stream, values);
+}
+
+/**
+ * Dumps statistics of a finished simplification run to the stats file.
  */
 void dumpStatistics(
-    std::ofstream& statistics_stream,
-    std::string const& basis,
+    std::ostream& statistics_stream,
+    csat::simplification::SimplificationContext const& context,
     std::string const& file_path,
     std::size_t gatesBefore,
     std::size_t gatesAfter,
     long double simplifyTime)
 {
+    using csat::simplification::IterationStats;
+
     statistics_stream << std::setprecision(3) << std::fixed;
     statistics_stream << file_path << "," << gatesBefore << "," << gatesAfter << "," << simplifyTime;
 
-    // The following statistics is currently supported only for AIG basis.
-    if (basis == AIG_BASIS)
-    {
-        dumpVector(
-            statistics_stream, csat::simplification::CircuitStatsSingleton::getInstance().reduced_subcircuit_by_iter);
+    csat::simplification::CircuitStats const& stats = context.stats;
+    std::vector<IterationStats> const iterations    = stats.getIterations();
 
-        for (auto t : csat::simplification::CircuitStatsSingleton::getInstance().subcircuits_number_by_iter)
-        {
-            statistics_stream << "," << t;
-        }
-        for (auto t : csat::simplification::CircuitStatsSingleton::getInstance().skipped_subcircuits_by_iter)
-        {
-            statistics_stream << "," << t;
-        }
-        for (auto t : csat::simplification::CircuitStatsSingleton::getInstance().max_subcircuit_size_by_iter)
-        {
-            statistics_stream << "," << t;
-        }
-        for (auto t : csat::simplification::CircuitStatsSingleton::getInstance().circuit_size_by_iter)
-        {
-            statistics_stream << "," << t;
-        }
-        statistics_stream << "," << csat::simplification::CircuitStatsSingleton::getInstance().iter_number << ","
-                          << csat::simplification::CircuitStatsSingleton::getInstance().total_gates_in_subcircuits;
-    }
+    dumpIterationsValue(statistics_stream, iterations, [](IterationStats const& it) { return it.reduced_subcircuits; });
+    dumpIterationsValue(statistics_stream, iterations, [](IterationStats const& it) { return it.subcircuits_number; });
+    dumpIterationsValue(statistics_stream, iterations, [](IterationStats const& it) { return it.skipped_subcircuits; });
+    dumpIterationsValue(statistics_stream, iterations, [](IterationStats const& it) { return it.max_subcircuit_size; });
+    dumpIterationsValue(statistics_stream, iterations, [](IterationStats const& it) { return it.circuit_size; });
+
+    statistics_stream << "," << iterations.size() << "," << stats.getTotalGatesInSubcircuits();
+
+    csat::simplification::SweepStats const& sweep_stats = context.sweep_stats;
+    statistics_stream << "," << sweep_stats.candidates << "," << sweep_stats.equivalent_merges << ","
+                      << sweep_stats.complementary_merges << "," << sweep_stats.unproven << "," << sweep_stats.time;
+
+    csat::simplification::WorklistStats const& worklist_stats = context.worklist_stats;
+    statistics_stream << "," << worklist_stats.processed_gates << "," << worklist_stats.rewritten_gates << ","
+                      << worklist_stats.replaced_gates << "," << worklist_stats.resubstituted_gates << ","
+                      << worklist_stats.time;
     statistics_stream << "\n";
 }
 
 /**
- * Performs simplification of a circuit located at the `instance_path`.
+ * Performs simplification of a circuit located at the `instance_path`, represented by `CircuitT`.
  *
  * @param instance_path path to the input circuit.
+ * @param instance_index index of the circuit among processed ones, which seeds names of new gates.
  * @param program argparse program.
  * @param logger Logger instance.
- * @param statistics_stream stream for statistics dumping (if provided).
+ * @param profile profile, to which measurements of simplification passes are written.
+ * @param pool thread pool, which passes may use to process the circuit in parallel, or nullptr.
+ * @return row of simplification statistics, formatted to be written to the stats file.
  */
-void simplifier(
+template<class CircuitT>
+std::string simplifier(
     std::string const& instance_path,
+    std::size_t instance_index,
     argparse::ArgumentParser const& program,
     csat::Logger& logger,
-    std::optional<std::ofstream>& statistics_stream)
+    csat::simplification::CircuitProfile& profile,
+    csat::utils::ThreadPool* pool)
 {
-    // Filestream for circuit reading.
-    auto circuit_fs = openFileStream(instance_path, logger);
-
-    // Parse a circuit from a file stream.
+    // Parse a circuit from a memory-mapped file.
     logger.debug("Parsing a circuit file ", instance_path, ".");
-    csat::parser::BenchToCircuit<csat::DAG> parser{};
-    parser.parseStream(circuit_fs);
+    csat::parser::BenchToCircuit<CircuitT> parser{};
+    auto parseStart         = std::chrono::steady_clock::now();
+    std::size_t parsedBytes = parser.parseFile(instance_path, program.get<std::size_t>("--parse-threads"));
+    double parseTime        = std::chrono::duration<double>(std::chrono::steady_clock::now() - parseStart).count();
+    double parsedMB         = static_cast<double>(parsedBytes) / (1024.0 * 1024.0);
+    logger.info(
+        instance_path,
+        ": parsed ",
+        std::fixed,
+        std::setprecision(3),
+        parsedMB,
+        " MB in ",
+        parseTime,
+        " s (",
+        parseTime > 0 ? parsedMB / parseTime : 0.0,
+        " MB/s).");
 
     auto encoder       = parser.getEncoder();
     auto csat_instance = parser.instantiate();
@@ -252,26 +282,223 @@ void simplifier(
     auto timeStart          = std::chrono::steady_clock::now();
 
     logger.debug(instance_path, ": simplification start.");
-    csat::simplification::CircuitStatsSingleton::getInstance().cleanState();
-
-    std::string basis = program.get<std::string>("--basis");
+    csat::simplification::SimplificationContext context{};
+    context.thread_pool = pool;
+    context.seedIds(instance_index);
 
-    auto [simplified_instance, simplified_encoder] = applySimplification(basis, csat_instance, encoder);
+    auto [simplified_instance, simplified_encoder] =
+        buildPipeline<CircuitT>(program)->apply(*csat_instance, encoder, context);
     logger.debug(instance_path, ": simplification end.");
 
     auto timeEnd           = std::chrono::steady_clock::now();
     double simplifyTime    = std::chrono::duration<double>(timeEnd - timeStart).count();
     std::size_t gatesAfter = simplified_instance->getNumberOfGatesWithoutInputs();
 
+    if (csat::simplification::SweepStats const& sweep_stats = context.sweep_stats; sweep_stats.candidates != 0)
+    {
+        logger.info(
+            instance_path,
+            ": sweeping merged ",
+            sweep_stats.getMerges(),
+            " of ",
+            sweep_stats.candidates,
+            " candidates (",
+            sweep_stats.complementary_merges,
+            " complementary, ",
+            sweep_stats.unproven,
+            " unproven).");
+    }
+    if (csat::simplification::WorklistStats const& worklist_stats = context.worklist_stats;
+        worklist_stats.processed_gates != 0)
+    {
+        logger.info(
+            instance_path,
+            ": worklist processed ",
+            worklist_stats.processed_gates,
+            " gates, rewritten ",
+            worklist_stats.rewritten_gates,
+            ", replaced ",
+            worklist_stats.replaced_gates,
+            ", resubstituted ",
+            worklist_stats.resubstituted_gates,
+            ".");
+    }
+
     writeResult(program, *simplified_instance, *simplified_encoder, instance_path);
 
-    // Dump simplification statistics if statistics path was specified.
-    if (statistics_stream.has_value())
+    std::ostringstream statistics_row;
+    dumpStatistics(statistics_row, context, instance_path, gatesBefore, gatesAfter, simplifyTime);
+    profile = {instance_path, context.profile.getPasses()};
+    return statistics_row.str();
+}
+
+/**
+ * Collects statistics rows of concurrently simplified circuits and writes
+ * them to the stats file in order of circuits, not in order of completion.
+ * Rows are flushed as soon as all preceding circuits are done, so the file
+ * is still filled progressively during a long run.
+ */
+class StatisticsWriter
+{
+  private:
+    std::optional<std::ofstream>& statistics_stream_;
+    std::vector<std::optional<std::string>> rows_;
+    std::size_t next_row_ = 0;
+    std::mutex mutex_;
+
+  public:
+    StatisticsWriter(std::optional<std::ofstream>& statistics_stream, std::size_t rows_number)
+        : statistics_stream_(statistics_stream)
+        , rows_(rows_number)
+    {
+    }
+
+    void submit(std::size_t row_idx, std::string&& row)
     {
-        dumpStatistics(statistics_stream.value(), basis, instance_path, gatesBefore, gatesAfter, simplifyTime);
+        std::lock_guard<std::mutex> const lock(mutex_);
+        rows_.at(row_idx) = std::move(row);
+        for (; next_row_ < rows_.size() && rows_[next_row_].has_value(); ++next_row_)
+        {
+            if (statistics_stream_.has_value())
+            {
+                *statistics_stream_ << *rows_[next_row_] << std::flush;
+            }
+            rows_[next_row_].reset();
+        }
+    }
+};
+
+/**
+ * Simplifies all `instance_paths` using a pool of `jobs` worker threads. Workers
+ * share read-only circuits databases, while each circuit is parsed, simplified
+ * and written by a single worker independently of others. Pass profile of each
+ * circuit is written to the item of `profiles` with the same index. If `--threads`
+ * is greater than one, all workers share a pool of that many threads, which passes
+ * use to process their circuits in parallel.
+ */
+void simplifyAll(
+    std::vector<std::string> const& instance_paths,
+    argparse::ArgumentParser const& program,
+    std::size_t jobs,
+    std::optional<std::ofstream>& statistics_stream,
+    std::vector<csat::simplification::CircuitProfile>& profiles)
+{
+    StatisticsWriter statistics_writer(statistics_stream, instance_paths.size());
+    std::atomic<std::size_t> next_instance{0};
+    std::size_t const threads = program.get<std::size_t>("--threads");
+    std::unique_ptr<csat::utils::ThreadPool> const pool =
+        threads > 1 ? std::make_unique<csat::utils::ThreadPool>(threads) : nullptr;
+    auto const simplify = useCsrCircuit(program) ? simplifier<csat::CsrDAG> : simplifier<csat::DAG>;
+
+    auto worker = [&]()
+    {
+        csat::Logger logger("Simplifier");
+        for (std::size_t idx = next_instance++; idx < instance_paths.size(); idx = next_instance++)
+        {
+            logger.info("Processing benchmark ", instance_paths[idx], ".");
+            statistics_writer.submit(
+                idx, simplify(instance_paths[idx], idx, program, logger, profiles[idx], pool.get()));
+        }
+    };
+
+    jobs = std::max<std::size_t>(1, std::min(jobs, instance_paths.size()));
+    if (jobs == 1)
+    {
+        worker();
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(jobs);
+    for (std::size_t job = 0; job < jobs; ++job)
+    {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers)
+    {
+        thread.join();
     }
 }
 
+/**
+ * Writes pass profiles of all circuits to the `--pass-profile` file as JSON or CSV
+ * (chosen by file extension), and to the `--pass-trace` file as Chrome trace events.
+ * Peak RSS is measured for the whole process, so it is written only if circuits were
+ * simplified one by one.
+ */
+void writePassProfiles(
+    argparse::ArgumentParser const& program,
+    std::vector<csat::simplification::CircuitProfile> const& profiles,
+    bool with_peak_rss,
+    csat::Logger const& logger)
+{
+    auto const profile_path = program.present("--pass-profile");
+    auto const trace_path   = program.present("--pass-trace");
+    if (!profile_path && !trace_path)
+    {
+        return;
+    }
+#ifndef ENABLE_PASS_PROFILING
+    logger.warning("Simplifier is built without ENABLE_PASS_PROFILING, so no passes are recorded.");
+#endif
+    if (profile_path)
+    {
+        std::ofstream profile_stream(*profile_path);
+        if (std::filesystem::path(*profile_path).extension() == ".csv")
+        {
+            csat::simplification::writePassProfileCsv(profile_stream, profiles, with_peak_rss);
+        }
+        else
+        {
+            csat::simplification::writePassProfileJson(profile_stream, profiles, with_peak_rss);
+        }
+        logger.debug("Pass profile is written to ", *profile_path, ".");
+    }
+    if (trace_path)
+    {
+        std::ofstream trace_stream(*trace_path);
+        csat::simplification::writeChromeTrace(trace_stream, profiles, with_peak_rss);
+        logger.debug("Pass trace is written to ", *trace_path, ".");
+    }
+}
+
+/**
+ * Picks a database file of given basis. Binary image `database_<basis>.bin`, produced by
+ * `db_compiler`, is preferred, since it is loaded without parsing. Text database is used
+ * if there is no image, if it was compiled by an incompatible version, or if the text
+ * database was modified after the image was compiled.
+ */
+std::filesystem::path findDatabase(
+    std::filesystem::path const& databases_path,
+    std::string const& name,
+    csat::Basis basis,
+    csat::Logger const& logger)
+{
+    std::filesystem::path const image_path = databases_path / (name + ".bin");
+    std::filesystem::path const text_path  = databases_path / (name + ".txt");
+    if (!std::filesystem::exists(image_path))
+    {
+        return text_path;
+    }
+    if (!csat::simplification::CircuitDB::isCompatibleImage(image_path, basis))
+    {
+        logger.warning("Database image ", image_path.string(), " is incompatible, falling back to the text database.");
+        return text_path;
+    }
+    if (std::filesystem::exists(text_path) &&
+        std::filesystem::last_write_time(text_path) > std::filesystem::last_write_time(image_path))
+    {
+        logger.warning(
+            "Database image ",
+            image_path.string(),
+            " is older than ",
+            text_path.string(),
+            ", falling back to the text database. Rerun `db_compiler` to update the image.");
+        return text_path;
+    }
+    return image_path;
+}
+
 /**
  * Loads (nearly) optimal circuits database to memory and saves it into a singleton object.
  */
@@ -285,13 +512,13 @@ void loadDatabases(argparse::ArgumentParser const& program, csat::Logger const&
     auto timeStart = std::chrono::steady_clock::now();
     if (basis == BENCH_BASIS)
     {
-        database_abs_path = databases_path / std::filesystem::path("database_bench.txt");
+        database_abs_path = findDatabase(databases_path, "database_bench", csat::Basis::BENCH, logger);
         csat::simplification::DBSingleton::getInstance().bench_db =
             std::make_shared<csat::simplification::CircuitDB>(database_abs_path, csat::Basis::BENCH);
     }
     else if (basis == AIG_BASIS)
     {
-        database_abs_path = databases_path / std::filesystem::path("database_aig.txt");
+        database_abs_path = findDatabase(databases_path, "database_aig", csat::Basis::AIG, logger);
         csat::simplification::DBSingleton::getInstance().aig_db =
             std::make_shared<csat::simplification::CircuitDB>(database_abs_path, csat::Basis::AIG);
     }
@@ -327,9 +554,35 @@ int main(int argn, char** argv)
     program.add_argument("-o", "--output").help("path to resulting directory or to a resulting single .BENCH file");
     program.add_argument("-s", "--statistics").metavar("FILE").help("path to file for statistics writing");
     program.add_argument("-b", "--basis").default_value(std::string(DEFAULT_BASIS)).help("Choose basis [AIG|BENCH]");
+    program.add_argument("--circuit")
+        .default_value(std::string(DEFAULT_CIRCUIT))
+        .help("Choose circuit representation [DAG|CSR]");
     program.add_argument("-d", "--databases")
         .default_value(std::string(DEFAULT_DATABASES_PATH))
         .help("Path to a directory with databases.");
+    program.add_argument("-j", "--jobs")
+        .default_value(std::size_t{1})
+        .scan<'u', std::size_t>()
+        .help("Number of circuits to be simplified concurrently.");
+    program.add_argument("--parse-threads")
+        .default_value(std::size_t{1})
+        .scan<'u', std::size_t>()
+        .help("Number of threads used to parse each circuit file.");
+    program.add_argument("--threads")
+        .default_value(std::size_t{1})
+        .scan<'u', std::size_t>()
+        .help("Number of threads used by parallel passes to process each circuit.");
+    program.add_argument("--incremental")
+        .default_value(false)
+        .implicit_value(true)
+        .help("Apply local rewrites until a fixpoint, revisiting only changed gates.");
+    program.add_argument("--pass-profile")
+        .metavar("FILE")
+        .help("path to file for per-pass profile, written as CSV if it ends with `.csv`, or as JSON");
+    program.add_argument("--pass-trace").metavar("FILE").help("path to file for per-pass Chrome trace events");
+    program.add_argument("--script")
+        .metavar("SCRIPT")
+        .help("Simplification pipeline, e.g. \"" + DEFAULT_SCRIPT + "\" (default).");
 
     program.add_description(
         "The Simplifier tool provides simplification of boolean circuits provided in\n"
@@ -344,6 +597,10 @@ int main(int argn, char** argv)
         "parameter. It will serve as a hint for the tool, which will help it to choose\n"
         "suitable algorithm.\n"
         "\n"
+        "Circuits are represented by `DAG` by default, which keeps operands and users of\n"
+        "each gate in separate containers. For large circuits `--circuit CSR` stores them\n"
+        "in two flat arrays instead, which needs a constant number of allocations.\n"
+        "\n"
         "One also should provide a path to the directory with databases containing\n"
         "(nearly) optimal circuits with three inputs and three outputs by providing\n"
         "a `--databases` parameter. Note that databases are available at `databases/`\n"
@@ -353,6 +610,36 @@ int main(int argn, char** argv)
         "a `--statistics` parameter, which is a path to location where a `*.csv` file\n"
         "with gathered statistics is to be stored. Note that resulting csv file will use\n"
         "a `,` character as a delimiter, whilst `;` character may be a valid item value.\n"
+        "E.g. statistics of subcircuits minimization are written as `[a;b;...]` lists\n"
+        "of values of all its iterations, however many of them the script performs.\n"
+        "\n"
+        "When input is a directory, several circuits may be simplified concurrently by\n"
+        "providing a `--jobs` parameter. Rows of statistics file are always written in\n"
+        "the order of sorted input paths, regardless of the number of jobs.\n"
+        "Large circuit files may additionally be parsed on several threads by providing\n"
+        "a `--parse-threads` parameter, which doesn't affect the result of parsing.\n"
+        "Passes, which process levels of a circuit in parallel, use `--threads` threads;\n"
+        "their results don't depend on the number of threads either.\n"
+        "\n"
+        "Instead of a fixed number of simplification passes over the whole circuit, local\n"
+        "rewrites may be applied until a fixpoint by providing an `--incremental` flag.\n"
+        "Then only gates, whose operands were changed, are revisited after the first pass.\n"
+        "\n"
+        "Order of simplification passes may be tuned without rebuilding by a `--script`\n"
+        "parameter. Script is a `;` separated list of passes [redundant, dup_gates,\n"
+        "dup_ops, const, reduce_not, sweep, incremental, 3in_min] and loops, e.g.\n"
+        "\n"
+        "    dup_ops; repeat(until_fixpoint, max=20, time=60){dup_ops; 3in_min}; dup_ops\n"
+        "\n"
+        "Loop repeats its body a given number of times, or `until_fixpoint`, when number\n"
+        "of gates stops decreasing. Budgets `max=N` (iterations), `time=S` (seconds) and\n"
+        "`gates=N` (circuit size) forbid to start a new iteration once they are exceeded.\n"
+        "\n"
+        "Simplifier built with `ENABLE_PASS_PROFILING` CMake option records wall time,\n"
+        "peak RSS delta and number of gates before and after each pass. Measurements\n"
+        "are written by `--pass-profile` (JSON or CSV) and `--pass-trace` (Chrome trace\n"
+        "events, viewable by `chrome://tracing` or Perfetto) parameters. Peak RSS is\n"
+        "shared by the whole process, so it is omitted if `--jobs` is greater than 1.\n"
         "\n"
         "Example usage command:\n"
         "\n"
@@ -374,13 +661,17 @@ int main(int argn, char** argv)
     // Open file where statistics will be dumped.
     auto statistics_stream = openFileStat(program);
 
+    // Validate the circuit representation and the script before any circuit is read.
+    useCsrCircuit(program);
+    buildPipeline<csat::DAG>(program);
+
     // Read small circuit databases apriori to allow simplification use them.
     loadDatabases(program, logger);
 
     // Iterate over input directory of circuits.
     // Program will perform simplification of each found circuit.
     std::string input_dir  = program.get<std::string>("--input-path");
-    std::string output_dir = program.get<std::string>("--output");
+    std::vector<std::string> instance_paths;
     if (std::filesystem::is_directory(input_dir))
     {
         for (auto& instance_path : std::filesystem::directory_iterator(input_dir))
@@ -390,17 +681,32 @@ int main(int argn, char** argv)
             {
                 continue;
             }
+            instance_paths.push_back(instance_path.path().string());
+        }
+        // Directory iteration order is unspecified, sorting keeps statistics deterministic.
+        std::sort(instance_paths.begin(), instance_paths.end());
 
-            std::string path = instance_path.path().string();
-            logger.info("Processing benchmark ", path, ".");
-            simplifier(path, program, logger, statistics_stream);
+        // Create output directory if it doesn't exist yet.
+        if (auto output_dir = program.present("-o"); output_dir && !std::filesystem::exists(*output_dir))
+        {
+            std::filesystem::create_directories(*output_dir);
         }
     }
     else
     {
-        logger.info("Processing benchmark ", input_dir, ".");
-        simplifier(input_dir, program, logger, statistics_stream);
+        instance_paths.push_back(input_dir);
     }
 
+    std::vector<csat::simplification::CircuitProfile> profiles(instance_paths.size());
+    std::size_t const jobs = program.get<std::size_t>("--jobs");
+    simplifyAll(instance_paths, program, jobs, statistics_stream, profiles);
+    writePassProfiles(program, profiles, jobs <= 1 || instance_paths.size() <= 1, logger);
+
+#ifdef ENABLE_PROFILING
+    std::ostringstream profiling_report;
+    csat::profiling::Profiler::getInstance().report(profiling_report);
+    logger.info("Hot path profile:\n", profiling_report.str());
+#endif
+
     return 0;
 }
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/dag.hpp"
+
+/**
+ * Common helpers of performance benchmarks.
+ */
+namespace csat::bench
+{
+
+/**
+ * Runs `function` `repetitions` times and returns the best wall time in seconds.
+ * The best time is the least noisy estimate for short deterministic workloads.
+ */
+template<class Function>
+double measureBestTime(std::size_t repetitions, Function&& function)
+{
+    double best_time = 0;
+    for (std::size_t repetition = 0; repetition < std::max<std::size_t>(1, repetitions); ++repetition)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        function();
+        double const time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best_time         = (repetition == 0) ? time : std::min(best_time, time);
+    }
+    return best_time;
+}
+
+/**
+ * @param path -- directory with circuits, or a single circuit file.
+ * @return sorted paths of regular files, located at `path`.
+ */
+inline std::vector<std::string> listCircuitFiles(std::string const& path)
+{
+    std::vector<std::string> paths;
+    if (!std::filesystem::is_directory(path))
+    {
+        paths.push_back(path);
+        return paths;
+    }
+    for (auto const& entry : std::filesystem::directory_iterator(path))
+    {
+        if (entry.is_regular_file())
+        {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+/**
+ * @return throughput in megabytes per second.
+ */
+inline double megabytesPerSecond(std::size_t bytes, double seconds)
+{
+    return seconds > 0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+/**
+ * Builds a random circuit of `inputs` inputs and `gates` binary and unary gates, whose
+ * operands are biased towards recent gates, so the circuit is deep. The last `outputs`
+ * gates are outputs, so their cones overlap heavily.
+ */
+inline DAG buildRandomCircuit(std::size_t inputs, std::size_t gates, std::size_t outputs, uint64_t seed)
+{
+    static constexpr GateType types[]{
+        GateType::AND,
+        GateType::NAND,
+        GateType::OR,
+        GateType::NOR,
+        GateType::XOR,
+        GateType::NXOR,
+        GateType::NOT};
+
+    std::mt19937_64 generator(seed);
+    GateInfoContainer gate_info;
+    gate_info.reserve(inputs + gates);
+    for (std::size_t input = 0; input < inputs; ++input)
+    {
+        gate_info.emplace_back(GateType::INPUT, GateIdContainer{});
+    }
+
+    auto const pick_operand = [&generator](std::size_t size)
+    {
+        // Half of operands are among 1024 latest gates.
+        std::size_t const window = std::min<std::size_t>(size, 1024);
+        return (generator() & 1U) != 0U ? size - 1 - generator() % window : generator() % size;
+    };
+    for (std::size_t gate = 0; gate < gates; ++gate)
+    {
+        GateType const type    = types[generator() % std::size(types)];
+        std::size_t const size = gate_info.size();
+        if (type == GateType::NOT)
+        {
+            gate_info.emplace_back(type, GateIdContainer{pick_operand(size)});
+        }
+        else
+        {
+            gate_info.emplace_back(type, GateIdContainer{pick_operand(size), pick_operand(size)});
+        }
+    }
+
+    GateIdContainer output_gates;
+    for (std::size_t output = 0; output < std::min(outputs, gates); ++output)
+    {
+        output_gates.push_back(inputs + gates - 1 - output);
+    }
+    return {std::move(gate_info), std::move(output_gates)};
+}
+
+}  // namespace csat::bench
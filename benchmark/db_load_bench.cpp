@@ -0,0 +1,105 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "benchmark/bench_utils.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/simplification/utils/circuits_db.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+#ifndef BENCHMARK_DATABASES_DIR
+#define BENCHMARK_DATABASES_DIR "databases/"
+#endif
+
+using csat::simplification::CircuitDB;
+
+/**
+ * @return content of file at given path.
+ */
+std::string readFile(std::filesystem::path const& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+/**
+ * Compares startup time of loading the small-circuit databases from text files
+ * and from memory-mapped binary images, compiled from them.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("db_load_bench");
+    program.add_argument("-d", "--databases")
+        .default_value(std::string(BENCHMARK_DATABASES_DIR))
+        .help("path to directory with text databases");
+    program.add_argument("-r", "--repetitions")
+        .default_value(std::size_t{5})
+        .scan<'u', std::size_t>()
+        .help("number of loads of each database, the best time is reported");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    std::filesystem::path const databases_path = program.get<std::string>("--databases");
+    auto const repetitions                     = program.get<std::size_t>("--repetitions");
+    std::filesystem::path const images_path    = std::filesystem::temp_directory_path() / "csat_db_load_bench";
+    std::filesystem::create_directories(images_path);
+
+    std::cout << std::left << std::setw(20) << "database" << std::right << std::setw(12) << "circuits"
+              << std::setw(14) << "text sec" << std::setw(14) << "image sec" << std::setw(12) << "speedup"
+              << "\n";
+
+    bool all_identical = true;
+    bool loaded_any    = false;
+    for (auto const& [file_name, basis] :
+         {std::pair{"database_bench", csat::Basis::BENCH}, std::pair{"database_aig", csat::Basis::AIG}})
+    {
+        std::filesystem::path const text_path = databases_path / (std::string(file_name) + ".txt");
+        if (!std::filesystem::exists(text_path))
+        {
+            continue;
+        }
+        std::filesystem::path const image_path = images_path / (std::string(file_name) + ".bin");
+        std::filesystem::path const check_path = images_path / (std::string(file_name) + ".check.bin");
+
+        std::unique_ptr<CircuitDB> text_db;
+        std::unique_ptr<CircuitDB> image_db;
+        double const text_time = csat::bench::measureBestTime(
+            repetitions, [&]() { text_db = std::make_unique<CircuitDB>(text_path, basis); });
+        text_db->writeImage(image_path);
+        double const image_time = csat::bench::measureBestTime(
+            repetitions, [&]() { image_db = std::make_unique<CircuitDB>(image_path, basis); });
+
+        // Image of the mapped database must reproduce the compiled one byte by byte.
+        image_db->writeImage(check_path);
+        bool const identical = image_db->isMapped() && readFile(image_path) == readFile(check_path);
+        all_identical        = all_identical && identical;
+        loaded_any           = true;
+
+        std::cout << std::left << std::setw(20) << file_name << std::right << std::setw(12) << text_db->size()
+                  << std::setw(14) << std::setprecision(6) << text_time << std::setw(14) << image_time
+                  << std::setw(11) << std::setprecision(3) << (image_time > 0 ? text_time / image_time : 0.0) << "x"
+                  << (identical ? "" : "  MISMATCH") << "\n";
+    }
+    std::filesystem::remove_all(images_path);
+
+    if (!loaded_any)
+    {
+        std::cerr << "There are no text databases at " << databases_path.string() << std::endl;
+        return 1;
+    }
+    return all_identical ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stack>
+#include <string>
+
+#include "benchmark/bench_utils.hpp"
+#include "src/algo.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/csr_dag.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/structures/circuit/gate_info.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+using OperationDFSGate = std::function<void(csat::GateId, csat::algo::DFSStateVector const&)>;
+
+/**
+ * Reference search, which was used before the callable templates one: hooks and the
+ * getter of next gates are type erased by `std::function`, and each gate is pushed to
+ * the stack once per arc, which leads to it.
+ */
+csat::algo::DFSStateVector performReferenceSearch(
+    csat::ICircuit const& circuit,
+    csat::GateIdContainer const& startGates,
+    OperationDFSGate const& previsitOperation,
+    OperationDFSGate const& postvisitOperation)
+{
+    using csat::algo::DFSState;
+    csat::algo::DFSStateVector dfs_state(circuit.getNumberOfGates(), DFSState::UNVISITED);
+    std::function<csat::GateIdSpan(csat::GateId)> next_getter = [&circuit](csat::GateId gateId)
+    { return circuit.getGateOperands(gateId); };
+
+    std::stack<csat::GateId> queue_{};
+    auto enqueue_next = [&dfs_state, &queue_](csat::GateId nextGateId) -> void
+    {
+        if (dfs_state[nextGateId] == DFSState::UNVISITED)
+        {
+            queue_.push(nextGateId);
+        }
+    };
+
+    for (auto start : startGates)
+    {
+        enqueue_next(start);
+        while (!queue_.empty())
+        {
+            csat::GateId const gateId = queue_.top();
+            if (dfs_state[gateId] == DFSState::UNVISITED)
+            {
+                previsitOperation(gateId, dfs_state);
+                dfs_state[gateId] = DFSState::ENTERED;
+
+                csat::GateIdSpan const nextContainer = next_getter(gateId);
+                std::for_each(nextContainer.rbegin(), nextContainer.rend(), enqueue_next);
+            }
+            else if (dfs_state[gateId] == DFSState::ENTERED)
+            {
+                dfs_state[gateId] = DFSState::VISITED;
+                postvisitOperation(gateId, dfs_state);
+                queue_.pop();
+            }
+            else
+            {
+                queue_.pop();
+            }
+        }
+    }
+    return dfs_state;
+}
+
+/**
+ * Compares the depth first search, parameterized by callables, with the former one, which
+ * was parameterized by `std::function`s, and reports the cost of a single arc of each
+ * search, as well as of the breadth first search and of the topological sort. Search over
+ * `CsrDAG` shows the cost of an arc, when operands are stored in a single flat array.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("dfs_bench");
+    program.add_argument("-g", "--gates")
+        .default_value(std::size_t{1'000'000})
+        .scan<'u', std::size_t>()
+        .help("number of gates of the random circuit");
+    program.add_argument("-n", "--inputs")
+        .default_value(std::size_t{1'000})
+        .scan<'u', std::size_t>()
+        .help("number of inputs of the random circuit");
+    program.add_argument("-o", "--outputs")
+        .default_value(std::size_t{64})
+        .scan<'u', std::size_t>()
+        .help("number of outputs of the random circuit");
+    program.add_argument("-r", "--repetitions")
+        .default_value(std::size_t{5})
+        .scan<'u', std::size_t>()
+        .help("number of searches, the best time is reported");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    auto const gates       = program.get<std::size_t>("--gates");
+    auto const inputs      = std::max<std::size_t>(1, program.get<std::size_t>("--inputs"));
+    auto const outputs     = program.get<std::size_t>("--outputs");
+    auto const repetitions = program.get<std::size_t>("--repetitions");
+
+    csat::DAG const circuit = csat::bench::buildRandomCircuit(inputs, gates, outputs, 42);
+    std::size_t arcs        = 0;
+    for (csat::GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        arcs += circuit.getGateOperands(gateId).size();
+    }
+    // All gates are start points, so every arc is looked at by each search.
+    csat::GateIdContainer all_gates(circuit.getNumberOfGates());
+    std::iota(all_gates.rbegin(), all_gates.rend(), csat::GateId{0});
+    // Gates without users, from which all gates are reachable.
+    csat::GateIdContainer sources{};
+    for (csat::GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        if (circuit.getGateUsers(gateId).empty())
+        {
+            sources.push_back(gateId);
+        }
+    }
+
+    std::cout << "circuit: " << circuit.getNumberOfGates() << " gates, " << arcs << " arcs\n";
+    auto const report = [arcs](std::string const& name, double time)
+    {
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(12) << std::setprecision(4) << time
+                  << " sec, " << std::setw(8) << time * 1e9 / static_cast<double>(arcs) << " ns/arc\n";
+    };
+
+    csat::GateIdContainer postorder{};
+    postorder.reserve(circuit.getNumberOfGates());
+    auto const record = [&postorder](csat::GateId gateId, csat::algo::DFSStateVector const&)
+    { postorder.push_back(gateId); };
+
+    double const dfs_time = csat::bench::measureBestTime(
+        repetitions,
+        [&]()
+        {
+            postorder.clear();
+            csat::algo::performDepthFirstSearch(circuit, all_gates, csat::algo::NoOperation{}, record);
+        });
+    report("dfs", dfs_time);
+    csat::GateIdContainer const dfs_postorder = postorder;
+
+    double const reference_time = csat::bench::measureBestTime(
+        repetitions,
+        [&]()
+        {
+            postorder.clear();
+            performReferenceSearch(
+                circuit, all_gates, [](csat::GateId, csat::algo::DFSStateVector const&) {}, record);
+        });
+    report("dfs std::function", reference_time);
+    bool identical = dfs_postorder == postorder;
+
+    // Same circuit, whose operands are stored in a single flat array.
+    csat::GateInfoContainer gate_info{};
+    gate_info.reserve(circuit.getNumberOfGates());
+    for (csat::GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        csat::GateIdSpan const operands = circuit.getGateOperands(gateId);
+        gate_info.emplace_back(circuit.getGateType(gateId), csat::GateIdContainer(operands.begin(), operands.end()));
+    }
+    csat::CsrDAG const csr_circuit(std::move(gate_info), csat::GateIdContainer(circuit.getOutputGates()));
+    double const csr_time = csat::bench::measureBestTime(
+        repetitions,
+        [&]()
+        {
+            postorder.clear();
+            csat::algo::performDepthFirstSearch(csr_circuit, all_gates, csat::algo::NoOperation{}, record);
+        });
+    report("dfs CsrDAG", csr_time);
+    identical = identical && dfs_postorder == postorder;
+
+    std::size_t depth     = 0;
+    double const bfs_time = csat::bench::measureBestTime(
+        repetitions,
+        [&]()
+        {
+            csat::algo::performBreadthFirstSearch(
+                circuit, sources, [&depth](csat::GateId, std::size_t distance) { depth = distance; });
+        });
+    report("bfs", bfs_time);
+
+    double const topsort_time = csat::bench::measureBestTime(
+        repetitions,
+        [&]() { csat::algo::TopSortAlgorithm<csat::algo::DFSTopSort>::computeSorting(circuit); });
+    report("topsort", topsort_time);
+
+    std::cout << "greatest distance from a gate without users: " << depth << "\n";
+    std::cout << "callable templates search is " << std::setprecision(3) << reference_time / dfs_time
+              << "x faster" << (identical ? "" : ", RESULTS DIFFER") << "\n";
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "benchmark/bench_utils.hpp"
+#include "src/algo.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+#include "src/simplification/duplicate_gates_cleaner.hpp"
+#include "src/simplification/redundant_gates_cleaner.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/utility/encoder.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+#ifndef BENCHMARK_CIRCUITS_DIR
+#define BENCHMARK_CIRCUITS_DIR "benchmarks/"
+#endif
+
+using csat::DAG;
+using Encoder = csat::utils::GateEncoder<std::string>;
+
+/**
+ * Reference duplicates cleaning, which was used before hash-consing: each gate is
+ * keyed by a string `operator_operand1_operand2...` of its type and new ids of its
+ * operands, and old ids are mapped to new ones by an ordered map.
+ */
+std::unique_ptr<DAG> cleanDuplicatesByStrings(std::unique_ptr<DAG> circuit, Encoder& encoder)
+{
+    csat::GateIdContainer gate_sorting(csat::algo::TopSortAlgorithm<csat::algo::DFSTopSort>::sorting(*circuit));
+    std::reverse(gate_sorting.begin(), gate_sorting.end());
+
+    Encoder auxiliary_names_encoder{};
+    std::map<csat::GateId, csat::GateId> old_to_new_gateId{};
+    csat::GateIdContainer new_order{};
+    std::vector<std::pair<csat::GateId, csat::GateId>> duplicates{};
+    for (csat::GateId const gateId : gate_sorting)
+    {
+        std::string encoded_name = std::to_string(static_cast<int>(circuit->getGateType(gateId)));
+        if (circuit->getGateType(gateId) == csat::GateType::INPUT)
+        {
+            encoded_name += '_' + std::to_string(gateId);
+        }
+        for (csat::GateId const operand : circuit->getGateOperands(gateId))
+        {
+            encoded_name += '_' + std::to_string(old_to_new_gateId.at(operand));
+        }
+
+        if (auxiliary_names_encoder.keyExists(encoded_name))
+        {
+            duplicates.emplace_back(gateId, new_order.at(auxiliary_names_encoder.encodeGate(encoded_name)));
+        }
+        else
+        {
+            new_order.push_back(gateId);
+        }
+        old_to_new_gateId[gateId] = auxiliary_names_encoder.encodeGate(encoded_name);
+    }
+
+    for (auto const& [duplicate, representative] : duplicates)
+    {
+        circuit->redirectUsers(duplicate, representative);
+        circuit->markDead(duplicate);
+    }
+    encoder.renumber(circuit->compact(new_order));
+    return circuit;
+}
+
+/**
+ * @return "AIG" if circuit consists of AND and NOT gates only, otherwise "BENCH".
+ */
+std::string getBasisName(DAG const& circuit)
+{
+    for (csat::GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        csat::GateType const type = circuit.getGateType(gateId);
+        if (type != csat::GateType::INPUT && type != csat::GateType::AND && type != csat::GateType::NOT)
+        {
+            return "BENCH";
+        }
+    }
+    return "AIG";
+}
+
+/**
+ * Measures the best time of `clean`, applied to fresh copies of the circuit,
+ * so copying is not accounted.
+ * @return the best time and number of gates of the cleaned circuit.
+ */
+template<class Clean>
+std::pair<double, std::size_t> measureCleaning(
+    std::size_t repetitions,
+    DAG const& circuit,
+    Encoder const& encoder,
+    Clean const& clean)
+{
+    double best_time  = 0;
+    std::size_t gates = 0;
+    for (std::size_t repetition = 0; repetition < std::max<std::size_t>(1, repetitions); ++repetition)
+    {
+        auto copy          = std::make_unique<DAG>(circuit);
+        auto encoder_copy  = std::make_unique<Encoder>(encoder);
+        auto const start   = std::chrono::steady_clock::now();
+        auto const cleaned = clean(std::move(copy), std::move(encoder_copy));
+        double const time  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best_time          = (repetition == 0) ? time : std::min(best_time, time);
+        gates              = cleaned->getNumberOfGates();
+    }
+    return {best_time, gates};
+}
+
+/**
+ * Cleans circuit from redundant gates, compares both duplicates cleanings on it and prints a row of results.
+ * @return false if hash-consing has left more gates than the reference.
+ */
+bool compareCleanings(std::string const& name, DAG const& parsed, Encoder const& names, std::size_t repetitions)
+{
+    csat::simplification::SimplificationContext context;
+    auto [circuit, encoder] = csat::simplification::RedundantGatesCleaner_<DAG>().transform(
+        std::make_unique<DAG>(parsed), std::make_unique<Encoder>(names), context);
+
+    auto const [strings_time, strings_gates] = measureCleaning(
+        repetitions,
+        *circuit,
+        *encoder,
+        [](std::unique_ptr<DAG> copy, std::unique_ptr<Encoder> encoder_copy)
+        { return cleanDuplicatesByStrings(std::move(copy), *encoder_copy); });
+    auto const [hashing_time, hashing_gates] = measureCleaning(
+        repetitions,
+        *circuit,
+        *encoder,
+        [](std::unique_ptr<DAG> copy, std::unique_ptr<Encoder> encoder_copy)
+        {
+            csat::simplification::SimplificationContext cleaner_context;
+            return csat::simplification::DuplicateGatesCleaner_<DAG>()
+                .transform(std::move(copy), std::move(encoder_copy), cleaner_context)
+                .first;
+        });
+
+    // Hash-consing sorts operands of symmetric gates, so it may find more duplicates, but never less.
+    bool const consistent = hashing_gates <= strings_gates;
+    std::cout << std::left << std::setw(70) << name << std::setw(7) << getBasisName(*circuit) << std::right
+              << std::setw(10) << circuit->getNumberOfGates() << std::setw(12) << std::setprecision(4) << strings_time
+              << std::setw(12) << hashing_time << std::setw(9) << std::setprecision(3)
+              << (hashing_time > 0 ? strings_time / hashing_time : 0.0) << "x" << std::setw(10)
+              << circuit->getNumberOfGates() - hashing_gates << (consistent ? "" : "  MORE GATES THAN REFERENCE")
+              << "\n";
+    return consistent;
+}
+
+/**
+ * Compares duplicates cleaning by hash-consing with the string keyed reference
+ * on circuits, which are cleaned from redundant gates beforehand.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("duplicate_gates_bench");
+    program.add_argument("-i", "--input-path")
+        .default_value(std::string(BENCHMARK_CIRCUITS_DIR))
+        .help("directory with .BENCH files (or a single .BENCH file)");
+    program.add_argument("-r", "--repetitions")
+        .default_value(std::size_t{3})
+        .scan<'u', std::size_t>()
+        .help("number of runs of each cleaner, the best time is reported");
+    program.add_argument("-g", "--random-gates")
+        .default_value(std::size_t{500'000})
+        .scan<'u', std::size_t>()
+        .help("number of gates of an additional random circuit in BENCH basis, 0 to skip it");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    auto const repetitions = program.get<std::size_t>("--repetitions");
+
+    std::cout << std::left << std::setw(70) << "file" << std::setw(7) << "basis" << std::right << std::setw(10)
+              << "gates" << std::setw(12) << "strings" << std::setw(12) << "hashing" << std::setw(10) << "speedup"
+              << std::setw(10) << "removed" << "\n";
+
+    bool all_consistent = true;
+    for (std::string const& path : csat::bench::listCircuitFiles(program.get<std::string>("--input-path")))
+    {
+        std::ifstream file(path);
+        csat::parser::BenchToCircuit<DAG> parser;
+        parser.parseStream(file);
+        all_consistent = compareCleanings(
+                             std::filesystem::path(path).filename().string(),
+                             *parser.instantiate(),
+                             parser.getEncoder(),
+                             repetitions) &&
+                         all_consistent;
+    }
+
+    if (auto const random_gates = program.get<std::size_t>("--random-gates"); random_gates > 0)
+    {
+        // Redundant gates cleaning keeps only cones of the last 1000 gates, which are outputs.
+        DAG const circuit = csat::bench::buildRandomCircuit(1'000, random_gates, 1'000, 42);
+        Encoder names;
+        for (csat::GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+        {
+            names.encodeGate(std::to_string(gateId));
+        }
+        all_consistent =
+            compareCleanings("random_" + std::to_string(random_gates), circuit, names, repetitions) && all_consistent;
+    }
+    return all_consistent ? 0 : 1;
+}
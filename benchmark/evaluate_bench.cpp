@@ -0,0 +1,154 @@
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stack>
+#include <string>
+
+#include "benchmark/bench_utils.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/common/operators.hpp"
+#include "src/structures/assignment/vector_assignment.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/utility/thread_pool.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+/**
+ * Reference evaluation, which was used before the single sweep one: each output is
+ * evaluated by a separate depth first search with its own visited marks.
+ */
+csat::VectorAssignment<false> evaluatePerOutput(csat::DAG const& circuit, csat::IAssignment const& input_asmt)
+{
+    csat::VectorAssignment<false> internal_asmt;
+    internal_asmt.ensureCapacity(circuit.getNumberOfGates());
+    auto get_gate_state = [&input_asmt, &internal_asmt](csat::GateId operand)
+    {
+        return internal_asmt.isUndefined(operand) ? input_asmt.getGateState(operand)
+                                                  : internal_asmt.getGateState(operand);
+    };
+
+    for (csat::GateId const sink : circuit.getOutputGates())
+    {
+        std::stack<csat::GateId> stack;
+        stack.push(sink);
+        csat::BoolVector evaluated(circuit.getNumberOfGates(), 0);
+        while (!stack.empty())
+        {
+            csat::GateId const gateId = stack.top();
+            if (circuit.getGateType(gateId) == csat::GateType::INPUT || !input_asmt.isUndefined(gateId))
+            {
+                internal_asmt.assign(gateId, input_asmt.getGateState(gateId));
+                evaluated[gateId] = 1;
+                stack.pop();
+                continue;
+            }
+            bool operands_evaluated = true;
+            for (csat::GateId const operand : circuit.getGateOperands(gateId))
+            {
+                if (evaluated[operand] == 0)
+                {
+                    operands_evaluated = false;
+                    stack.push(operand);
+                }
+            }
+            if (operands_evaluated)
+            {
+                auto const oper = csat::op::getOperatorNT<csat::GateId>(circuit.getGateType(gateId));
+                internal_asmt.assign(gateId, oper(circuit.getGateOperands(gateId), get_gate_state));
+                evaluated[gateId] = 1;
+                stack.pop();
+            }
+        }
+    }
+    return internal_asmt;
+}
+
+/**
+ * Compares single sweep evaluation of a large random circuit with per-output evaluation.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("evaluate_bench");
+    program.add_argument("-g", "--gates")
+        .default_value(std::size_t{1'000'000})
+        .scan<'u', std::size_t>()
+        .help("number of gates of the random circuit");
+    program.add_argument("-n", "--inputs")
+        .default_value(std::size_t{1'000})
+        .scan<'u', std::size_t>()
+        .help("number of inputs of the random circuit");
+    program.add_argument("-o", "--outputs")
+        .default_value(std::size_t{64})
+        .scan<'u', std::size_t>()
+        .help("number of outputs of the random circuit");
+    program.add_argument("-r", "--repetitions")
+        .default_value(std::size_t{3})
+        .scan<'u', std::size_t>()
+        .help("number of evaluations, the best time is reported");
+    program.add_argument("-t", "--threads")
+        .default_value(std::size_t{1})
+        .scan<'u', std::size_t>()
+        .help("number of threads, which evaluate gates of each level in parallel");
+    program.add_argument("--skip-reference")
+        .default_value(false)
+        .implicit_value(true)
+        .help("do not run per-output reference evaluation, which is slow on wide circuits");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    auto const gates       = program.get<std::size_t>("--gates");
+    auto const inputs      = std::max<std::size_t>(1, program.get<std::size_t>("--inputs"));
+    auto const outputs     = program.get<std::size_t>("--outputs");
+    auto const repetitions = program.get<std::size_t>("--repetitions");
+    auto const threads     = program.get<std::size_t>("--threads");
+
+    csat::DAG const circuit = csat::bench::buildRandomCircuit(inputs, gates, outputs, 42);
+    csat::VectorAssignment<false> input_asmt;
+    input_asmt.ensureCapacity(circuit.getNumberOfGates());
+    std::mt19937_64 generator(7);
+    for (csat::GateId input = 0; input < inputs; ++input)
+    {
+        input_asmt.assign(input, (generator() & 1U) != 0U ? csat::GateState::TRUE : csat::GateState::FALSE);
+    }
+
+    std::unique_ptr<csat::utils::ThreadPool> const pool =
+        threads > 1 ? std::make_unique<csat::utils::ThreadPool>(threads) : nullptr;
+    std::unique_ptr<csat::VectorAssignment<false>> result;
+    double const sweep_time = csat::bench::measureBestTime(
+        repetitions,
+        [&]() { result = circuit.evaluateCircuit<csat::VectorAssignment<false>>(input_asmt, pool.get()); });
+
+    std::cout << "circuit: " << circuit.getNumberOfGates() << " gates, " << circuit.getOutputGates().size()
+              << " outputs\n";
+    std::cout << std::left << std::setw(24) << (threads > 1 ? "levels sweep" : "single sweep") << std::right
+              << std::setw(12) << std::setprecision(4) << sweep_time << " sec, " << std::setw(8)
+              << sweep_time * 1e9 / static_cast<double>(circuit.getNumberOfGates()) << " ns/gate\n";
+
+    if (program.get<bool>("--skip-reference"))
+    {
+        return 0;
+    }
+
+    csat::VectorAssignment<false> reference;
+    double const reference_time =
+        csat::bench::measureBestTime(repetitions, [&]() { reference = evaluatePerOutput(circuit, input_asmt); });
+    bool identical = true;
+    for (csat::GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        identical = identical && reference.getGateState(gateId) == result->getGateState(gateId);
+    }
+    std::cout << std::left << std::setw(24) << "per-output reference" << std::right << std::setw(12)
+              << reference_time << " sec, " << std::setw(8) << std::setprecision(3) << reference_time / sweep_time
+              << "x slower" << (identical ? "" : ", RESULTS DIFFER") << "\n";
+    return identical ? 0 : 1;
+}
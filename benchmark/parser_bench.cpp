@@ -0,0 +1,142 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "benchmark/bench_utils.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+#ifndef BENCHMARK_CIRCUITS_DIR
+#define BENCHMARK_CIRCUITS_DIR "benchmarks/"
+#endif
+
+using Parser = csat::parser::BenchToCircuit<csat::DAG>;
+
+/**
+ * Checks that two parsers have produced exactly the same circuit and gate ids.
+ */
+bool sameParsingResult(Parser& lhs, Parser& rhs)
+{
+    auto lhs_circuit = lhs.instantiate();
+    auto rhs_circuit = rhs.instantiate();
+    if (lhs_circuit->getNumberOfGates() != rhs_circuit->getNumberOfGates() ||
+        lhs_circuit->getOutputGates() != rhs_circuit->getOutputGates())
+    {
+        return false;
+    }
+    for (csat::GateId gateId = 0; gateId < lhs_circuit->getNumberOfGates(); ++gateId)
+    {
+        if (lhs_circuit->getGateType(gateId) != rhs_circuit->getGateType(gateId) ||
+            lhs_circuit->getGateOperands(gateId) != rhs_circuit->getGateOperands(gateId) ||
+            lhs.getEncoder().decodeGateView(gateId) != rhs.getEncoder().decodeGateView(gateId))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Compares throughput of line-by-line stream parsing, memory-mapped parsing and
+ * multithreaded memory-mapped parsing of .bench files.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("parser_bench");
+    program.add_argument("-i", "--input-path")
+        .default_value(std::string(BENCHMARK_CIRCUITS_DIR))
+        .help("directory with .BENCH files (or a single .BENCH file)");
+    program.add_argument("-t", "--threads")
+        .default_value(std::size_t{std::max(2U, std::thread::hardware_concurrency())})
+        .scan<'u', std::size_t>()
+        .help("number of threads of parallel parsing");
+    program.add_argument("-r", "--repetitions")
+        .default_value(std::size_t{3})
+        .scan<'u', std::size_t>()
+        .help("number of runs of each parser, the best time is reported");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    auto const threads_number = program.get<std::size_t>("--threads");
+    auto const repetitions    = program.get<std::size_t>("--repetitions");
+
+    std::cout << std::left << std::setw(70) << "file" << std::right << std::setw(10) << "MB" << std::setw(14)
+              << "stream MB/s" << std::setw(14) << "mmap MB/s" << std::setw(12) << threads_number << "T MB/s"
+              << "\n";
+
+    std::size_t total_bytes = 0;
+    double total_stream     = 0;
+    double total_mmap       = 0;
+    double total_parallel   = 0;
+    for (std::string const& path : csat::bench::listCircuitFiles(program.get<std::string>("--input-path")))
+    {
+        std::size_t const bytes = std::filesystem::file_size(path);
+
+        Parser stream_parser;
+        double const stream_time = csat::bench::measureBestTime(
+            repetitions,
+            [&]()
+            {
+                stream_parser.clear();
+                std::ifstream file(path);
+                stream_parser.parseStream(file);
+            });
+
+        Parser mmap_parser;
+        double const mmap_time = csat::bench::measureBestTime(
+            repetitions,
+            [&]()
+            {
+                mmap_parser.clear();
+                mmap_parser.parseFile(path);
+            });
+
+        Parser parallel_parser;
+        double const parallel_time = csat::bench::measureBestTime(
+            repetitions,
+            [&]()
+            {
+                parallel_parser.clear();
+                parallel_parser.parseFile(path, threads_number);
+            });
+
+        if (!sameParsingResult(stream_parser, mmap_parser) || !sameParsingResult(stream_parser, parallel_parser))
+        {
+            std::cerr << "Parsers disagree on file " << path << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        total_bytes += bytes;
+        total_stream += stream_time;
+        total_mmap += mmap_time;
+        total_parallel += parallel_time;
+
+        std::cout << std::left << std::setw(70) << std::filesystem::path(path).filename().string() << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(10)
+                  << static_cast<double>(bytes) / (1024.0 * 1024.0) << std::setw(14)
+                  << csat::bench::megabytesPerSecond(bytes, stream_time) << std::setw(14)
+                  << csat::bench::megabytesPerSecond(bytes, mmap_time) << std::setw(18)
+                  << csat::bench::megabytesPerSecond(bytes, parallel_time) << "\n";
+    }
+
+    std::cout << std::left << std::setw(70) << "total" << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << static_cast<double>(total_bytes) / (1024.0 * 1024.0) << std::setw(14)
+              << csat::bench::megabytesPerSecond(total_bytes, total_stream) << std::setw(14)
+              << csat::bench::megabytesPerSecond(total_bytes, total_mmap) << std::setw(18)
+              << csat::bench::megabytesPerSecond(total_bytes, total_parallel) << std::endl;
+    return EXIT_SUCCESS;
+}
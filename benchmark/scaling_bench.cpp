@@ -0,0 +1,202 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/generation/circuit_generator.hpp"
+#include "src/simplification/pass_profile.hpp"
+#include "src/simplification/script.hpp"
+#include "src/simplification/transformer_registry.hpp"
+#include "src/simplification/utils/circuits_db.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+#ifndef BENCHMARK_DATABASES_DIR
+#define BENCHMARK_DATABASES_DIR "databases/"
+#endif
+
+#ifndef ENABLE_PASS_PROFILING
+#error "scaling_bench reports measurements of passes, so it must be built with ENABLE_PASS_PROFILING."
+#endif
+
+std::string const DEFAULT_SCRIPT = "repeat(5){dup_ops; 3in_min}; dup_ops";
+
+/**
+ * @return values of a comma separated list.
+ */
+std::vector<std::size_t> parseSizes(std::string const& list)
+{
+    std::vector<std::size_t> sizes{};
+    std::istringstream stream(list);
+    std::string item{};
+    while (std::getline(stream, item, ','))
+    {
+        sizes.push_back(std::stoull(item));
+    }
+    return sizes;
+}
+
+/**
+ * Loads database of the basis, which is required by subcircuits minimization.
+ */
+void loadDatabase(std::filesystem::path const& databases_path, csat::Basis basis)
+{
+    std::filesystem::path const path =
+        databases_path / (basis == csat::Basis::AIG ? "database_aig.txt" : "database_bench.txt");
+    if (!std::filesystem::exists(path))
+    {
+        std::cerr << "There is no database " << path.string() << ", provide `--databases`, or a script without "
+                  << "subcircuits minimization." << std::endl;
+        std::abort();
+    }
+    auto database = std::make_shared<csat::simplification::CircuitDB>(path, basis);
+    if (basis == csat::Basis::AIG)
+    {
+        csat::simplification::DBSingleton::getInstance().aig_db = std::move(database);
+    }
+    else
+    {
+        csat::simplification::DBSingleton::getInstance().bench_db = std::move(database);
+    }
+}
+
+/**
+ * Generates circuits of the same family and growing size in memory, simplifies each of
+ * them by a script and reports wall time, peak RSS delta and circuit size of each pass,
+ * so it may be seen how each pass scales with the circuit size.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("scaling_bench");
+    program.add_argument("-f", "--family")
+        .default_value(std::string("random"))
+        .help("circuit family [adder|multiplier|multiplier_miter|random|parity]");
+    program.add_argument("-b", "--basis").default_value(std::string("BENCH")).help("Choose basis [AIG|BENCH]");
+    program.add_argument("-n", "--sizes")
+        .default_value(std::string("10000,100000,1000000"))
+        .help("comma separated sizes of generated circuits, see `circuit_generator --help`");
+    program.add_argument("--inputs")
+        .default_value(std::size_t{1'000})
+        .scan<'u', std::size_t>()
+        .help("number of inputs of random circuits");
+    program.add_argument("--outputs")
+        .default_value(std::size_t{1'000})
+        .scan<'u', std::size_t>()
+        .help("number of outputs of random and parity circuits");
+    program.add_argument("--depth")
+        .default_value(std::size_t{100})
+        .scan<'u', std::size_t>()
+        .help("number of levels of random circuits");
+    program.add_argument("--width")
+        .default_value(std::size_t{0})
+        .scan<'u', std::size_t>()
+        .help("number of inputs of each parity tree, all inputs if zero");
+    program.add_argument("--script").default_value(std::string(DEFAULT_SCRIPT)).help("simplification script");
+    program.add_argument("-d", "--databases")
+        .default_value(std::string(BENCHMARK_DATABASES_DIR))
+        .help("path to directory with text databases");
+    program.add_argument("--csv").default_value(false).implicit_value(true).help("print results as CSV");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    csat::generation::GeneratorParameters parameters{};
+    parameters.family       = csat::generation::stringToFamily(program.get<std::string>("--family"));
+    std::string const basis = program.get<std::string>("--basis");
+    if (basis != "AIG" && basis != "BENCH")
+    {
+        std::cerr << "Incorrect basis! Choose one of [AIG, BENCH]" << std::endl;
+        std::abort();
+    }
+    parameters.basis   = basis == "AIG" ? csat::Basis::AIG : csat::Basis::BENCH;
+    parameters.inputs  = program.get<std::size_t>("--inputs");
+    parameters.outputs = program.get<std::size_t>("--outputs");
+    parameters.depth   = program.get<std::size_t>("--depth");
+    parameters.width   = program.get<std::size_t>("--width");
+
+    std::string const script = program.get<std::string>("--script");
+    auto const registry      = csat::simplification::makeTransformerRegistry<csat::DAG>(parameters.basis);
+    // Script is validated before any circuit is generated.
+    csat::simplification::buildScript<csat::DAG>(script, registry);
+    if (script.find("3in_min") != std::string::npos || script.find("incremental") != std::string::npos)
+    {
+        loadDatabase(program.get<std::string>("--databases"), parameters.basis);
+    }
+
+    bool const csv = program.get<bool>("--csv");
+    if (csv)
+    {
+        std::cout << "size,gates,pass,depth,duration_sec,peak_rss_delta_kb,gates_before,gates_after\n";
+    }
+    else
+    {
+        std::cout << std::left << std::setw(12) << "size" << std::setw(12) << "gates" << std::setw(36) << "pass"
+                  << std::right << std::setw(12) << "time, s" << std::setw(16) << "peak RSS +KB" << std::setw(14)
+                  << "gates before" << std::setw(14) << "gates after" << "\n";
+    }
+    auto const report = [csv](
+                            std::size_t size,
+                            std::size_t gates,
+                            std::string const& pass,
+                            std::size_t depth,
+                            double duration,
+                            std::int64_t peak_rss_delta_kb,
+                            std::size_t gates_before,
+                            std::size_t gates_after)
+    {
+        if (csv)
+        {
+            std::cout << size << "," << gates << "," << pass << "," << depth << "," << duration << ","
+                      << peak_rss_delta_kb << "," << gates_before << "," << gates_after << "\n";
+            return;
+        }
+        std::cout << std::left << std::setw(12) << size << std::setw(12) << gates << std::setw(36)
+                  << (std::string(2 * depth, ' ') + pass) << std::right << std::setw(12) << std::fixed
+                  << std::setprecision(3) << duration << std::setw(16) << peak_rss_delta_kb << std::setw(14)
+                  << gates_before << std::setw(14) << gates_after << std::defaultfloat << std::endl;
+    };
+
+    for (std::size_t const size : parseSizes(program.get<std::string>("--sizes")))
+    {
+        parameters.size = size;
+
+        auto const start              = std::chrono::steady_clock::now();
+        std::int64_t const rss_before = csat::simplification::getPeakRssKb_();
+        auto const circuit            = std::make_unique<csat::DAG>(csat::generation::generateDAG(parameters));
+        auto const encoder            = csat::generation::makeGateEncoder(circuit->getNumberOfGates());
+        double const generation_time  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::int64_t const rss_delta  = csat::simplification::getPeakRssKb_() - rss_before;
+        std::size_t const gates       = circuit->getNumberOfGates();
+        report(size, gates, "generation", 0, generation_time, rss_delta, 0, gates);
+
+        csat::simplification::SimplificationContext context{};
+        auto const pipeline = csat::simplification::buildScript<csat::DAG>(script, registry);
+        static_cast<void>(pipeline->apply(*circuit, encoder, context));
+        for (csat::simplification::PassRecord const& pass : context.profile.getPasses())
+        {
+            report(
+                size,
+                gates,
+                pass.name,
+                pass.depth,
+                pass.duration,
+                pass.peak_rss_delta_kb,
+                pass.gates_before,
+                pass.gates_after);
+        }
+    }
+    return 0;
+}
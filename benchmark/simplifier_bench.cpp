@@ -0,0 +1,390 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/bench_utils.hpp"
+#include "src/algo.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+#include "src/simplification/constant_gate_reducer.hpp"
+#include "src/simplification/duplicate_gates_cleaner.hpp"
+#include "src/simplification/duplicate_operands_cleaner.hpp"
+#include "src/simplification/reduce_not_composition.hpp"
+#include "src/simplification/redundant_gates_cleaner.hpp"
+#include "src/simplification/utils/circuits_db.hpp"
+#include "src/simplification/utils/three_coloring.hpp"
+#include "src/simplification/utils/two_coloring.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/utility/encoder.hpp"
+#include "src/utility/write_utils.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+#ifndef BENCHMARK_CIRCUITS_DIR
+#define BENCHMARK_CIRCUITS_DIR "benchmarks/"
+#endif
+
+#ifndef BENCHMARK_DATABASES_DIR
+#define BENCHMARK_DATABASES_DIR "databases/"
+#endif
+
+using csat::DAG;
+using Encoder = csat::utils::GateEncoder<std::string>;
+using Clock   = std::chrono::steady_clock;
+
+/**
+ * Circuit, on which components are measured.
+ */
+struct BenchInput
+{
+    std::string name;
+    /* Path to .bench file of the circuit, which is parsed by the parsing benchmark. */
+    std::string path;
+    std::unique_ptr<DAG> circuit;
+    Encoder encoder;
+};
+
+/**
+ * Benchmark of a single component. Iteration prepares its own data (e.g. copies of
+ * circuit), and returns wall time in seconds of the measured part only.
+ */
+struct Benchmark
+{
+    std::string name;
+    std::function<double(BenchInput const&)> iteration;
+};
+
+/**
+ * Result of repeated iterations of a benchmark.
+ */
+struct Measurement
+{
+    std::size_t iterations = 0;
+    double best            = 0;
+    double mean            = 0;
+};
+
+/**
+ * @return wall time of `function` in seconds.
+ */
+template<class Function>
+double timeIt(Function&& function)
+{
+    auto const start = Clock::now();
+    function();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * Repeats `iteration` until total measured time reaches `min_time`, but at least
+ * `min_iterations` and at most `max_iterations` times, like google-benchmark does.
+ */
+template<class Iteration>
+Measurement measure(double min_time, std::size_t min_iterations, std::size_t max_iterations, Iteration&& iteration)
+{
+    Measurement result{};
+    double total = 0;
+    while (result.iterations < max_iterations && (result.iterations < min_iterations || total < min_time))
+    {
+        double const time = iteration();
+        result.best       = (result.iterations == 0) ? time : std::min(result.best, time);
+        total += time;
+        ++result.iterations;
+    }
+    result.mean = total / static_cast<double>(std::max<std::size_t>(1, result.iterations));
+    return result;
+}
+
+/**
+ * @return benchmark of a transformer, which is applied to a fresh copy of the circuit each iteration.
+ */
+template<class TransformerT>
+Benchmark makeTransformerBenchmark(std::string name)
+{
+    return {
+        std::move(name),
+        [](BenchInput const& input)
+        {
+            auto circuit = std::make_unique<DAG>(*input.circuit);
+            auto encoder = std::make_unique<Encoder>(input.encoder);
+            csat::simplification::SimplificationContext context{};
+            return timeIt([&]()
+                          { TransformerT().transform(std::move(circuit), std::move(encoder), context); });
+        }};
+}
+
+/**
+ * @return benchmarks of all components, which work on a circuit.
+ */
+std::vector<Benchmark> makeCircuitBenchmarks(std::filesystem::path const& scratch_path)
+{
+    std::vector<Benchmark> benchmarks{};
+    benchmarks.push_back(
+        {"parse",
+         [](BenchInput const& input)
+         {
+             csat::parser::BenchToCircuit<DAG> parser{};
+             return timeIt([&]() { parser.parseFile(input.path); });
+         }});
+    benchmarks.push_back(
+        {"topsort",
+         [](BenchInput const& input)
+         {
+             // Cache of the circuit is bypassed, so that each repetition runs the search.
+             return timeIt([&]()
+                           { csat::algo::TopSortAlgorithm<csat::algo::DFSTopSort>::computeSorting(*input.circuit); });
+         }});
+    benchmarks.push_back(
+        {"two_coloring",
+         [](BenchInput const& input) { return timeIt([&]() { csat::utils::TwoColoring{*input.circuit}; }); }});
+    benchmarks.push_back(
+        {"three_coloring",
+         [](BenchInput const& input) { return timeIt([&]() { csat::utils::ThreeColoring{*input.circuit}; }); }});
+
+    using namespace csat::simplification;
+    benchmarks.push_back(makeTransformerBenchmark<RedundantGatesCleaner_<DAG>>("redundant_gates_cleaner"));
+    benchmarks.push_back(makeTransformerBenchmark<DuplicateOperandsCleaner_<DAG>>("duplicate_operands_cleaner"));
+    benchmarks.push_back(makeTransformerBenchmark<ConstantGateReducer_<DAG>>("constant_gate_reducer"));
+    benchmarks.push_back(makeTransformerBenchmark<ReduceNotComposition_<DAG>>("reduce_not_composition"));
+    benchmarks.push_back(makeTransformerBenchmark<DuplicateGatesCleaner_<DAG>>("duplicate_gates_cleaner"));
+
+    benchmarks.push_back(
+        {"write_bench",
+         [scratch_path](BenchInput const& input)
+         {
+             std::ofstream file(scratch_path / "write_bench.bench");
+             return timeIt([&]() { writeBenchFile(*input.circuit, input.encoder, file); });
+         }});
+    return benchmarks;
+}
+
+/**
+ * @return input, parsed from a .bench file.
+ */
+BenchInput readInput(std::string const& path)
+{
+    csat::parser::BenchToCircuit<DAG> parser{};
+    parser.parseFile(path);
+    return {std::filesystem::path(path).stem().string(), path, parser.instantiate(), parser.getEncoder()};
+}
+
+/**
+ * @return random circuit in BENCH basis, which is also written to a .bench file to be parsed.
+ */
+BenchInput makeRandomInput(std::size_t gates, std::filesystem::path const& scratch_path)
+{
+    BenchInput input{};
+    input.name    = "random_" + std::to_string(gates);
+    input.path    = (scratch_path / (input.name + ".bench")).string();
+    input.circuit = std::make_unique<DAG>(csat::bench::buildRandomCircuit(1'000, gates, 1'000, 42));
+    for (csat::GateId gateId = 0; gateId < input.circuit->getNumberOfGates(); ++gateId)
+    {
+        input.encoder.encodeGate(std::to_string(gateId));
+    }
+    std::ofstream file(input.path);
+    writeBenchFile(*input.circuit, input.encoder, file);
+    return input;
+}
+
+/**
+ * Prints results either as an aligned table, or as CSV rows.
+ */
+class Reporter
+{
+    bool csv_;
+
+  public:
+    explicit Reporter(bool csv)
+        : csv_(csv)
+    {
+        if (csv_)
+        {
+            std::cout << "benchmark,input,gates,iterations,best_sec,mean_sec,best_ns_per_gate\n";
+            return;
+        }
+        std::cout << std::left << std::setw(28) << "benchmark" << std::setw(64) << "input" << std::right
+                  << std::setw(10) << "gates" << std::setw(8) << "iters" << std::setw(12) << "best ms"
+                  << std::setw(12) << "mean ms" << std::setw(12) << "ns/gate" << "\n";
+    }
+
+    void report(std::string const& benchmark, std::string const& input, std::size_t gates, Measurement const& result)
+        const
+    {
+        double const ns_per_gate = gates > 0 ? result.best * 1e9 / static_cast<double>(gates) : 0.0;
+        if (csv_)
+        {
+            std::cout << benchmark << "," << input << "," << gates << "," << result.iterations << "," << result.best
+                      << "," << result.mean << "," << ns_per_gate << "\n";
+            return;
+        }
+        std::cout << std::left << std::setw(28) << benchmark << std::setw(64) << input << std::right << std::setw(10)
+                  << gates << std::setw(8) << result.iterations << std::fixed << std::setprecision(3)
+                  << std::setw(12) << result.best * 1e3 << std::setw(12) << result.mean * 1e3 << std::setw(12)
+                  << std::setprecision(1) << ns_per_gate << std::defaultfloat << "\n";
+    }
+};
+
+/**
+ * Measures load of the small circuits databases and lookups in them.
+ */
+void runDatabaseBenchmarks(
+    std::filesystem::path const& databases_path,
+    std::regex const& filter,
+    Reporter const& reporter,
+    std::function<Measurement(std::function<double()> const&)> const& run)
+{
+    for (auto const& [file_name, basis] :
+         {std::pair{"database_bench", csat::Basis::BENCH}, std::pair{"database_aig", csat::Basis::AIG}})
+    {
+        std::filesystem::path const path = databases_path / (std::string(file_name) + ".txt");
+        if (!std::filesystem::exists(path))
+        {
+            continue;
+        }
+        if (std::regex_search("db_load/" + std::string(file_name), filter))
+        {
+            reporter.report(
+                "db_load",
+                file_name,
+                0,
+                run([&]() { return timeIt([&]() { csat::simplification::CircuitDB const db(path, basis); }); }));
+        }
+        if (!std::regex_search("db_lookup/" + std::string(file_name), filter))
+        {
+            continue;
+        }
+
+        // Keys of one to three outputs with random truth tables, as they are looked up by minimization.
+        csat::simplification::CircuitDB const db(path, basis);
+        std::mt19937 generator(42);
+        std::vector<uint32_t> keys(1 << 20);
+        for (uint32_t& key : keys)
+        {
+            std::vector<int32_t> patterns(1 + generator() % 3);
+            for (int32_t& pattern : patterns)
+            {
+                pattern = static_cast<int32_t>(generator() % 256);
+            }
+            key = csat::simplification::CircuitDB::packPatterns(patterns);
+        }
+        std::size_t volatile found = 0;
+        reporter.report(
+            "db_lookup",
+            file_name,
+            keys.size(),
+            run(
+                [&]()
+                {
+                    return timeIt(
+                        [&]()
+                        {
+                            std::size_t hits = 0;
+                            for (uint32_t const key : keys)
+                            {
+                                hits += db.findPattern(key) != csat::simplification::CircuitDB::NOT_FOUND ? 1 : 0;
+                            }
+                            // Keeps lookups from being optimized out.
+                            found = hits;
+                        });
+                }));
+    }
+}
+
+/**
+ * Runs microbenchmarks of each component of the tool: parsing, top sort, colorings,
+ * cleaners, databases and writing. Components are measured on the representative
+ * circuits and on a synthetic one, so a regression shows up per component.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("simplifier_bench");
+    program.add_argument("-i", "--input-path")
+        .default_value(std::string(BENCHMARK_CIRCUITS_DIR))
+        .help("directory with .BENCH files (or a single .BENCH file), empty to skip them");
+    program.add_argument("-d", "--databases")
+        .default_value(std::string(BENCHMARK_DATABASES_DIR))
+        .help("path to directory with text databases, benchmarks of databases are skipped if there are none");
+    program.add_argument("-g", "--random-gates")
+        .default_value(std::size_t{200'000})
+        .scan<'u', std::size_t>()
+        .help("number of gates of a synthetic random circuit, 0 to skip it");
+    program.add_argument("-f", "--filter")
+        .default_value(std::string(".*"))
+        .help("regular expression, only benchmarks whose `benchmark/input` matches it are run");
+    program.add_argument("--min-time")
+        .default_value(0.2)
+        .scan<'g', double>()
+        .help("minimal total measured time of each benchmark in seconds");
+    program.add_argument("--min-iterations")
+        .default_value(std::size_t{3})
+        .scan<'u', std::size_t>()
+        .help("minimal number of iterations of each benchmark");
+    program.add_argument("--max-iterations")
+        .default_value(std::size_t{1'000})
+        .scan<'u', std::size_t>()
+        .help("maximal number of iterations of each benchmark");
+    program.add_argument("--csv").default_value(false).implicit_value(true).help("print results as CSV");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    std::regex const filter(program.get<std::string>("--filter"));
+    double const min_time            = program.get<double>("--min-time");
+    std::size_t const min_iterations = program.get<std::size_t>("--min-iterations");
+    std::size_t const max_iterations = program.get<std::size_t>("--max-iterations");
+    auto const run = [&](std::function<double()> const& iteration)
+    { return measure(min_time, min_iterations, max_iterations, iteration); };
+
+    std::filesystem::path const scratch_path = std::filesystem::temp_directory_path() / "csat_simplifier_bench";
+    std::filesystem::create_directories(scratch_path);
+
+    std::vector<BenchInput> inputs{};
+    if (std::string const input_path = program.get<std::string>("--input-path"); !input_path.empty())
+    {
+        for (std::string const& path : csat::bench::listCircuitFiles(input_path))
+        {
+            inputs.push_back(readInput(path));
+        }
+    }
+    if (auto const random_gates = program.get<std::size_t>("--random-gates"); random_gates > 0)
+    {
+        inputs.push_back(makeRandomInput(random_gates, scratch_path));
+    }
+
+    Reporter const reporter(program.get<bool>("--csv"));
+    for (Benchmark const& benchmark : makeCircuitBenchmarks(scratch_path))
+    {
+        for (BenchInput const& input : inputs)
+        {
+            if (std::regex_search(benchmark.name + "/" + input.name, filter))
+            {
+                reporter.report(
+                    benchmark.name,
+                    input.name,
+                    input.circuit->getNumberOfGates(),
+                    run([&]() { return benchmark.iteration(input); }));
+            }
+        }
+    }
+    runDatabaseBenchmarks(program.get<std::string>("--databases"), filter, reporter, run);
+
+    std::filesystem::remove_all(scratch_path);
+    return 0;
+}
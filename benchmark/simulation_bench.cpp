@@ -0,0 +1,77 @@
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "benchmark/bench_utils.hpp"
+#include "src/simulation/bit_parallel_simulator.hpp"
+#include "src/utility/thread_pool.hpp"
+#include "third_party/argparse/include/argparse/argparse.hpp"
+
+/**
+ * Measures throughput of random simulation of a circuit with given number of words per gate.
+ * Gates of each level are simulated in parallel, if a thread pool is given.
+ */
+template<std::size_t Words>
+void measureSimulation(csat::DAG const& circuit, std::size_t repetitions, csat::utils::ThreadPool* pool)
+{
+    csat::simulation::BitParallelSimulator<Words> simulator(circuit, pool);
+    uint64_t seed           = 1;
+    double const best_time  = csat::bench::measureBestTime(repetitions, [&]() { simulator.simulateRandom(seed++); });
+    double const throughput = static_cast<double>(circuit.getNumberOfGates()) *
+                              static_cast<double>(decltype(simulator)::PATTERNS_NUMBER) / best_time;
+
+    std::cout << std::left << std::setw(16) << (std::to_string(decltype(simulator)::PATTERNS_NUMBER) + " patterns")
+              << std::right << std::setw(12) << std::setprecision(4) << best_time << " sec, " << std::setw(10)
+              << throughput / 1e9 << " G gate-patterns/sec\n";
+}
+
+/**
+ * Measures throughput of bit-parallel random simulation of a large random circuit.
+ */
+int main(int argn, char** argv)
+{
+    argparse::ArgumentParser program("simulation_bench");
+    program.add_argument("-g", "--gates")
+        .default_value(std::size_t{1'000'000})
+        .scan<'u', std::size_t>()
+        .help("number of gates of the random circuit");
+    program.add_argument("-n", "--inputs")
+        .default_value(std::size_t{1'000})
+        .scan<'u', std::size_t>()
+        .help("number of inputs of the random circuit");
+    program.add_argument("-r", "--repetitions")
+        .default_value(std::size_t{5})
+        .scan<'u', std::size_t>()
+        .help("number of simulations, the best time is reported");
+    program.add_argument("-t", "--threads")
+        .default_value(std::size_t{1})
+        .scan<'u', std::size_t>()
+        .help("number of threads, which simulate gates of each level in parallel");
+
+    try
+    {
+        program.parse_args(argn, argv);
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        std::abort();
+    }
+
+    auto const gates       = program.get<std::size_t>("--gates");
+    auto const inputs      = std::max<std::size_t>(1, program.get<std::size_t>("--inputs"));
+    auto const repetitions = program.get<std::size_t>("--repetitions");
+    auto const threads     = program.get<std::size_t>("--threads");
+
+    csat::DAG const circuit = csat::bench::buildRandomCircuit(inputs, gates, 64, 42);
+    std::cout << "circuit: " << circuit.getNumberOfGates() << " gates, " << threads << " threads\n";
+    std::unique_ptr<csat::utils::ThreadPool> const pool =
+        threads > 1 ? std::make_unique<csat::utils::ThreadPool>(threads) : nullptr;
+    measureSimulation<1>(circuit, repetitions, pool.get());
+    measureSimulation<4>(circuit, repetitions, pool.get());
+    measureSimulation<16>(circuit, repetitions, pool.get());
+    return 0;
+}
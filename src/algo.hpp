@@ -1,20 +1,18 @@
 #pragma once
 
-#include <deque>
-#include <functional>
-#include <iostream>
-#include <list>
+#include <algorithm>
 #include <numeric>
-#include <stack>
 #include <vector>
 
 #include "src/common/csat_types.hpp"
 #include "src/structures/circuit/dag.hpp"
+#include "src/utility/levelization.hpp"
+#include "src/utility/profiler.hpp"
 
 /**
  * Namespace contains some algorithms for data structures,
- * and data processing. It includes a DFS and different
- * TopSort realisations.
+ * and data processing. It includes a DFS, a BFS, different
+ * TopSort realisations and levelization of gates.
  */
 namespace csat::algo
 {
@@ -28,125 +26,200 @@ enum class DFSState : uint8_t
 
 using DFSStateVector = std::vector<DFSState>;
 
-using OperationDFSGate = std::function<void(GateId, DFSStateVector const&)>;
-using OperationDFSVoid = std::function<void()>;
-
-[[maybe_unused]]
-static void voidOperationGate_(GateId /*unused*/, DFSStateVector const& /*unused*/)
+/**
+ * Callable, which does nothing. It is a default operation of searches, so that
+ * omitted hooks are inlined away.
+ */
+struct NoOperation
 {
-}
-[[maybe_unused]]
-static void voidOperationVoid_()
+    template<class... Args>
+    constexpr void operator()(Args&&... /*unused*/) const noexcept
+    {
+    }
+};
+
+/**
+ * @return operands of gate if arcs point from gates to their operands, and users otherwise.
+ */
+template<bool fromOperatorsToOperands>
+inline GateIdSpan getNextGates_(ICircuit const& circuit, GateId gateId)
 {
+    if constexpr (fromOperatorsToOperands)
+    {
+        return circuit.getGateOperands(gateId);
+    }
+    else
+    {
+        return circuit.getGateUsers(gateId);
+    }
 }
 
 /**
  * Performs Depth First Search on Circuit gates, where arcs are thought to
  * point from gates to their operands. DFS is iteratively run on `startGates`
- * node in begin to end order. Body of DFS is customizable with method parameters.
+ * node in begin to end order. Body of DFS is customizable with method parameters,
+ * which are arbitrary callables, so they are inlined into the search loop.
+ *
+ * Search keeps an explicit stack of frames (gate and its not yet processed next
+ * gates), so it visits gates in the same order as the recursive search does,
+ * each arc is looked at exactly once, and stack size is bounded by circuit depth.
  *
  * @tparam fromOperatorsToOperands -- bool flag, if True, then arcs in
  *         circuit will be thought to point from gate to its operands.
  *
  * @param circuit -- a circuit to perform DFS on.
  * @param startGates -- gates that will be start points of DFS.
- * @param previsitOperation -- operation, that is performed on
- *        gate right before first visiting it in DFS.
- * @param postvisitOperation -- operation, that is performed on
- *        gate right after first visiting it in DFS.
+ * @param previsitOperation -- operation `(GateId, DFSStateVector const&)`, that
+ *        is performed on gate right before first visiting it in DFS.
+ * @param postvisitOperation -- operation `(GateId, DFSStateVector const&)`, that
+ *        is performed on gate right after first visiting it in DFS.
  * @param dfsOverOperation -- method that is called right after
  *        dfs over, and takes no arguments.
- * @param unvisitedVertexOperation -- operation, that is performed
- *        on all unvisited gates, without any ordering guarantee.
+ * @param unvisitedVertexOperation -- operation `(GateId, DFSStateVector const&)`,
+ *        that is performed on all unvisited gates, without any ordering guarantee.
  *
  * @return mask of visited gates.
  */
-template<bool fromOperatorsToOperands = true>
+template<
+    bool fromOperatorsToOperands = true,
+    class PrevisitOperationT     = NoOperation,
+    class PostvisitOperationT    = NoOperation,
+    class DFSOverOperationT      = NoOperation,
+    class UnvisitedOperationT    = NoOperation>
 inline DFSStateVector performDepthFirstSearch(
     ICircuit const& circuit,
     GateIdContainer const& startGates,
-    OperationDFSGate const& previsitOperation        = voidOperationGate_,
-    OperationDFSGate const& postvisitOperation       = voidOperationGate_,
-    OperationDFSVoid const& dfsOverOperation         = voidOperationVoid_,
-    OperationDFSGate const& unvisitedVertexOperation = voidOperationGate_)
+    PrevisitOperationT&& previsitOperation        = {},
+    PostvisitOperationT&& postvisitOperation      = {},
+    DFSOverOperationT&& dfsOverOperation          = {},
+    UnvisitedOperationT&& unvisitedVertexOperation = {})
 {
+    CSAT_PROFILE_SCOPE("performDepthFirstSearch");
+
     // Believe that all gates are named from 0 through N.
-    std::vector<DFSState> dfs_state(circuit.getNumberOfGates(), DFSState::UNVISITED);
+    DFSStateVector dfs_state(circuit.getNumberOfGates(), DFSState::UNVISITED);
 
-    // Getter of next node depends on template parameter (arcs orientation).
-    std::function<GateIdContainer(GateId)> next_getter;
-    if constexpr (fromOperatorsToOperands)
-    {
-        next_getter = [&circuit](GateId gateId) -> GateIdContainer const& { return circuit.getGateOperands(gateId); };
-    }
-    else
+    // Frame of the search: entered gate and its next gates, which are not yet looked at.
+    struct Frame
     {
-        next_getter = [&circuit](GateId gateId) -> GateIdContainer const& { return circuit.getGateUsers(gateId); };
-    }
-
-    std::stack<GateId> queue_{};
+        GateId gateId;
+        GateIdSpan::iterator next;
+        GateIdSpan::iterator end;
+    };
+    std::vector<Frame> stack{};
 
-    auto enqueue_next = [&dfs_state, &queue_](GateId nextGateId) -> void
+    auto enter = [&](GateId gateId) -> void
     {
-        if (dfs_state[nextGateId] == DFSState::UNVISITED)
-        {
-            queue_.push(nextGateId);
-        }
+        previsitOperation(gateId, dfs_state);  // custom
+        dfs_state[gateId] = DFSState::ENTERED;
+        GateIdSpan const next = getNextGates_<fromOperatorsToOperands>(circuit, gateId);
+        stack.push_back({gateId, next.begin(), next.end()});
     };
 
-    for (auto start : startGates)
+    for (GateId const start : startGates)
     {
-        enqueue_next(start);
-        while (!queue_.empty())
+        if (dfs_state[start] != DFSState::UNVISITED)
         {
-            GateId const gateId = queue_.top();
-            switch (dfs_state[gateId])
+            continue;
+        }
+        enter(start);
+        while (!stack.empty())
+        {
+            Frame& frame = stack.back();
+            if (frame.next == frame.end)
             {
-                case DFSState::UNVISITED:
-                {
-                    previsitOperation(gateId, dfs_state);  // custom
-                    dfs_state[gateId] = DFSState::ENTERED;
+                GateId const gateId = frame.gateId;
+                stack.pop_back();
+                dfs_state[gateId] = DFSState::VISITED;
+                postvisitOperation(gateId, dfs_state);  // custom
+                continue;
+            }
 
-                    GateIdContainer const& nextContainer = next_getter(gateId);
-                    std::for_each(nextContainer.rbegin(), nextContainer.rend(), enqueue_next);
-                    break;
-                }
-                case DFSState::ENTERED:
-                {
-                    dfs_state[gateId] = DFSState::VISITED;
-                    postvisitOperation(gateId, dfs_state);  // custom
-                    queue_.pop();
-                    break;
-                }
-                case DFSState::VISITED:
-                {
-                    // gate was already entered and left,
-                    // so we just silently pop it from queue.
-                    queue_.pop();
-                    break;
-                }
-                default:
-                {
-                    std::cerr << "During DFS execution wrong DFSState occurred." << std::endl;
-                    std::abort();
-                }
+            GateId const nextGateId = *frame.next;
+            ++frame.next;
+            // Gates, which are already entered or visited, are skipped.
+            if (dfs_state[nextGateId] == DFSState::UNVISITED)
+            {
+                // Invalidates `frame`.
+                enter(nextGateId);
             }
         }
     }
 
     dfsOverOperation();  // custom
 
-    for (size_t idx = 0; idx < dfs_state.size(); ++idx)
+    for (GateId gateId = 0; gateId < dfs_state.size(); ++gateId)
     {
-        if (dfs_state[idx] == DFSState::UNVISITED)
+        if (dfs_state[gateId] == DFSState::UNVISITED)
         {
-            unvisitedVertexOperation(idx, dfs_state);  // custom
+            unvisitedVertexOperation(gateId, dfs_state);  // custom
         }
     }
 
     return dfs_state;
 }
 
+/**
+ * Performs Breadth First Search on Circuit gates, starting from all `startGates`
+ * at once. Gates are visited in order of their distance from the start gates, and
+ * gates of the same distance are visited in order they were discovered.
+ *
+ * @tparam fromOperatorsToOperands -- bool flag, if True, then arcs in
+ *         circuit will be thought to point from gate to its operands.
+ *
+ * @param circuit -- a circuit to perform BFS on.
+ * @param startGates -- gates of zero distance.
+ * @param visitOperation -- operation `(GateId, size_t distance)`, that is performed
+ *        on each reachable gate once.
+ *
+ * @return mask of visited gates.
+ */
+template<bool fromOperatorsToOperands = true, class VisitOperationT = NoOperation>
+inline BoolVector performBreadthFirstSearch(
+    ICircuit const& circuit,
+    GateIdContainer const& startGates,
+    VisitOperationT&& visitOperation = {})
+{
+    CSAT_PROFILE_SCOPE("performBreadthFirstSearch");
+
+    BoolVector visited(circuit.getNumberOfGates(), 0);
+    // Queue is a vector, since each gate is put into it at most once.
+    GateIdContainer queue{};
+    queue.reserve(circuit.getNumberOfGates());
+    for (GateId const start : startGates)
+    {
+        if (visited[start] == 0)
+        {
+            visited[start] = 1;
+            queue.push_back(start);
+        }
+    }
+
+    size_t head     = 0;
+    size_t distance = 0;
+    while (head < queue.size())
+    {
+        // Gates of the current distance are queue[head..level_end).
+        size_t const level_end = queue.size();
+        for (; head < level_end; ++head)
+        {
+            GateId const gateId = queue[head];
+            visitOperation(gateId, distance);  // custom
+            for (GateId const nextGateId : getNextGates_<fromOperatorsToOperands>(circuit, gateId))
+            {
+                if (visited[nextGateId] == 0)
+                {
+                    visited[nextGateId] = 1;
+                    queue.push_back(nextGateId);
+                }
+            }
+        }
+        ++distance;
+    }
+
+    return visited;
+}
+
 // Auxiliary struct to be used as template parameters.
 struct DFSTopSort;
 
@@ -167,9 +240,55 @@ struct TopSortAlgorithm<DFSTopSort>
      * @param circuit -- topology of circuit, which gates must be sorted
      * in topological order.
      * @return a vector of gates 1..N, sorted in topological order according
-     * to depth first search topological sorting algorithm.
+     * to depth first search topological sorting algorithm. Sorting is cached
+     * by the circuit until it is modified. Thread-safe as long as the circuit
+     * isn't modified concurrently.
+     *
+     * Note that simplification passes depend on the order of gates, so the
+     * order is always the one of depth first search, even if ids of gates
+     * are topological themselves. See `evaluationSorting` otherwise.
      */
     static GateIdContainer sorting(ICircuit const& circuit)
+    {
+        if (GateIdContainer const* cached_sorting = circuit.getCachedTopologicalOrder())
+        {
+            CSAT_PROFILE_COUNT("TopSort::cached", 1);
+            return *cached_sorting;
+        }
+
+        GateIdContainer gateSorting = computeSorting(circuit);
+        circuit.cacheTopologicalOrder(gateSorting);
+        return gateSorting;
+    }
+
+    /**
+     * @param circuit -- topology of circuit, which gates must be sorted
+     * in topological order.
+     * @return a vector of gates 1..N, sorted in some topological order, which
+     * is suitable for users, whose results don't depend on the choice of order,
+     * e.g. for evaluation of gates. If the circuit is numbered topologically,
+     * gates are just sorted by decreasing ids, which is a linear scan, otherwise
+     * the order is the one of `sorting`.
+     */
+    static GateIdContainer evaluationSorting(ICircuit const& circuit)
+    {
+        if (!circuit.isNumberedTopologically())
+        {
+            return sorting(circuit);
+        }
+        // Users have greater ids than their operands.
+        GateIdContainer gateSorting(circuit.getNumberOfGates());
+        std::iota(gateSorting.rbegin(), gateSorting.rend(), GateId{0});
+        return gateSorting;
+    }
+
+    /**
+     * @param circuit -- topology of circuit, which gates must be sorted
+     * in topological order.
+     * @return a vector of gates 1..N, sorted in topological order by depth
+     * first search, which is run regardless of the circuit's cache.
+     */
+    static GateIdContainer computeSorting(ICircuit const& circuit)
     {
         // Gather all sources in a circuit to start DFS from them.
         GateIdContainer sources{};
@@ -187,7 +306,7 @@ struct TopSortAlgorithm<DFSTopSort>
         performDepthFirstSearch(
             circuit,
             sources,
-            voidOperationGate_,
+            NoOperation{},
             // Add gate to sorting on leaving.
             [&gateSorting](GateId gate, DFSStateVector const&) { gateSorting.push_back(gate); },
             // Reverse sorting after DFS is over.
@@ -200,4 +319,15 @@ struct TopSortAlgorithm<DFSTopSort>
     }
 };
 
+/**
+ * @param circuit -- circuit, which gates must be grouped by their depth.
+ * @return levelization of all gates of circuit, see `utils::Levelization`.
+ */
+inline utils::Levelization levelize(ICircuit const& circuit)
+{
+    GateIdContainer order(TopSortAlgorithm<DFSTopSort>::sorting(circuit));
+    std::reverse(order.begin(), order.end());
+    return {order, circuit.getNumberOfGates(), [&circuit](GateId gateId) { return circuit.getGateOperands(gateId); }};
+}
+
 }  // namespace csat::algo
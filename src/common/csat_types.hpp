@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 /**
@@ -87,4 +90,34 @@ inline size_t getIndexByOperator(GateType gateType)
 using GateId          = size_t;
 using GateIdContainer = std::vector<GateId>;
 
+/**
+ * Read-only view over a contiguous sequence of gate ids. Circuits expose
+ * operands and users of their gates through it, so that the gate ids may
+ * be stored either in per-gate containers, or in a single flat array.
+ *
+ * View is implicitly constructible from a `GateIdContainer` and doesn't own
+ * its data: it is valid as long as the circuit it was obtained from is alive.
+ */
+class GateIdSpan : public std::span<GateId const>
+{
+  public:
+    using std::span<GateId const>::span;
+    using const_iterator = iterator;
+
+    [[nodiscard]]
+    GateId at(size_type idx) const
+    {
+        if (idx >= size())
+        {
+            throw std::out_of_range("GateIdSpan::at: index is out of range.");
+        }
+        return (*this)[idx];
+    }
+
+    friend bool operator==(GateIdSpan lhs, GateIdSpan rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+};
+
 }  // namespace csat
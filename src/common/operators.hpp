@@ -3,6 +3,7 @@
 #include <cassert>
 #include <cstdint>
 #include <functional>
+#include <span>
 #include <vector>
 
 #include "src/common/csat_types.hpp"
@@ -214,7 +215,7 @@ inline Operator getOperator(GateType type) noexcept
  */
 
 template<class T>
-using ContainerT = std::vector<T>;
+using ContainerT = std::span<T const>;
 template<class T>
 using MapFunction = std::function<GateState(T)>;
 template<class T>
@@ -230,7 +231,7 @@ template<class T, GateState TerminalState = GateState::UNDEFINED>
 inline GateState FoldMapOperator_(Operator oper, ContainerT<T> const& container, MapFunction<T> mapper) noexcept
 {
     assert((container.size() >= 2) && "Can't foldMap container with less then 2 elements.");
-    GateState state = oper(mapper(container.at(0)), mapper(container.at(1)), GateState::UNDEFINED);
+    GateState state = oper(mapper(container[0]), mapper(container[1]), GateState::UNDEFINED);
     for (auto it = container.begin() + 2; it != container.end(); ++it)
     {
         if constexpr (TerminalState != GateState::UNDEFINED)
@@ -251,7 +252,7 @@ template<class T>
 inline GateState NOT(ContainerT<T> const& container, MapFunction<T> mapper) noexcept
 {
     assert((container.size() == 1) && "Wrong number of arguments for NOT.");
-    return NOT(mapper(container.at(0)));
+    return NOT(mapper(container[0]));
 }
 
 template<class T>
@@ -300,14 +301,14 @@ template<class T>
 inline GateState MUX(ContainerT<T> const& container, MapFunction<T> mapper) noexcept
 {
     assert((container.size() == 3) && "Wrong number of arguments for MUX.");
-    return MUX(mapper(container.at(0)), mapper(container.at(1)), mapper(container.at(2)));
+    return MUX(mapper(container[0]), mapper(container[1]), mapper(container[2]));
 }
 
 template<class T>
 inline GateState IFF(ContainerT<T> const& container, MapFunction<T> mapper) noexcept
 {
     assert((container.size() == 1) && "Wrong number of arguments for IFF.");
-    return IFF(mapper(container.at(0)));
+    return IFF(mapper(container[0]));
 }
 
 template<class T>
@@ -0,0 +1,627 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <ostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/structures/circuit/gate_info.hpp"
+#include "src/utility/converters.hpp"
+#include "src/utility/encoder.hpp"
+
+/**
+ * Generators of parameterized synthetic circuits, which are used to measure how the
+ * tool scales with the circuit size. Generators emit gates in topological order to a
+ * sink, which either collects them in memory (`DAGSink`) or writes them straight to
+ * a `.bench` stream (`BenchSink`), so circuits larger than memory may be produced.
+ */
+namespace csat::generation
+{
+
+/**
+ * Collects generated gates in memory, so they may be instantiated as a `DAG`.
+ */
+class DAGSink
+{
+    GateInfoContainer gate_info_{};
+    GateIdContainer output_gates_{};
+
+  public:
+    GateId addGate(GateType type, GateIdContainer operands)
+    {
+        gate_info_.emplace_back(type, std::move(operands));
+        return gate_info_.size() - 1;
+    }
+
+    void addOutput(GateId gateId)
+    {
+        output_gates_.push_back(gateId);
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfGates() const
+    {
+        return gate_info_.size();
+    }
+
+    /**
+     * Builds circuit of collected gates. Leaves sink empty.
+     */
+    [[nodiscard]]
+    DAG instantiate()
+    {
+        DAG circuit(std::move(gate_info_), std::move(output_gates_));
+        gate_info_.clear();
+        output_gates_.clear();
+        return circuit;
+    }
+};
+
+/**
+ * Writes generated gates in `.bench` format as soon as they are added. Gates are named
+ * by their ids, so a parsed circuit gets the same ids. Outputs are written by `finish`.
+ */
+class BenchSink
+{
+    std::ostream& stream_;
+    GateId next_gate_ = 0;
+    GateIdContainer output_gates_{};
+
+  public:
+    explicit BenchSink(std::ostream& stream)
+        : stream_(stream)
+    {
+    }
+
+    GateId addGate(GateType type, GateIdContainer const& operands)
+    {
+        if (type == GateType::INPUT)
+        {
+            stream_ << "INPUT(" << next_gate_ << ")\n";
+            return next_gate_++;
+        }
+        stream_ << next_gate_ << " = " << utils::gateTypeToString(type) << "(";
+        for (size_t operand = 0; operand < operands.size(); ++operand)
+        {
+            stream_ << (operand == 0 ? "" : ", ") << operands[operand];
+        }
+        stream_ << ")\n";
+        return next_gate_++;
+    }
+
+    void addOutput(GateId gateId)
+    {
+        output_gates_.push_back(gateId);
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfGates() const
+    {
+        return next_gate_;
+    }
+
+    /**
+     * Writes outputs of the circuit. Must be called once all gates are added.
+     */
+    void finish()
+    {
+        for (GateId const output : output_gates_)
+        {
+            stream_ << "OUTPUT(" << output << ")\n";
+        }
+        stream_.flush();
+    }
+};
+
+/**
+ * Adds boolean operations to a sink as gates of the given basis. In `AIG` basis
+ * disjunction and exclusive disjunction are expressed by conjunctions and negations.
+ *
+ * @tparam SinkT -- either `DAGSink` or `BenchSink`.
+ */
+template<class SinkT>
+class CircuitBuilder
+{
+    SinkT& sink_;
+    Basis basis_;
+
+  public:
+    CircuitBuilder(SinkT& sink, Basis basis)
+        : sink_(sink)
+        , basis_(basis)
+    {
+    }
+
+    GateId addInput()
+    {
+        return sink_.addGate(GateType::INPUT, {});
+    }
+
+    GateId addNot(GateId operand)
+    {
+        return sink_.addGate(GateType::NOT, {operand});
+    }
+
+    GateId addAnd(GateId lhs, GateId rhs)
+    {
+        return sink_.addGate(GateType::AND, {lhs, rhs});
+    }
+
+    GateId addOr(GateId lhs, GateId rhs)
+    {
+        if (basis_ == Basis::AIG)
+        {
+            return addNot(addAnd(addNot(lhs), addNot(rhs)));
+        }
+        return sink_.addGate(GateType::OR, {lhs, rhs});
+    }
+
+    GateId addXor(GateId lhs, GateId rhs)
+    {
+        if (basis_ == Basis::AIG)
+        {
+            return addAnd(addNot(addAnd(lhs, rhs)), addOr(lhs, rhs));
+        }
+        return sink_.addGate(GateType::XOR, {lhs, rhs});
+    }
+
+    void addOutput(GateId gateId)
+    {
+        sink_.addOutput(gateId);
+    }
+
+    [[nodiscard]]
+    Basis getBasis() const
+    {
+        return basis_;
+    }
+};
+
+/**
+ * Adds numbers, given by bits from the least significant one, by a ripple carry adder.
+ *
+ * @return bits of the sum, which is one bit longer than the longest summand.
+ */
+template<class SinkT>
+GateIdContainer addNumbers_(CircuitBuilder<SinkT>& builder, GateIdContainer const& lhs, GateIdContainer const& rhs)
+{
+    GateIdContainer sum{};
+    sum.reserve(std::max(lhs.size(), rhs.size()) + 1);
+    GateIdContainer bits{};
+    for (size_t position = 0; position < std::max(lhs.size(), rhs.size()); ++position)
+    {
+        // Carry of the previous position, if any, is already in `bits`.
+        if (position < lhs.size())
+        {
+            bits.push_back(lhs[position]);
+        }
+        if (position < rhs.size())
+        {
+            bits.push_back(rhs[position]);
+        }
+
+        if (bits.size() == 1)
+        {
+            sum.push_back(bits[0]);
+            bits.clear();
+        }
+        else if (bits.size() == 2)
+        {
+            sum.push_back(builder.addXor(bits[0], bits[1]));
+            bits = {builder.addAnd(bits[0], bits[1])};
+        }
+        else
+        {
+            GateId const half_sum = builder.addXor(bits[0], bits[1]);
+            sum.push_back(builder.addXor(half_sum, bits[2]));
+            bits = {builder.addOr(builder.addAnd(bits[0], bits[1]), builder.addAnd(half_sum, bits[2]))};
+        }
+    }
+    sum.insert(sum.end(), bits.begin(), bits.end());
+    return sum;
+}
+
+/**
+ * Multiplies numbers, given by bits from the least significant one, by an array multiplier,
+ * which adds shifted partial products one by one.
+ *
+ * @return bits of the product.
+ */
+template<class SinkT>
+GateIdContainer multiplyNumbers_(CircuitBuilder<SinkT>& builder, GateIdContainer const& lhs, GateIdContainer const& rhs)
+{
+    GateIdContainer product{};
+    for (size_t row = 0; row < rhs.size(); ++row)
+    {
+        GateIdContainer partial_product{};
+        partial_product.reserve(lhs.size());
+        for (GateId const bit : lhs)
+        {
+            partial_product.push_back(builder.addAnd(bit, rhs[row]));
+        }
+        if (row == 0)
+        {
+            product = std::move(partial_product);
+            continue;
+        }
+        // The lowest `row` bits of the product are already final.
+        GateIdContainer const high_bits(product.begin() + static_cast<std::ptrdiff_t>(row), product.end());
+        GateIdContainer const high_sum = addNumbers_(builder, high_bits, partial_product);
+        product.resize(row);
+        product.insert(product.end(), high_sum.begin(), high_sum.end());
+    }
+    return product;
+}
+
+/**
+ * Combines bits by a balanced tree of binary operations. At least one bit must be given.
+ */
+template<class SinkT, class Operation>
+GateId reduceBits_(CircuitBuilder<SinkT>& builder, GateIdContainer bits, Operation operation)
+{
+    while (bits.size() > 1)
+    {
+        GateIdContainer next_bits{};
+        next_bits.reserve((bits.size() + 1) / 2);
+        for (size_t bit = 0; bit + 1 < bits.size(); bit += 2)
+        {
+            next_bits.push_back(operation(builder, bits[bit], bits[bit + 1]));
+        }
+        if (bits.size() % 2 == 1)
+        {
+            next_bits.push_back(bits.back());
+        }
+        bits = std::move(next_bits);
+    }
+    assert(!bits.empty());
+    return bits.front();
+}
+
+template<class SinkT>
+GateIdContainer addInputs_(CircuitBuilder<SinkT>& builder, size_t number)
+{
+    GateIdContainer inputs{};
+    inputs.reserve(number);
+    for (size_t input = 0; input < number; ++input)
+    {
+        inputs.push_back(builder.addInput());
+    }
+    return inputs;
+}
+
+/**
+ * Generates adder of two `bits`-bit numbers. Inputs are bits of the first and then of the
+ * second summand, outputs are `bits + 1` bits of the sum, all from the least significant one.
+ */
+template<class SinkT>
+void generateAdder(CircuitBuilder<SinkT>& builder, size_t bits)
+{
+    if (bits == 0)
+    {
+        std::cerr << "Adder must have at least one bit." << std::endl;
+        std::abort();
+    }
+    GateIdContainer const lhs = addInputs_(builder, bits);
+    GateIdContainer const rhs = addInputs_(builder, bits);
+    for (GateId const bit : addNumbers_(builder, lhs, rhs))
+    {
+        builder.addOutput(bit);
+    }
+}
+
+/**
+ * Generates multiplier of two `bits`-bit numbers, which has about `6 * bits^2` gates in
+ * `BENCH` basis. Inputs and outputs are ordered as the ones of `generateAdder`.
+ */
+template<class SinkT>
+void generateMultiplier(CircuitBuilder<SinkT>& builder, size_t bits)
+{
+    if (bits == 0)
+    {
+        std::cerr << "Multiplier must have at least one bit." << std::endl;
+        std::abort();
+    }
+    GateIdContainer const lhs = addInputs_(builder, bits);
+    GateIdContainer const rhs = addInputs_(builder, bits);
+    for (GateId const bit : multiplyNumbers_(builder, lhs, rhs))
+    {
+        builder.addOutput(bit);
+    }
+}
+
+/**
+ * Generates unsatisfiable miter of two multipliers of `bits`-bit numbers, which sum partial
+ * products in different order, since operands of the second one are swapped. The only output
+ * is true iff products differ.
+ */
+template<class SinkT>
+void generateMultiplierMiter(CircuitBuilder<SinkT>& builder, size_t bits)
+{
+    if (bits == 0)
+    {
+        std::cerr << "Multiplier miter must have at least one bit." << std::endl;
+        std::abort();
+    }
+    GateIdContainer const lhs          = addInputs_(builder, bits);
+    GateIdContainer const rhs          = addInputs_(builder, bits);
+    GateIdContainer const product      = multiplyNumbers_(builder, lhs, rhs);
+    GateIdContainer const swap_product = multiplyNumbers_(builder, rhs, lhs);
+
+    GateIdContainer differences{};
+    differences.reserve(product.size());
+    for (size_t bit = 0; bit < product.size(); ++bit)
+    {
+        differences.push_back(builder.addXor(product[bit], swap_product[bit]));
+    }
+    builder.addOutput(reduceBits_(
+        builder,
+        std::move(differences),
+        [](CircuitBuilder<SinkT>& builder_, GateId lhs_, GateId rhs_) { return builder_.addOr(lhs_, rhs_); }));
+}
+
+/**
+ * Picks random node of `[begin, end)` range, preferring ones, whose fan-out is below the limit.
+ */
+inline size_t pickOperand_(
+    std::mt19937_64& generator,
+    std::vector<uint32_t>& fanout,
+    size_t max_fanout,
+    size_t begin,
+    size_t end)
+{
+    static constexpr size_t ATTEMPTS = 4;
+
+    size_t node = begin;
+    for (size_t attempt = 0; attempt < ATTEMPTS; ++attempt)
+    {
+        node = begin + generator() % (end - begin);
+        if (fanout[node] < max_fanout)
+        {
+            break;
+        }
+    }
+    ++fanout[node];
+    return node;
+}
+
+/**
+ * Generates random circuit of `gates` random binary operations (AND, OR or XOR, a quarter
+ * of which are negated) over `inputs` inputs. Operations are split into `depth` levels, and
+ * the first operand of each operation is taken from the previous level, so the circuit has
+ * exactly `depth` levels of operations. The second operand is any earlier node. Operands
+ * whose fan-out has reached `max_fanout` are avoided, though the limit is soft. Outputs are
+ * the last `outputs` operations.
+ */
+template<class SinkT>
+void generateRandomCircuit(
+    CircuitBuilder<SinkT>& builder,
+    size_t inputs,
+    size_t gates,
+    size_t outputs,
+    size_t depth,
+    size_t max_fanout,
+    uint64_t seed)
+{
+    if (inputs == 0)
+    {
+        std::cerr << "Random circuit must have at least one input." << std::endl;
+        std::abort();
+    }
+    std::mt19937_64 generator(seed);
+    // Nodes are inputs and operations. Gates of operation may differ from the node id,
+    // since operations are expressed in the basis by one or several gates.
+    GateIdContainer nodes = addInputs_(builder, inputs);
+    nodes.reserve(inputs + gates);
+    std::vector<uint32_t> fanout(inputs + gates, 0);
+
+    depth = std::clamp<size_t>(depth, 1, std::max<size_t>(gates, 1));
+    // Nodes of the previous level.
+    size_t level_begin = 0;
+    size_t level_end   = inputs;
+    for (size_t level = 0; level < depth; ++level)
+    {
+        size_t const level_size = gates / depth + (level < gates % depth ? 1 : 0);
+        for (size_t node = 0; node < level_size; ++node)
+        {
+            GateId const lhs = nodes[pickOperand_(generator, fanout, max_fanout, level_begin, level_end)];
+            GateId const rhs = nodes[pickOperand_(generator, fanout, max_fanout, 0, level_end)];
+
+            GateId gateId = 0;
+            switch (generator() % 3)
+            {
+                case 0:
+                    gateId = builder.addAnd(lhs, rhs);
+                    break;
+                case 1:
+                    gateId = builder.addOr(lhs, rhs);
+                    break;
+                default:
+                    gateId = builder.addXor(lhs, rhs);
+                    break;
+            }
+            if (generator() % 4 == 0)
+            {
+                gateId = builder.addNot(gateId);
+            }
+            nodes.push_back(gateId);
+        }
+        level_begin = level_end;
+        level_end   = nodes.size();
+    }
+
+    for (size_t output = 0; output < std::min(outputs, nodes.size()); ++output)
+    {
+        builder.addOutput(nodes[nodes.size() - 1 - output]);
+    }
+}
+
+/**
+ * Generates `outputs` XOR trees over `inputs` inputs. Each tree is balanced and combines
+ * `width` distinct random inputs, or all inputs if `width` is zero.
+ */
+template<class SinkT>
+void generateParity(CircuitBuilder<SinkT>& builder, size_t inputs, size_t outputs, size_t width, uint64_t seed)
+{
+    if (inputs == 0)
+    {
+        std::cerr << "Parity circuit must have at least one input." << std::endl;
+        std::abort();
+    }
+    std::mt19937_64 generator(seed);
+    GateIdContainer const input_gates = addInputs_(builder, inputs);
+    width                             = (width == 0) ? inputs : std::min(width, inputs);
+
+    auto const xor_operation = [](CircuitBuilder<SinkT>& builder_, GateId lhs, GateId rhs)
+    { return builder_.addXor(lhs, rhs); };
+    for (size_t output = 0; output < outputs; ++output)
+    {
+        if (width == inputs)
+        {
+            builder.addOutput(reduceBits_(builder, input_gates, xor_operation));
+            continue;
+        }
+        // Floyd's sampling of `width` distinct inputs.
+        GateIdContainer operands{};
+        std::unordered_set<size_t> chosen{};
+        for (size_t candidate = inputs - width; candidate < inputs; ++candidate)
+        {
+            size_t const input = generator() % (candidate + 1);
+            size_t const taken = chosen.insert(input).second ? input : candidate;
+            chosen.insert(taken);
+            operands.push_back(input_gates[taken]);
+        }
+        builder.addOutput(reduceBits_(builder, std::move(operands), xor_operation));
+    }
+}
+
+/**
+ * Families of generated circuits.
+ */
+enum class Family : uint8_t
+{
+    ADDER,
+    MULTIPLIER,
+    MULTIPLIER_MITER,
+    RANDOM,
+    PARITY
+};
+
+inline Family stringToFamily(std::string_view name)
+{
+    if (name == "adder")
+    {
+        return Family::ADDER;
+    }
+    if (name == "multiplier")
+    {
+        return Family::MULTIPLIER;
+    }
+    if (name == "multiplier_miter")
+    {
+        return Family::MULTIPLIER_MITER;
+    }
+    if (name == "random")
+    {
+        return Family::RANDOM;
+    }
+    if (name == "parity")
+    {
+        return Family::PARITY;
+    }
+    std::cerr << "Unknown circuit family \"" << name
+              << "\"! Choose one of [adder, multiplier, multiplier_miter, random, parity]" << std::endl;
+    std::abort();
+}
+
+/**
+ * Parameters of a generated circuit. Unused ones are ignored by the family.
+ */
+struct GeneratorParameters
+{
+    Family family = Family::RANDOM;
+    Basis basis   = Basis::BENCH;
+    /* Bit width of adders and multipliers, number of operations of random circuits,
+     * or number of inputs of parity circuits. */
+    size_t size = 1'000;
+    /* Number of inputs of random circuits. */
+    size_t inputs = 1'000;
+    /* Number of outputs of random and parity circuits. */
+    size_t outputs = 1;
+    /* Number of levels of random circuits. */
+    size_t depth = 100;
+    /* Soft limit of fan-out of random circuits nodes. */
+    size_t max_fanout = 8;
+    /* Number of inputs of each parity tree, all inputs if zero. */
+    size_t width = 0;
+    uint64_t seed = 42;
+};
+
+/**
+ * Generates circuit of given family to the sink.
+ */
+template<class SinkT>
+void generateCircuit(SinkT& sink, GeneratorParameters const& parameters)
+{
+    CircuitBuilder<SinkT> builder(sink, parameters.basis);
+    switch (parameters.family)
+    {
+        case Family::ADDER:
+            generateAdder(builder, parameters.size);
+            break;
+        case Family::MULTIPLIER:
+            generateMultiplier(builder, parameters.size);
+            break;
+        case Family::MULTIPLIER_MITER:
+            generateMultiplierMiter(builder, parameters.size);
+            break;
+        case Family::RANDOM:
+            generateRandomCircuit(
+                builder,
+                parameters.inputs,
+                parameters.size,
+                parameters.outputs,
+                parameters.depth,
+                parameters.max_fanout,
+                parameters.seed);
+            break;
+        case Family::PARITY:
+            generateParity(builder, parameters.size, parameters.outputs, parameters.width, parameters.seed);
+            break;
+    }
+}
+
+/**
+ * @return generated circuit, built in memory.
+ */
+inline DAG generateDAG(GeneratorParameters const& parameters)
+{
+    DAGSink sink{};
+    generateCircuit(sink, parameters);
+    return sink.instantiate();
+}
+
+/**
+ * @return encoder, which names gates of a generated circuit by their ids, as `BenchSink` does.
+ */
+inline utils::GateEncoder<std::string> makeGateEncoder(size_t number_of_gates)
+{
+    utils::GateEncoder<std::string> encoder{};
+    for (GateId gateId = 0; gateId < number_of_gates; ++gateId)
+    {
+        encoder.encodeGate(std::to_string(gateId));
+    }
+    return encoder;
+}
+
+}  // namespace csat::generation
@@ -95,10 +95,16 @@ class BenchToCircuit : public IBenchParser, public ICircuitBuilder<CircuitT>
      */
     void handleGate(std::string_view op, GateId gateId, GateIdContainer const& var_operands) final
     {
-        auto op_type = csat::utils::stringToGateType(std::string(op));
+        auto op_type = csat::utils::stringToGateType(op);
         _addGate(gateId, op_type, var_operands);
     };
 
+    [[nodiscard]]
+    bool isSpecialOperator_(std::string_view op) const final
+    {
+        return op == "CONST" || op == "vdd";
+    }
+
     bool specialOperatorCallback_(GateId gateId, std::string_view op, std::string_view operands_str) final
     {
         // Specific gate, which is found in some benchmarks.
@@ -1,15 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #include "src/common/csat_types.hpp"
 #include "src/parser/iparser.hpp"
 #include "src/utility/encoder.hpp"
 #include "src/utility/logger.hpp"
+#include "src/utility/mapped_file.hpp"
+#include "src/utility/profiler.hpp"
 #include "src/utility/string_utils.hpp"
 
 /**
@@ -42,6 +48,84 @@ class IBenchParser : public ICircuitParser
         logger.debug("Ended parsing of BENCH stream.");
     }
 
+    /**
+     * Parses info from buffer, that holds content of .BENCH file. Lines are
+     * tokenized in place, so no copies of the buffer are made.
+     * @param buffer -- content of some .BENCH file.
+     */
+    void parseBuffer(std::string_view buffer)
+    {
+        logger.debug("Started parsing of BENCH buffer.");
+        while (!buffer.empty())
+        {
+            size_t const line_end = buffer.find('\n');
+            if (line_end == std::string_view::npos)
+            {
+                parseBenchLine_(buffer);
+                break;
+            }
+            parseBenchLine_(buffer.substr(0, line_end));
+            buffer.remove_prefix(line_end + 1);
+        }
+        _eof();
+        logger.debug("Ended parsing of BENCH buffer.");
+    }
+
+    /**
+     * Parses info from buffer on several threads. Buffer is split into chunks at line
+     * boundaries, which are tokenized and have their names encoded concurrently. Then
+     * names of chunks are merged in order of chunks, so gate ids are exactly the same
+     * as ones assigned by `parseBuffer`. Handlers are called sequentially in order of lines.
+     *
+     * @param buffer -- content of some .BENCH file.
+     * @param threads_number -- number of threads (and chunks) to be used.
+     */
+    void parseBufferParallel(std::string_view buffer, size_t threads_number)
+    {
+        if (threads_number <= 1)
+        {
+            parseBuffer(buffer);
+            return;
+        }
+
+        logger.debug("Started parallel parsing of BENCH buffer on ", threads_number, " threads.");
+        std::vector<std::string_view> const chunks = splitIntoChunks_(buffer, threads_number);
+        std::vector<ParsedChunk_> parsed_chunks(chunks.size());
+
+        std::vector<std::thread> workers;
+        workers.reserve(chunks.size() - 1);
+        for (size_t chunk = 1; chunk < chunks.size(); ++chunk)
+        {
+            workers.emplace_back([this, &chunks, &parsed_chunks, chunk]()
+                                 { tokenizeChunk_(chunks[chunk], parsed_chunks[chunk]); });
+        }
+        tokenizeChunk_(chunks[0], parsed_chunks[0]);
+
+        // Chunks are merged as soon as they are ready, while later ones may still be tokenized.
+        mergeChunk_(parsed_chunks[0]);
+        for (size_t chunk = 1; chunk < chunks.size(); ++chunk)
+        {
+            workers[chunk - 1].join();
+            mergeChunk_(parsed_chunks[chunk]);
+            parsed_chunks[chunk] = {};
+        }
+        _eof();
+        logger.debug("Ended parallel parsing of BENCH buffer.");
+    }
+
+    /**
+     * Parses info from .BENCH file, which is memory-mapped instead of being read line by line.
+     * @param path -- path to the .BENCH file.
+     * @param threads_number -- number of threads to be used, see `parseBufferParallel`.
+     * @return size of parsed file in bytes.
+     */
+    size_t parseFile(std::string const& path, size_t threads_number = 1)
+    {
+        csat::utils::MappedFile const file(path);
+        parseBufferParallel(file.view(), threads_number);
+        return file.view().size();
+    }
+
     /* Encoder of inputs and gates. */
     csat::utils::GateEncoder<std::string> encoder;
 
@@ -58,6 +142,9 @@ class IBenchParser : public ICircuitParser
     /* Personal named logger. */
     Logger logger{"IBenchParser"};
 
+    /* Operands of the currently parsed gate, reused between lines to avoid allocations. */
+    GateIdContainer var_operands_{};
+
     /**
      * Encode circuit variable.
      * @param var_name -- name of encoded variable.
@@ -96,61 +183,246 @@ class IBenchParser : public ICircuitParser
      */
     inline virtual bool specialOperatorCallback_(GateId gateId, std::string_view op, std::string_view operands_str) = 0;
 
-    /* Parses one line of bench file. */
-    virtual void parseBenchLine_(std::string_view line)
+    /**
+     * Checks whether `op` is handled by `specialOperatorCallback_`. Used by parallel
+     * parsing, which can't call the callback before all names are encoded, thus it
+     * must agree with the callback and must be safe to call concurrently.
+     * @param op -- operation, with trimmed spaces.
+     */
+    [[nodiscard]]
+    virtual bool isSpecialOperator_(std::string_view op) const = 0;
+
+    /* Kinds of lines of bench file. */
+    enum class BenchLineKind_ : uint8_t
+    {
+        SKIP,
+        INPUT,
+        OUTPUT,
+        GATE
+    };
+
+    /* Tokens of one line of bench file, which are views to the line itself. */
+    struct BenchLine_
+    {
+        BenchLineKind_ kind = BenchLineKind_::SKIP;
+        std::string_view var_name{};
+        std::string_view op{};
+        std::string_view operands_str{};
+    };
+
+    /* Splits one line of bench file into tokens. */
+    [[nodiscard]]
+    BenchLine_ tokenizeBenchLine_(std::string_view line) const
     {
-        logger.debug("Parsing Line: \"", line, "\".");
         csat::utils::string_utils::trimSpaces(line);
         if (line.empty() || line[0] == '#' || line == "\n")
         {
-            logger.debug("\tReceived comment or empty line.");
-            return;
+            return {};
         }
         else if (line.substr(0, 5) == "INPUT")
         {
-            logger.debug("\tReceived input gate line.");
             std::string_view var_name = line.substr(6, line.find(')') - 6);
             csat::utils::string_utils::trimSpaces(var_name);
-
-            logger.debug("\tEncoding input gate: \"", var_name, "\".");
-            GateId const gateId = encodeGate(var_name);
-            handleInput(gateId);
-            return;
+            return {BenchLineKind_::INPUT, var_name, {}, {}};
         }
         else if (line.substr(0, 6) == "OUTPUT")
         {
-            logger.debug("\tReceived output gate line.");
             std::string_view var_name = line.substr(7, line.find(')') - 7);
             csat::utils::string_utils::trimSpaces(var_name);
+            return {BenchLineKind_::OUTPUT, var_name, {}, {}};
+        }
 
-            logger.debug("\tEncoding output gate: \"", var_name, "\".");
-            GateId const gateId = encodeGate(var_name);
-            handleOutput(gateId);
-            return;
+        // Operator gate
+
+        // Find special delimiters positions
+        auto [eq_idx, l_bkt_idx, r_bkt_idx] = _getDelimitersPositions(line);
+
+        std::string_view var_name = line.substr(0, eq_idx);
+        csat::utils::string_utils::trimSpaces(var_name);
+
+        std::string_view op = line.substr(eq_idx + 1, l_bkt_idx - eq_idx - 1);
+        csat::utils::string_utils::trimSpaces(op);
+
+        std::string_view operands_str;
+        if (r_bkt_idx > l_bkt_idx)
+        {
+            operands_str = line.substr(l_bkt_idx + 1, r_bkt_idx - l_bkt_idx - 1);
+            csat::utils::string_utils::trimSpaces(operands_str);
         }
         else
         {
-            // Operator gate
+            operands_str = line.substr(0, 0);
+        }
 
-            // Find special delimiters positions
-            auto [eq_idx, l_bkt_idx, r_bkt_idx] = _getDelimitersPositions(line);
+        return {BenchLineKind_::GATE, var_name, op, operands_str};
+    }
 
-            std::string_view var_name = line.substr(0, eq_idx);
-            csat::utils::string_utils::trimSpaces(var_name);
+    /* Calls `callback` for each comma-separated operand of `operands_str`, with trimmed spaces. */
+    template<class Callback>
+    static void forEachOperand_(std::string_view operands_str, Callback&& callback)
+    {
+        size_t comma_idx = 0;
+        while ((comma_idx = operands_str.find(',')) != std::string::npos)
+        {
+            std::string_view operand = operands_str.substr(0, comma_idx);
+            csat::utils::string_utils::trimSpaces(operand);
+            callback(operand);
+            operands_str = operands_str.substr(comma_idx + 1, operands_str.size() - comma_idx - 1);
+        }
+        csat::utils::string_utils::trimSpaces(operands_str);
+        callback(operands_str);
+    }
+
+    /* Line of bench file, whose names are encoded locally within its chunk. */
+    struct ParsedLine_
+    {
+        BenchLineKind_ kind = BenchLineKind_::SKIP;
+        /* Local id of gate. */
+        GateId gate_id = 0;
+        std::string_view op{};
+        /* Raw operands, which are used for special operators only. */
+        std::string_view operands_str{};
+        /* Range of local ids of operands in `ParsedChunk_::operands`. */
+        size_t operands_begin = 0;
+        size_t operands_end   = 0;
+    };
+
+    /* Result of tokenization of one chunk of bench file. */
+    struct ParsedChunk_
+    {
+        /* Names of chunk, encoded in order of their first occurrence in chunk. */
+        csat::utils::GateEncoder<std::string> names{};
+        std::vector<ParsedLine_> lines{};
+        GateIdContainer operands{};
+    };
+
+    /* Splits buffer into (at most) `chunks_number` nonempty chunks, which consist of whole lines. */
+    static std::vector<std::string_view> splitIntoChunks_(std::string_view buffer, size_t chunks_number)
+    {
+        std::vector<std::string_view> chunks;
+        size_t const chunk_size = buffer.size() / chunks_number + 1;
+        size_t begin            = 0;
+        while (begin < buffer.size())
+        {
+            size_t end = buffer.find('\n', std::min(begin + chunk_size, buffer.size()) - 1);
+            end        = (end == std::string_view::npos) ? buffer.size() : end + 1;
+            chunks.push_back(buffer.substr(begin, end - begin));
+            begin = end;
+        }
+        if (chunks.empty())
+        {
+            chunks.push_back(buffer);
+        }
+        return chunks;
+    }
 
-            std::string_view op = line.substr(eq_idx + 1, l_bkt_idx - eq_idx - 1);
-            csat::utils::string_utils::trimSpaces(op);
+    /* Tokenizes lines of chunk and encodes their names locally. Must be safe to call concurrently. */
+    void tokenizeChunk_(std::string_view chunk, ParsedChunk_& parsed) const
+    {
+        while (!chunk.empty())
+        {
+            size_t const line_end = chunk.find('\n');
+            std::string_view const line = (line_end == std::string_view::npos) ? chunk : chunk.substr(0, line_end);
+            chunk.remove_prefix((line_end == std::string_view::npos) ? chunk.size() : line_end + 1);
+
+            BenchLine_ const tokens = tokenizeBenchLine_(line);
+            if (tokens.kind == BenchLineKind_::SKIP)
+            {
+                continue;
+            }
 
-            std::string_view operands_str;
-            if (r_bkt_idx > l_bkt_idx)
+            ParsedLine_& parsed_line   = parsed.lines.emplace_back();
+            parsed_line.kind           = tokens.kind;
+            parsed_line.gate_id        = parsed.names.encodeGate(tokens.var_name);
+            parsed_line.op             = tokens.op;
+            parsed_line.operands_str   = tokens.operands_str;
+            parsed_line.operands_begin = parsed.operands.size();
+            if (tokens.kind == BenchLineKind_::GATE && !isSpecialOperator_(tokens.op))
             {
-                operands_str = line.substr(l_bkt_idx + 1, r_bkt_idx - l_bkt_idx - 1);
-                csat::utils::string_utils::trimSpaces(operands_str);
+                forEachOperand_(
+                    tokens.operands_str,
+                    [&parsed](std::string_view operand)
+                    { parsed.operands.push_back(parsed.names.encodeGate(operand)); });
             }
-            else
+            parsed_line.operands_end = parsed.operands.size();
+        }
+    }
+
+    /* Encodes names of tokenized chunk globally and calls handlers for its lines. */
+    void mergeChunk_(ParsedChunk_ const& parsed)
+    {
+        GateIdContainer local_to_global(parsed.names.size());
+        for (GateId local_id = 0; local_id < parsed.names.size(); ++local_id)
+        {
+            local_to_global[local_id] = encodeGate(parsed.names.decodeGateView(local_id));
+        }
+
+        for (ParsedLine_ const& line : parsed.lines)
+        {
+            GateId const gateId = local_to_global[line.gate_id];
+            switch (line.kind)
             {
-                operands_str = line.substr(0, 0);
+                case BenchLineKind_::INPUT:
+                    handleInput(gateId);
+                    break;
+                case BenchLineKind_::OUTPUT:
+                    handleOutput(gateId);
+                    break;
+                case BenchLineKind_::GATE:
+                    if (isSpecialOperator_(line.op))
+                    {
+                        if (!specialOperatorCallback_(gateId, line.op, line.operands_str))
+                        {
+                            std::cerr << "Special operator \"" << line.op << "\" is not handled." << std::endl;
+                            std::abort();
+                        }
+                        break;
+                    }
+                    var_operands_.clear();
+                    for (size_t idx = line.operands_begin; idx < line.operands_end; ++idx)
+                    {
+                        var_operands_.push_back(local_to_global[parsed.operands[idx]]);
+                    }
+                    handleGate(line.op, gateId, var_operands_);
+                    break;
+                default:
+                    break;
             }
+        }
+    }
+
+    /* Parses one line of bench file. */
+    virtual void parseBenchLine_(std::string_view line)
+    {
+        CSAT_PROFILE_SCOPE("IBenchParser::parseBenchLine_");
+        logger.debug("Parsing Line: \"", line, "\".");
+        BenchLine_ const tokens = tokenizeBenchLine_(line);
+        if (tokens.kind == BenchLineKind_::SKIP)
+        {
+            logger.debug("\tReceived comment or empty line.");
+            return;
+        }
+        else if (tokens.kind == BenchLineKind_::INPUT)
+        {
+            logger.debug("\tReceived input gate line.");
+            logger.debug("\tEncoding input gate: \"", tokens.var_name, "\".");
+            GateId const gateId = encodeGate(tokens.var_name);
+            handleInput(gateId);
+            return;
+        }
+        else if (tokens.kind == BenchLineKind_::OUTPUT)
+        {
+            logger.debug("\tReceived output gate line.");
+            logger.debug("\tEncoding output gate: \"", tokens.var_name, "\".");
+            GateId const gateId = encodeGate(tokens.var_name);
+            handleOutput(gateId);
+            return;
+        }
+        else
+        {
+            std::string_view const var_name     = tokens.var_name;
+            std::string_view const op           = tokens.op;
+            std::string_view const operands_str = tokens.operands_str;
 
             GateId const gateId = encodeGate(var_name);
 
@@ -175,17 +447,11 @@ class IBenchParser : public ICircuitParser
                 return;
             }
 
-            GateIdContainer var_operands;
-            size_t comma_idx = 0;
-            while ((comma_idx = operands_str.find(',')) != std::string::npos)
-            {
-                std::string_view operand = operands_str.substr(0, comma_idx);
-                csat::utils::string_utils::trimSpaces(operand);
-                var_operands.push_back(encodeGate(operand));
-                operands_str = operands_str.substr(comma_idx + 1, operands_str.size() - comma_idx - 1);
-            }
-            csat::utils::string_utils::trimSpaces(operands_str);
-            var_operands.push_back(encodeGate(operands_str));
+            GateIdContainer& var_operands = var_operands_;
+            var_operands.clear();
+            forEachOperand_(
+                operands_str, [this, &var_operands](std::string_view operand)
+                { var_operands.push_back(encodeGate(operand)); });
 
 #ifdef ENABLE_DEBUG_LOGGING
             logger.debug(
@@ -218,7 +484,7 @@ class IBenchParser : public ICircuitParser
     };
 
     /* Returns delimiters positions ( '=', '(', ')' ) in an operator bench line. */
-    std::tuple<size_t, size_t, size_t> _getDelimitersPositions(std::string_view line)
+    std::tuple<size_t, size_t, size_t> _getDelimitersPositions(std::string_view line) const
     {
         std::size_t line_size = line.size();
         // Find special delimiters positions
@@ -227,7 +493,7 @@ class IBenchParser : public ICircuitParser
         std::size_t r_bkt_idx = std::string::npos;
         for (size_t idx = 0; idx < line_size; ++idx)
         {
-            switch (line.at(idx))
+            switch (line[idx])
             {
                 case '=':
                     eq_idx = idx;
@@ -35,17 +35,25 @@ struct Composition : public ITransformer<CircuitT>
      *     T3().transform(T2().transform(T1().transform(circuit)))
      *
      * @param circuit -- circuit to transform.
+     * @param context -- context of the simplification run, shared by all transformers.
      * @return circuit, that is result of transformation.
      */
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
     {
         auto _transformer         = TransformerT();
-        auto [_circuit, _encoder] = _transformer.transform(std::move(circuit), std::move(encoder));
+        auto [_circuit, _encoder] = profilePass_(
+            std::move(circuit),
+            std::move(encoder),
+            context,
+            getTransformerName_<TransformerT>,
+            [&](auto circuit_, auto encoder_)
+            { return _transformer.transform(std::move(circuit_), std::move(encoder_), context); });
 
         Composition<CircuitT, OtherTransformersT...> obj_composition;
-        return obj_composition.transform(std::move(_circuit), std::move(_encoder));
+        return obj_composition.transform(std::move(_circuit), std::move(_encoder), context);
     }
 };
 
@@ -61,10 +69,17 @@ struct Composition<CircuitT, TransformerT> : public ITransformer<CircuitT>
   public:
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
     {
         auto _transformer = TransformerT();
-        return _transformer.transform(std::move(circuit), std::move(encoder));
+        return profilePass_(
+            std::move(circuit),
+            std::move(encoder),
+            context,
+            getTransformerName_<TransformerT>,
+            [&](auto circuit_, auto encoder_)
+            { return _transformer.transform(std::move(circuit_), std::move(encoder_), context); });
     }
 };
 
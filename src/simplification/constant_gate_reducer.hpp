@@ -14,7 +14,7 @@
 #include "src/common/csat_types.hpp"
 #include "src/simplification/transformer_base.hpp"
 #include "src/structures/assignment/vector_assignment.hpp"
-#include "src/structures/circuit/gate_info.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
 #include "src/utility/converters.hpp"
 #include "src/utility/logger.hpp"
 
@@ -49,15 +49,17 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
      * Applies ConstantGateReducer_ transformer to `circuit`
      * @param circuit -- circuit to transform.
      * @param encoder -- circuit encoder.
+     * @param context -- context of the simplification run.
      * @return  circuit and encoder after transformation.
      */
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
     {
         logger.debug("START ConstantGateReducer");
 
-        auto new_gate_name_prefix = (getUniqueId_() + "::new_gate_ConstantGateReducer@");
+        auto new_gate_name_prefix = (getUniqueId_(context) + "::new_gate_ConstantGateReducer@");
 
         static std::map<GateType, GateType> const xor_inverse_map = {
             {GateType::XOR,  GateType::NXOR},
@@ -67,7 +69,6 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
         csat::GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
 
         size_t circuit_size = circuit->getNumberOfGates();
-        GateInfoContainer gate_info(circuit_size);
 
         // Surjection of old gate ids to new gate ids.
         std::vector<GateId> old_to_new_gateId(circuit_size, SIZE_MAX);
@@ -75,10 +76,13 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
         // Evaluate circuit.
         auto result_assignment = circuit->template evaluateCircuit<VectorAssignment<true>>(VectorAssignment<false>{});
 
+        // Gates are processed from operands to users, so operands of the current gate
+        // are not modified yet, and links of all its operands are already known.
+        GateIdContainer operands{};
         for (GateId gate_id : std::ranges::reverse_view(gate_sorting))
         {
             GateType gate_type = circuit->getGateType(gate_id);
-            GateIdContainer operands{};
+            operands.clear();
 
             // After partial circuit calculation, we need to leave only undefined gates.
             // Defined gates from the circuit must be removed, and users of these gates
@@ -129,8 +133,8 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
                     }
                 }
 
-                // Prepare gate_info for current gate.
-                gate_info.at(gate_id) = {gate_type, operands};
+                // Rewrite current gate, if anything has changed.
+                circuit->updateGate(gate_id, gate_type, operands);
 
                 // If, after the reduction of the assigned gates, current gate left with only one operand,
                 // then all its users must be transferred either to its operand or to its negation.
@@ -147,9 +151,10 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
                     // Create NOT.
                     GateId const new_gate_id = encoder->encodeGate(getNewGateName_(new_gate_name_prefix, circuit_size));
                     assert(new_gate_id == circuit_size);
-                    assert(new_gate_id == gate_info.size());
 
-                    gate_info.emplace_back(GateType::NOT, GateIdContainer{operands.at(0)});
+                    [[maybe_unused]] GateId const added_gate_id =
+                        circuit->addGate(GateType::NOT, GateIdContainer{operands.at(0)});
+                    assert(added_gate_id == new_gate_id);
                     result_assignment->assign(new_gate_id, GateState::UNDEFINED);
 
                     // Users of the current gate will refer to the negation of its operand.
@@ -193,11 +198,11 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
             // these gates will be without users and will be removed later by a `RedundantGatesCleaner_` transformer.
             else if (result_assignment->getGateState(gate_id) == GateState::TRUE)
             {
-                gate_info.at(gate_id) = {GateType::CONST_TRUE, {}};
+                circuit->updateGate(gate_id, GateType::CONST_TRUE, {});
             }
             else if (result_assignment->getGateState(gate_id) == GateState::FALSE)
             {
-                gate_info.at(gate_id) = {GateType::CONST_FALSE, {}};
+                circuit->updateGate(gate_id, GateType::CONST_FALSE, {});
             }
             else
             {
@@ -219,7 +224,7 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
             else
             {
                 createMiniCircuit_(
-                    gate_info,
+                    *circuit,
                     *encoder,
                     new_output_gates,
                     new_gate_name_prefix,
@@ -228,11 +233,11 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
             }
         }
 
+        circuit->setOutputGates(std::move(new_output_gates));
+
         logger.debug("END ConstantGateReducer");
 
-        return {
-            std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)),
-            std::make_unique<GateEncoder<std::string>>(*encoder)};
+        return {std::move(circuit), std::move(encoder)};
     };
 
   private:
@@ -255,7 +260,7 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
     /**
      * Create a gadget circuit in a BENCH basis which value is always const. This gadget may be used to
      * replace irreducible CONST_* gates (e.g. when const gate is an output of a circuit).
-     * @param gate_info -- container of the new (transformer-modified) circuit
+     * @param circuit -- circuit to modify
      * @param encoder -- encoder of the new circuit
      * @param new_output_gates -- outputs in the new circuit
      * @param new_gate_name_prefix -- prefix for new gates
@@ -264,7 +269,7 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
      * @return None. All transformations occur by changing the input data parameters
      */
     void createMiniCircuit_(
-        GateInfoContainer& gate_info,
+        CircuitT& circuit,
         GateEncoder<std::string>& encoder,
         GateIdContainer& new_output_gates,
         std::string const& new_gate_name_prefix,
@@ -272,9 +277,9 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
         GateState gate_state)
     {
         GateId gate_id_input = SIZE_MAX;
-        for (GateId gate_id = 0; gate_id < gate_info.size(); ++gate_id)
+        for (GateId gate_id = 0; gate_id < circuit.getNumberOfGates(); ++gate_id)
         {
-            if (gate_info.at(gate_id).getType() == GateType::INPUT)
+            if (circuit.getGateType(gate_id) == GateType::INPUT)
             {
                 gate_id_input = gate_id;
                 break;
@@ -282,8 +287,6 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
         }
         assert(gate_id_input != SIZE_MAX);
 
-        gate_info.reserve(circuit_size + 2);
-
         // We take first found already existing input to enforce connection
         // between original circuit gates and a newly built constant gadget.
         GateId const left   = gate_id_input;
@@ -294,16 +297,16 @@ class ConstantGateReducer_ : public ITransformer<CircuitT>
         circuit_size += 2;
 
         encoder.encodeGate(getNewGateName_(new_gate_name_prefix, right));
-        gate_info.emplace_back(GateType::NOT, GateIdContainer{left});
+        circuit.addGate(GateType::NOT, GateIdContainer{left});
 
         encoder.encodeGate(getNewGateName_(new_gate_name_prefix, output));
         if (gate_state == GateState::TRUE)
         {
-            gate_info.emplace_back(GateType::OR, GateIdContainer{left, right});
+            circuit.addGate(GateType::OR, GateIdContainer{left, right});
         }
         else
         {
-            gate_info.emplace_back(GateType::AND, GateIdContainer{left, right});
+            circuit.addGate(GateType::AND, GateIdContainer{left, right});
         }
 
         // Add recently build output to vector of new output gates.
@@ -1,19 +1,22 @@
 #pragma once
 
 #include <algorithm>
-#include <map>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "src/algo.hpp"
 #include "src/common/csat_types.hpp"
 #include "src/simplification/transformer_base.hpp"
-#include "src/structures/circuit/gate_info.hpp"
-#include "src/structures/circuit/icircuit.hpp"
+#include "src/simplification/utils/structural_hash_table.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
 #include "src/utility/converters.hpp"
 #include "src/utility/encoder.hpp"
+#include "src/utility/levelization.hpp"
 #include "src/utility/logger.hpp"
+#include "src/utility/thread_pool.hpp"
 
 namespace csat::simplification
 {
@@ -26,7 +29,7 @@ namespace csat::simplification
  *
  * @tparam CircuitT
  */
-template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<IMutableCircuit, CircuitT>>>
 class DuplicateGatesCleaner_ : public ITransformer<CircuitT>
 {
     csat::Logger logger{"DuplicateGatesCleaner"};
@@ -34,7 +37,8 @@ class DuplicateGatesCleaner_ : public ITransformer<CircuitT>
   public:
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
     {
         logger.debug("=========================================================================================");
         logger.debug("START DuplicateGatesCleaner");
@@ -43,94 +47,181 @@ class DuplicateGatesCleaner_ : public ITransformer<CircuitT>
         csat::GateIdContainer gateSorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
         std::reverse(gateSorting.begin(), gateSorting.end());
 
-        logger.debug("Building mask to delete gates and filling map -- old_to_new_gateId");
-        // 0 -- if gate is a duplicate, 1 -- otherwise
-        BoolVector safe_mask(circuit->getNumberOfGates(), 1);
-        // maps encoded (`operator_operand1_operand2...`) gate to new gate id
-        GateEncoder<std::string> auxiliary_names_encoder{};
-        // surjection of old gate ids to new gate ids
-        std::map<GateId, GateId> old_to_new_gateId{};
-        // bijection of old gate ids to new gate ids
-        GateEncoder<GateId> new_encoder{};
-        std::string encoded_name;
-
-        for (GateId gateId : gateSorting)
+        logger.debug("Searching for duplicates and filling map -- gate_class");
+        // representatives of gates in order of their new ids
+        GateIdContainer new_order{};
+        // pairs of duplicate gate and its representative
+        std::vector<std::pair<GateId, GateId>> duplicates{};
+        if (context.thread_pool == nullptr)
         {
-            encoded_name = get_gate_auxiliary_name_(
-                gateId, circuit->getGateType(gateId), circuit->getGateOperands(gateId), old_to_new_gateId);
-            logger.debug("Gate number ", gateId, ". Its encoded_name is ", encoded_name);
-
-            if (auxiliary_names_encoder.keyExists(encoded_name))
-            {
-                logger.debug("Gate number ", gateId, " is a Duplicate and will be removed.");
-                safe_mask.at(gateId) = 0;
-            }
-            else
-            {
-                new_encoder.encodeGate(gateId);
-            }
-
-            old_to_new_gateId[gateId] = auxiliary_names_encoder.encodeGate(encoded_name);
+            findDuplicates_(*circuit, gateSorting, new_order, duplicates);
         }
-
-        logger.debug("Building new circuit");
-        GateInfoContainer gate_info(auxiliary_names_encoder.size());
-        for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
+        else
         {
-            if (safe_mask.at(gateId) != 0)
-            {
-                logger.debug(
-                    "New Gate ",
-                    old_to_new_gateId.at(gateId),
-                    "; Type: ",
-                    utils::gateTypeToString(circuit->getGateType(gateId)),
-                    "; Operands: ");
-
-                GateIdContainer masked_operands_{};
-                for (GateId operand : circuit->getGateOperands(gateId))
-                {
-                    masked_operands_.push_back(old_to_new_gateId.at(operand));
-                    logger.debug(old_to_new_gateId.at(operand));
-                }
-                gate_info.at(old_to_new_gateId.at(gateId)) = {circuit->getGateType(gateId), masked_operands_};
-            }
+            findDuplicatesByLevels_(*circuit, gateSorting, *context.thread_pool, new_order, duplicates);
         }
 
-        GateIdContainer new_output_gates{};
-        new_output_gates.reserve(circuit->getOutputGates().size());
-        for (GateId output_gate : circuit->getOutputGates())
+        logger.debug("Removing duplicates");
+        // Representative of each duplicate precedes it in topological order,
+        // so it is never a duplicate itself and is never removed.
+        for (auto const& [duplicate, representative] : duplicates)
         {
-            new_output_gates.push_back(old_to_new_gateId.at(output_gate));
+            circuit->redirectUsers(duplicate, representative);
+            circuit->markDead(duplicate);
         }
 
+        // Gates are renumbered in topological order, even if there are no duplicates.
+        encoder->renumber(circuit->compact(new_order));
+
         logger.debug("END DuplicateGatesCleaner");
         logger.debug("=========================================================================================");
-        return {
-            std::make_unique<CircuitT>(gate_info, new_output_gates), utils::mergeGateEncoders(*encoder, new_encoder)};
+        return {std::move(circuit), std::move(encoder)};
     };
 
   private:
-    std::string get_gate_auxiliary_name_(
-        GateId idx,
-        GateType type,
-        GateIdContainer const& operands,
-        std::map<GateId, GateId> const& encoder)
+    /**
+     * Hash-conses gates in topological order.
+     *
+     * @param gateSorting -- gates in topological order, where operands precede their users.
+     * @param new_order -- resulting representatives of gates in order of their new ids.
+     * @param duplicates -- resulting pairs of duplicate gate and its representative.
+     */
+    void findDuplicates_(
+        CircuitT const& circuit,
+        GateIdContainer const& gateSorting,
+        GateIdContainer& new_order,
+        std::vector<std::pair<GateId, GateId>>& duplicates)
     {
-        std::string encoded_name;
-        encoded_name = std::to_string(static_cast<int>(type));
+        // Gates are hash-consed by their type and classes of their operands.
+        StructuralHashTable structures(circuit.getNumberOfGates());
+        // Maps gate to its class, which is the new id of its representative.
+        GateIdContainer gate_class(circuit.getNumberOfGates(), SIZE_MAX);
+        new_order.reserve(circuit.getNumberOfGates());
+        GateIdContainer operand_classes{};
 
-        if (type == GateType::INPUT)
+        for (GateId gateId : gateSorting)
         {
-            encoded_name += '_' + std::to_string(idx);
-        }
+            GateType const type = circuit.getGateType(gateId);
+            // Inputs are distinct even though they have the same structure.
+            if (type == GateType::INPUT)
+            {
+                gate_class[gateId] = new_order.size();
+                new_order.push_back(gateId);
+                continue;
+            }
+
+            operand_classes.clear();
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                operand_classes.push_back(gate_class[operand]);
+            }
+            if (utils::symmetricOperatorQ(type))
+            {
+                std::sort(operand_classes.begin(), operand_classes.end());
+            }
 
-        for (GateId const operand : operands)
+            GateId const new_class = new_order.size();
+            gate_class[gateId]     = structures.findOrInsert(type, operand_classes, new_class);
+            if (gate_class[gateId] == new_class)
+            {
+                new_order.push_back(gateId);
+            }
+            else
+            {
+                logger.debug("Gate number ", gateId, " is a Duplicate and will be removed.");
+                duplicates.emplace_back(gateId, new_order[gate_class[gateId]]);
+            }
+        }
+    }
+
+    /**
+     * Hash-conses gates level by level. Keys of gates of a level (classes of their operands
+     * and hashes) are computed in parallel, and then are inserted into the table sequentially.
+     * Class of a gate is the old id of its representative, so it doesn't depend on the order
+     * of insertion. Duplicate gates are of the same level, and gates of a level keep their
+     * topological order, so representatives, and thus results, are the same as of
+     * `findDuplicates_`.
+     */
+    void findDuplicatesByLevels_(
+        CircuitT const& circuit,
+        GateIdContainer const& gateSorting,
+        utils::ThreadPool& pool,
+        GateIdContainer& new_order,
+        std::vector<std::pair<GateId, GateId>>& duplicates)
+    {
+        utils::Levelization const levels(
+            gateSorting,
+            circuit.getNumberOfGates(),
+            [&circuit](GateId gateId) { return circuit.getGateOperands(gateId); });
+
+        StructuralHashTable structures(circuit.getNumberOfGates());
+        GateIdContainer representative(circuit.getNumberOfGates(), SIZE_MAX);
+        // Keys of gates of the current level: operands of gate `i` of the level
+        // are `keys[keys_begin[i], keys_begin[i + 1])`.
+        GateIdContainer keys{};
+        std::vector<size_t> keys_begin{};
+        std::vector<uint64_t> hashes{};
+
+        for (size_t level = 0; level < levels.getNumberOfLevels(); ++level)
         {
-            encoded_name += '_' + std::to_string(encoder.at(operand));
+            GateIdSpan const gates = levels.getLevel(level);
+            keys_begin.assign(1, 0);
+            for (GateId const gateId : gates)
+            {
+                keys_begin.push_back(keys_begin.back() + circuit.getGateOperands(gateId).size());
+            }
+            keys.resize(keys_begin.back());
+            hashes.resize(gates.size());
+
+            pool.parallelFor(
+                gates.size(),
+                [&](size_t idx)
+                {
+                    GateType const type       = circuit.getGateType(gates[idx]);
+                    GateId* const key         = keys.data() + keys_begin[idx];
+                    GateIdSpan const operands = circuit.getGateOperands(gates[idx]);
+                    std::transform(
+                        operands.begin(),
+                        operands.end(),
+                        key,
+                        [&representative](GateId operand) { return representative[operand]; });
+                    if (utils::symmetricOperatorQ(type))
+                    {
+                        std::sort(key, key + operands.size());
+                    }
+                    hashes[idx] = StructuralHashTable::hash(type, {key, operands.size()});
+                });
+
+            for (size_t idx = 0; idx < gates.size(); ++idx)
+            {
+                GateId const gateId = gates[idx];
+                GateType const type = circuit.getGateType(gateId);
+                // Inputs are distinct even though they have the same structure.
+                representative[gateId] =
+                    type == GateType::INPUT
+                        ? gateId
+                        : structures.findOrInsert(
+                              type,
+                              {keys.data() + keys_begin[idx], keys_begin[idx + 1] - keys_begin[idx]},
+                              gateId,
+                              hashes[idx]);
+            }
         }
 
-        return encoded_name;
-    };
+        new_order.reserve(circuit.getNumberOfGates());
+        for (GateId const gateId : gateSorting)
+        {
+            if (representative[gateId] == gateId)
+            {
+                new_order.push_back(gateId);
+            }
+            else
+            {
+                logger.debug("Gate number ", gateId, " is a Duplicate and will be removed.");
+                duplicates.emplace_back(gateId, representative[gateId]);
+            }
+        }
+    }
 };
 
 }  // namespace csat::simplification
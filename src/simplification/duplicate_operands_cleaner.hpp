@@ -13,7 +13,7 @@
 #include "src/algo.hpp"
 #include "src/common/csat_types.hpp"
 #include "src/simplification/transformer_base.hpp"
-#include "src/structures/circuit/gate_info.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
 #include "src/utility/converters.hpp"
 #include "src/utility/logger.hpp"
 
@@ -52,20 +52,21 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
      * Applies DuplicateOperandsCleaner_ transformer to `circuit`
      * @param circuit -- circuit to transform.
      * @param encoder -- circuit encoder.
+     * @param context -- context of the simplification run.
      * @return  circuit and encoder after transformation.
      */
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
     {
         logger.debug("START DuplicateOperandsCleaner");
 
-        auto new_gate_name_prefix = (getUniqueId_() + "::new_gate_DuplicateOperandsCleaner@");
+        auto new_gate_name_prefix = (getUniqueId_(context) + "::new_gate_DuplicateOperandsCleaner@");
 
         csat::GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
 
         size_t circuit_size = circuit->getNumberOfGates();
-        GateInfoContainer gate_info(circuit_size);
 
         // Surjection of old gate ids to new gate ids.
         GateIdContainer old_to_new_gateId(circuit_size, SIZE_MAX);
@@ -76,16 +77,18 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
 
         // Prepare auxiliary const TRUE and FALSE gates.
         id_const_true = encoder->encodeGate(getNewGateName_(new_gate_name_prefix, "CONST_TRUE"));
-        gate_info.emplace_back(GateType::CONST_TRUE, GateIdContainer{});
+        circuit->addGate(GateType::CONST_TRUE, GateIdContainer{});
         old_to_new_gateId.push_back(id_const_true);
         ++circuit_size;
 
         id_const_false = encoder->encodeGate(getNewGateName_(new_gate_name_prefix, "CONST_FALSE"));
-        gate_info.emplace_back(GateType::CONST_FALSE, GateIdContainer{});
+        circuit->addGate(GateType::CONST_FALSE, GateIdContainer{});
         old_to_new_gateId.push_back(id_const_false);
         ++circuit_size;
 
-        // Rebuild circuit.
+        // Rebuild circuit. Gates are processed from operands to users, so operands of the current
+        // gate are not modified yet, while all gates it may refer to are already rebuilt.
+        GateIdContainer operands{};
         for (auto gate_id : std::ranges::reverse_view(gate_sorting))
         {
             // First of all, we will determine the correct gate operands by filling `old_to_new_gateId`.
@@ -119,9 +122,10 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
                         // Create NOT.
                         GateId const new_gate_id =
                             encoder->encodeGate(getNewGateName_(new_gate_name_prefix, circuit_size));
-                        gate_info.emplace_back(GateType::NOT, GateIdContainer{unique_operand});
+                        [[maybe_unused]] GateId const added_gate_id =
+                            circuit->addGate(GateType::NOT, GateIdContainer{unique_operand});
                         assert(new_gate_id == circuit_size);
-                        assert(gate_info.size() - 1 == circuit_size);
+                        assert(added_gate_id == circuit_size);
                         ++circuit_size;
 
                         // Users of the current gate will refer to the negation of its operand.
@@ -148,7 +152,7 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
                     // If after counting there are 2+ operands left, try to find the opposite operands.
                     // If gates are found to have opposite operands, then all their users will have to use
                     // constants (CONST_TRUE, CONST_FALSE) as their operands instead of these gates.
-                    bool flag = areThereOppositeOperands_(gate_info, map_count_operands);
+                    bool flag = areThereOppositeOperands_(*circuit, map_count_operands);
                     if (flag && (gate_type == GateType::AND || gate_type == GateType::NOR))
                     {
                         old_to_new_gateId.at(gate_id) = id_const_false;
@@ -180,14 +184,14 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
             // The second step. Let's reassemble the operands, knowing that all the reductions are already
             // taken into account in the map.
 
-            GateIdContainer operands{};
+            operands.clear();
 
             // Rebuild the gate if necessary (only XOR or NXOR).
             if (rebuild_gate)
             {
                 rebuild_gate = false;
 
-                operands = rebuildXORAndNXOR_(gate_info, map_count_operands);
+                operands = rebuildXORAndNXOR_(*circuit, map_count_operands);
 
                 // If all operands had an opposite pair, the gate may end up with one operand.
                 if (operands.size() == 1)
@@ -202,8 +206,10 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
                         // Create NOT.
                         GateId const new_gate_id =
                             encoder->encodeGate(getNewGateName_(new_gate_name_prefix, circuit_size));
+                        [[maybe_unused]] GateId const added_gate_id =
+                            circuit->addGate(GateType::NOT, GateIdContainer{operands.at(0)});
                         assert(new_gate_id == circuit_size);
-                        gate_info.emplace_back(GateType::NOT, GateIdContainer{operands.at(0)});
+                        assert(added_gate_id == circuit_size);
 
                         // Users of the current gate will refer to the negation of its operand.
                         old_to_new_gateId.at(gate_id) = new_gate_id;
@@ -249,8 +255,8 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
                 }
             }
 
-            // Construct the gate.
-            gate_info.at(gate_id) = {gate_type, operands};
+            // Rewrite the gate, if anything has changed.
+            circuit->updateGate(gate_id, gate_type, operands);
         }
 
         // Rebuild OUTPUT.
@@ -261,11 +267,11 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
             new_output_gates.push_back(old_to_new_gateId.at(output_gate));
         }
 
+        circuit->setOutputGates(std::move(new_output_gates));
+
         logger.debug("END DuplicateOperandsCleaner");
 
-        return {
-            std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)),
-            std::make_unique<GateEncoder<std::string>>(*encoder)};
+        return {std::move(circuit), std::move(encoder)};
     };
 
   private:
@@ -345,44 +351,41 @@ class DuplicateOperandsCleaner_ : public ITransformer<CircuitT>
 
     /**
      * Checks if there are opposite operands in the gate
-     * @param gate_info -- container of the new (transformer-modified) circuit
+     * @param circuit -- circuit, in which operands of the gate are already rebuilt
      * @param map_count_operands -- map, where the key is gate's operand and
      *                              the value is how many times this operand appears in the gate
      * @return boolean answer to checks (true or false)
      */
-    bool areThereOppositeOperands_(
-        GateInfoContainer const& gate_info,
-        std::map<GateId, size_t> const& map_count_operands)
+    bool areThereOppositeOperands_(CircuitT const& circuit, std::map<GateId, size_t> const& map_count_operands)
     {
-        // Due to the fact that new gates or new links can be
-        // formed in the new circuit, we must use gate_info,
-        // and not the circuit itself.
+        // All operands of the gate are already rebuilt, so new
+        // gates and new links are taken into account here.
         return std::any_of(
             map_count_operands.begin(),
             map_count_operands.end(),
-            [&gate_info, &map_count_operands](auto const& p)
+            [&circuit, &map_count_operands](auto const& p)
             {
-                return gate_info.at(p.first).getType() == GateType::NOT &&
-                       map_count_operands.find(gate_info.at(p.first).getOperands().at(0)) != map_count_operands.end();
+                return circuit.getGateType(p.first) == GateType::NOT &&
+                       map_count_operands.find(circuit.getGateOperands(p.first).at(0)) != map_count_operands.end();
             });
     }
 
     /**
      * Removes opposite operands from gates of type XOR and NXOR
-     * @param gate_info -- container of the new (transformer-modified) circuit
+     * @param circuit -- circuit, in which operands of the gate are already rebuilt
      * @param map_count_operands -- map, where the key is gate's operand and
      *                              the value is how many times this operand appears in the gate
      * @return operands for gate XOR/NXOR
      */
-    GateIdContainer rebuildXORAndNXOR_(GateInfoContainer const& gate_info, std::map<GateId, size_t>& map_count_operands)
+    GateIdContainer rebuildXORAndNXOR_(CircuitT const& circuit, std::map<GateId, size_t>& map_count_operands)
     {
         // Let's collect a complete list of opposite operands.
         size_t number_of_pair = 0;
         for (auto [operand, _] : map_count_operands)
         {
-            if (gate_info.at(operand).getType() == GateType::NOT && map_count_operands[operand] > 0)
+            if (circuit.getGateType(operand) == GateType::NOT && map_count_operands[operand] > 0)
             {
-                GateId const operand_of_not = gate_info.at(operand).getOperands().at(0);
+                GateId const operand_of_not = circuit.getGateOperands(operand).at(0);
                 if (map_count_operands.find(operand_of_not) != map_count_operands.end() &&
                     map_count_operands[operand_of_not] > 0)
                 {
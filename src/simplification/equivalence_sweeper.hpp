@@ -0,0 +1,360 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/algo.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/simplification/transformer_base.hpp"
+#include "src/simulation/bit_parallel_simulator.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
+#include "src/utility/encoder.hpp"
+#include "src/utility/logger.hpp"
+#include "src/utility/random.hpp"
+
+namespace csat::simplification
+{
+
+/**
+ * Transformer, that merges functionally equivalent and complementary gates.
+ *
+ * Gates are bucketed by signatures -- their values on random input patterns, taken up to
+ * negation. Each gate is compared with earlier representatives of its bucket, and a pair
+ * of gates is merged only if their equivalence (or complementarity) is proven by exhaustive
+ * simulation of their common cone over a cut of at most `MAX_CUT_LEAVES` leaves. Since all
+ * assignments of cut leaves are checked, the check is sound; it may fail to prove actual
+ * equivalence, if values of leaves are dependent.
+ *
+ * Users of a merged gate are redirected to its representative, or to a negation of it
+ * (which is either an existing NOT gate, or a new one). Number of merges and wall time
+ * are accumulated in `SimplificationContext::sweep_stats`.
+ *
+ * Note that this algorithm requires RedundantGatesCleaner to be applied right after,
+ * since operands of merged gates may become unused.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<IMutableCircuit, CircuitT>>>
+class EquivalenceSweeper_ : public ITransformer<CircuitT>
+{
+    csat::Logger logger{"EquivalenceSweeper"};
+
+  public:
+    /* Number of 64-bit words of random patterns, which form a signature of gate. */
+    static constexpr size_t SIGNATURE_WORDS = 4;
+    /* Maximum number of leaves of a cut, over which equivalence is checked. */
+    static constexpr size_t MAX_CUT_LEAVES = 12;
+    /* Maximum number of gates in a cone, which is simulated to check equivalence. */
+    static constexpr size_t MAX_CONE_SIZE = 256;
+    /* Maximum number of representatives, with which equivalence of a gate is checked. */
+    static constexpr size_t MAX_PROOF_ATTEMPTS = 4;
+
+  protected:
+    /* Number of 64-bit words, which carry all assignments of cut leaves. */
+    static constexpr size_t CUT_WORDS = (size_t{1} << MAX_CUT_LEAVES) / 64;
+
+    using Simulator = simulation::BitParallelSimulator<SIGNATURE_WORDS>;
+
+    /* Gate, which is to be replaced by its representative or by negation of it. */
+    struct Merge_
+    {
+        GateId gate;
+        GateId representative;
+        bool complemented;
+    };
+
+    /* Positions of gates in topological order, where operands precede their users. */
+    std::vector<size_t> position_{};
+    /* Index of gate values in `cone_values_` during a check, or `SIZE_MAX`. */
+    std::vector<size_t> local_index_{};
+    /* Values of leaves and cone gates on all assignments of leaves. */
+    std::vector<uint64_t> cone_values_{};
+
+  public:
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
+    {
+        logger.debug("=========================================================================================");
+        logger.debug("START EquivalenceSweeper");
+        auto const time_start = std::chrono::steady_clock::now();
+
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        position_.assign(circuit->getNumberOfGates(), 0);
+        for (size_t position = 0; position < gate_sorting.size(); ++position)
+        {
+            position_[gate_sorting[position]] = position;
+        }
+        local_index_.assign(circuit->getNumberOfGates(), SIZE_MAX);
+
+        logger.debug("Random simulation");
+        Simulator simulator(*circuit, context.thread_pool);
+        // Seed doesn't depend on a thread, so results are reproducible.
+        simulator.simulateRandom(utils::GlobalSeed::get());
+
+        logger.debug("Searching for equivalent gates");
+        // Representatives of gates, bucketed by hash of signature.
+        std::unordered_map<uint64_t, GateIdContainer> representatives{};
+        std::vector<Merge_> merges{};
+        SweepStats& stats = context.sweep_stats;
+        for (GateId const gateId : gate_sorting)
+        {
+            GateIdContainer& bucket = representatives[signatureHash_(simulator.getValues(gateId))];
+            // Inputs are independent, so they are never merged.
+            bool const is_input = circuit->getGateType(gateId) == GateType::INPUT;
+            bool is_candidate   = false;
+            bool is_merged      = false;
+            for (size_t idx = 0; !is_input && idx < std::min(bucket.size(), MAX_PROOF_ATTEMPTS); ++idx)
+            {
+                GateId const representative = bucket[idx];
+                bool const complemented     = simulator.mayBeComplementary(gateId, representative);
+                if (!complemented && !simulator.mayBeEquivalent(gateId, representative))
+                {
+                    continue;
+                }
+                // Replacement of NOT by negation of its (equivalent of) operand gives nothing.
+                if (complemented && circuit->getGateType(gateId) == GateType::NOT)
+                {
+                    continue;
+                }
+                is_candidate = true;
+                if (isEquivalenceProven_(*circuit, gateId, representative, complemented))
+                {
+                    logger.debug(
+                        "Gate ", gateId, " is ", complemented ? "complementary" : "equivalent", " to ", representative);
+                    merges.push_back({gateId, representative, complemented});
+                    is_merged = true;
+                    break;
+                }
+            }
+
+            stats.candidates += is_candidate ? 1 : 0;
+            stats.unproven += (is_candidate && !is_merged) ? 1 : 0;
+            if (!is_merged)
+            {
+                bucket.push_back(gateId);
+            }
+        }
+
+        logger.debug("Merging ", merges.size(), " gates");
+        if (!merges.empty())
+        {
+            mergeGates_(*circuit, *encoder, merges, context);
+            encoder->renumber(circuit->compact());
+        }
+
+        double const duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+        stats.time += duration;
+        logger.debug("Merged ", merges.size(), " gates in ", duration, " sec.");
+        logger.debug("END EquivalenceSweeper");
+        logger.debug("=========================================================================================");
+        return {std::move(circuit), std::move(encoder)};
+    }
+
+  protected:
+    /**
+     * @return hash of signature, which is equal for complementary signatures.
+     */
+    static uint64_t signatureHash_(std::span<uint64_t const, SIGNATURE_WORDS> values)
+    {
+        // Signatures are normalized, so that value on the first pattern is false.
+        uint64_t const phase = (values[0] & 1U) != 0U ? ~uint64_t{0} : 0;
+        uint64_t hash        = 0;
+        for (uint64_t const word : values)
+        {
+            hash = (hash ^ (word ^ phase)) * 0x9E3779B97F4A7C15ULL;
+            hash ^= hash >> 29;
+        }
+        return hash;
+    }
+
+    /**
+     * Checks equivalence of two gates by exhaustive simulation of their common cone.
+     * Cut is built by expanding the latest (in topological order) leaf, so each gate
+     * of the cone is expanded after all its users in the cone.
+     *
+     * @return true iff gates are proven to be equivalent, or complementary if `complemented` is set.
+     */
+    bool isEquivalenceProven_(CircuitT const& circuit, GateId first, GateId second, bool complemented)
+    {
+        GateIdContainer frontier{first, second};
+        GateIdContainer leaves{};
+        GateIdContainer cone{};
+        local_index_[first]  = 0;
+        local_index_[second] = 0;
+
+        while (!frontier.empty())
+        {
+            auto const latest = std::max_element(
+                frontier.begin(),
+                frontier.end(),
+                [this](GateId lhs, GateId rhs) { return position_[lhs] < position_[rhs]; });
+            GateId const gateId = *latest;
+            *latest             = frontier.back();
+            frontier.pop_back();
+
+            size_t new_leaves = 0;
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                new_leaves += local_index_[operand] == SIZE_MAX ? 1 : 0;
+            }
+            // Repeated operands are counted several times, which only makes the bound stricter.
+            if (circuit.getGateType(gateId) == GateType::INPUT || cone.size() >= MAX_CONE_SIZE ||
+                frontier.size() + leaves.size() + new_leaves > MAX_CUT_LEAVES)
+            {
+                leaves.push_back(gateId);
+                continue;
+            }
+            cone.push_back(gateId);
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                if (local_index_[operand] == SIZE_MAX)
+                {
+                    local_index_[operand] = 0;
+                    frontier.push_back(operand);
+                }
+            }
+        }
+
+        // Leaves take all assignments, then cone is evaluated from operands to users.
+        cone_values_.resize((leaves.size() + cone.size()) * CUT_WORDS);
+        for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+        {
+            local_index_[leaves[leaf]] = leaf;
+            fillProjection_(leaf, cone_values_.data() + leaf * CUT_WORDS);
+        }
+        for (size_t idx = 0; idx < cone.size(); ++idx)
+        {
+            GateId const gateId  = cone[cone.size() - 1 - idx];
+            size_t const local   = leaves.size() + idx;
+            local_index_[gateId] = local;
+            simulation::simulateGate<CUT_WORDS>(
+                circuit.getGateType(gateId),
+                circuit.getGateOperands(gateId),
+                [this](GateId operand) { return cone_values_.data() + local_index_[operand] * CUT_WORDS; },
+                cone_values_.data() + local * CUT_WORDS);
+        }
+
+        uint64_t const* first_values  = cone_values_.data() + local_index_[first] * CUT_WORDS;
+        uint64_t const* second_values = cone_values_.data() + local_index_[second] * CUT_WORDS;
+        uint64_t const phase          = complemented ? ~uint64_t{0} : 0;
+        bool proven                   = true;
+        for (size_t word = 0; word < CUT_WORDS && proven; ++word)
+        {
+            proven = first_values[word] == (second_values[word] ^ phase);
+        }
+
+        for (GateId const gateId : leaves)
+        {
+            local_index_[gateId] = SIZE_MAX;
+        }
+        for (GateId const gateId : cone)
+        {
+            local_index_[gateId] = SIZE_MAX;
+        }
+        return proven;
+    }
+
+    /**
+     * Fills values of `leaf`-th leaf on all assignments of leaves: assignment `j` sets leaf to bit `leaf` of `j`.
+     */
+    static void fillProjection_(size_t leaf, uint64_t* values)
+    {
+        static constexpr std::array<uint64_t, 6> word_projections{
+            0xAAAAAAAAAAAAAAAAULL,
+            0xCCCCCCCCCCCCCCCCULL,
+            0xF0F0F0F0F0F0F0F0ULL,
+            0xFF00FF00FF00FF00ULL,
+            0xFFFF0000FFFF0000ULL,
+            0xFFFFFFFF00000000ULL};
+        for (size_t word = 0; word < CUT_WORDS; ++word)
+        {
+            if (leaf < word_projections.size())
+            {
+                values[word] = word_projections[leaf];
+            }
+            else
+            {
+                values[word] = ((word >> (leaf - word_projections.size())) & 1U) != 0U ? ~uint64_t{0} : 0;
+            }
+        }
+    }
+
+    /**
+     * Redirects users of merged gates to their representatives or to negations of them, and marks merged gates dead.
+     */
+    void mergeGates_(
+        CircuitT& circuit,
+        GateEncoder<std::string>& encoder,
+        std::vector<Merge_> const& merges,
+        SimplificationContext& context)
+    {
+        SweepStats& stats               = context.sweep_stats;
+        auto const new_gate_name_prefix = (getUniqueId_(context) + "::new_gate_EquivalenceSweeper@");
+        // Maps representative to its negation.
+        std::unordered_map<GateId, GateId> negations{};
+
+        for (auto const& [gateId, representative, complemented] : merges)
+        {
+            GateId target = representative;
+            if (complemented)
+            {
+                auto const negation = negations.find(representative);
+                if (negation != negations.end() && !circuit.isDead(negation->second))
+                {
+                    target = negation->second;
+                }
+                else
+                {
+                    target = getNegation_(circuit, encoder, representative, new_gate_name_prefix);
+                    negations[representative] = target;
+                }
+                ++stats.complementary_merges;
+            }
+            else
+            {
+                ++stats.equivalent_merges;
+            }
+
+            circuit.redirectUsers(gateId, target);
+            circuit.markDead(gateId);
+        }
+    }
+
+    /**
+     * @return alive NOT gate, whose operand is `gateId`, which is created if there is no such gate.
+     */
+    static GateId getNegation_(
+        CircuitT& circuit,
+        GateEncoder<std::string>& encoder,
+        GateId gateId,
+        std::string const& new_gate_name_prefix)
+    {
+        for (GateId const user : circuit.getGateUsers(gateId))
+        {
+            if (circuit.getGateType(user) == GateType::NOT && !circuit.isDead(user))
+            {
+                return user;
+            }
+        }
+        GateId const new_gate_id =
+            encoder.encodeGate(getNewGateName_(new_gate_name_prefix, circuit.getNumberOfGates()));
+        [[maybe_unused]] GateId const added_gate_id = circuit.addGate(GateType::NOT, GateIdContainer{gateId});
+        assert(new_gate_id == added_gate_id);
+        return new_gate_id;
+    }
+};
+
+}  // namespace csat::simplification
@@ -42,18 +42,26 @@ struct Nest : public ITransformer<CircuitT>
      *         )
      *     );
      * @param circuit -- circuit to transform.
+     * @param context -- context of the simplification run, shared by all transformers.
      * @return circuit, that is result of transformation.
      */
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
     {
         std::unique_ptr<CircuitT> circuit_                 = std::move(circuit);
         std::unique_ptr<GateEncoder<std::string>> encoder_ = std::move(encoder);
         for (std::size_t it = 0; it < n; ++it)
         {
             auto comp                    = Composition<CircuitT, OtherTransformersT...>();
-            std::tie(circuit_, encoder_) = comp.transform(std::move(circuit_), std::move(encoder_));
+            std::tie(circuit_, encoder_) = profilePass_(
+                std::move(circuit_),
+                std::move(encoder_),
+                context,
+                [it]() { return "Nest iteration " + std::to_string(it); },
+                [&](auto circuit, auto encoder)
+                { return comp.transform(std::move(circuit), std::move(encoder), context); });
         }
         return CircuitAndEncoder<CircuitT, std::string>(std::move(circuit_), std::move(encoder_));
     }
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace csat::simplification
+{
+
+/**
+ * Measurements of a single application of a transformer (pass).
+ */
+struct PassRecord
+{
+    /* Name of transformer. */
+    std::string name{};
+    /* Number of enclosing passes, e.g. transformers of a composition are one level deeper than it. */
+    std::size_t depth = 0;
+    /* Start time in seconds since the start of the process profiling. */
+    double start = 0;
+    /* Wall time of the pass in seconds. */
+    double duration = 0;
+    /* Growth of peak resident set size of the process during the pass in kilobytes. */
+    std::int64_t peak_rss_delta_kb = 0;
+    /* Number of gates of circuit before the pass. */
+    std::size_t gates_before = 0;
+    /* Number of gates of circuit after the pass. */
+    std::size_t gates_after = 0;
+};
+
+/**
+ * Profile of all passes, applied to a single circuit.
+ */
+struct CircuitProfile
+{
+    /* Name of circuit, e.g. path to its file. */
+    std::string circuit{};
+    /* Passes in order of their start, so each pass precedes passes nested into it. */
+    std::vector<PassRecord> passes{};
+};
+
+/**
+ * @return time point, from which starts of all passes of the process are measured, so
+ *         passes of concurrently simplified circuits are placed on a common timeline.
+ */
+inline std::chrono::steady_clock::time_point getProfilingEpoch_()
+{
+    static std::chrono::steady_clock::time_point const epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+/**
+ * @return seconds passed since the profiling epoch.
+ */
+inline double getProfilingTime_()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - getProfilingEpoch_()).count();
+}
+
+/**
+ * @return peak resident set size of the process in kilobytes. Note that it is shared
+ *         by all threads and never decreases, so if circuits are simplified concurrently,
+ *         growth is charged to whichever pass happens to raise the peak. Writers below
+ *         omit it in this case.
+ */
+inline std::int64_t getPeakRssKb_()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<std::int64_t>(usage.ru_maxrss);
+}
+
+/**
+ * @return human readable name of transformer type, without namespaces and template arguments.
+ */
+template<class TransformerT>
+std::string getTransformerName_()
+{
+    std::string name = typeid(TransformerT).name();
+#if defined(__GNUG__)
+    int status = 0;
+    std::unique_ptr<char, void (*)(void*)> const demangled(
+        abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status), std::free);
+    if (status == 0)
+    {
+        name = demangled.get();
+    }
+#endif
+    name = name.substr(0, name.find('<'));
+    return name.substr(name.rfind(':') == std::string::npos ? 0 : name.rfind(':') + 1);
+}
+
+/**
+ * Collects measurements of passes, applied to a circuit during one simplification run.
+ * Passes are recorded by transformer compositions only if the project is built with
+ * `ENABLE_PASS_PROFILING`, otherwise recording hooks are compiled out, and profile is empty.
+ */
+class PassProfile
+{
+    std::vector<PassRecord> passes_{};
+    /* Number of passes, which are started, but not finished yet. */
+    std::size_t depth_ = 0;
+
+  public:
+    /**
+     * Starts recording of a pass.
+     * @return index of the pass, which is to be passed to `endPass`.
+     */
+    std::size_t beginPass(std::string name, std::size_t gates_before)
+    {
+        PassRecord record{};
+        record.name              = std::move(name);
+        record.depth             = depth_++;
+        record.start             = getProfilingTime_();
+        record.peak_rss_delta_kb = getPeakRssKb_();
+        record.gates_before      = gates_before;
+        passes_.push_back(std::move(record));
+        return passes_.size() - 1;
+    }
+
+    /**
+     * Finishes recording of a pass, started by `beginPass`.
+     */
+    void endPass(std::size_t pass, std::size_t gates_after)
+    {
+        PassRecord& record       = passes_.at(pass);
+        record.duration          = getProfilingTime_() - record.start;
+        record.peak_rss_delta_kb = getPeakRssKb_() - record.peak_rss_delta_kb;
+        record.gates_after       = gates_after;
+        --depth_;
+    }
+
+    [[nodiscard]]
+    std::vector<PassRecord> const& getPasses() const
+    {
+        return passes_;
+    }
+
+    void clear()
+    {
+        passes_.clear();
+        depth_ = 0;
+    }
+};
+
+inline void writeJsonString_(std::ostream& stream, std::string_view text)
+{
+    stream << '"';
+    for (char const symbol : text)
+    {
+        if (symbol == '"' || symbol == '\\')
+        {
+            stream << '\\' << symbol;
+        }
+        else if (static_cast<unsigned char>(symbol) < 0x20)
+        {
+            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(symbol) << std::dec
+                   << std::setfill(' ');
+        }
+        else
+        {
+            stream << symbol;
+        }
+    }
+    stream << '"';
+}
+
+/**
+ * Writes `text` as quoted CSV field, doubling embedded quotes (RFC 4180), so that paths
+ * containing commas, quotes or line breaks don't break the table.
+ */
+inline void writeCsvString_(std::ostream& stream, std::string_view text)
+{
+    stream << '"';
+    for (char const symbol : text)
+    {
+        if (symbol == '"')
+        {
+            stream << '"';
+        }
+        stream << symbol;
+    }
+    stream << '"';
+}
+
+/**
+ * Writes profiles as JSON array of objects `{"circuit": ..., "passes": [...]}`.
+ * @param with_peak_rss -- whether peak RSS deltas are written, which is meaningful only
+ *        if circuits were simplified one by one.
+ */
+inline void writePassProfileJson(
+    std::ostream& stream,
+    std::span<CircuitProfile const> profiles,
+    bool with_peak_rss = true)
+{
+    stream << std::setprecision(9) << "[";
+    for (std::size_t circuit = 0; circuit < profiles.size(); ++circuit)
+    {
+        stream << (circuit == 0 ? "\n" : ",\n") << "  {\"circuit\": ";
+        writeJsonString_(stream, profiles[circuit].circuit);
+        stream << ", \"passes\": [";
+        std::vector<PassRecord> const& passes = profiles[circuit].passes;
+        for (std::size_t pass = 0; pass < passes.size(); ++pass)
+        {
+            stream << (pass == 0 ? "\n" : ",\n") << "    {\"name\": ";
+            writeJsonString_(stream, passes[pass].name);
+            stream << ", \"depth\": " << passes[pass].depth << ", \"start\": " << passes[pass].start
+                   << ", \"duration\": " << passes[pass].duration;
+            if (with_peak_rss)
+            {
+                stream << ", \"peak_rss_delta_kb\": " << passes[pass].peak_rss_delta_kb;
+            }
+            stream << ", \"gates_before\": " << passes[pass].gates_before
+                   << ", \"gates_after\": " << passes[pass].gates_after << "}";
+        }
+        stream << (passes.empty() ? "]}" : "\n  ]}");
+    }
+    stream << (profiles.empty() ? "]\n" : "\n]\n");
+}
+
+/**
+ * Writes profiles as CSV table with a row per pass.
+ * @param with_peak_rss -- whether peak RSS delta column is written, which is meaningful only
+ *        if circuits were simplified one by one.
+ */
+inline void writePassProfileCsv(
+    std::ostream& stream,
+    std::span<CircuitProfile const> profiles,
+    bool with_peak_rss = true)
+{
+    stream << std::setprecision(9);
+    stream << "Circuit,Pass,Depth,Start,Duration," << (with_peak_rss ? "Peak RSS delta KB," : "")
+           << "Gates before,Gates after\n";
+    for (CircuitProfile const& profile : profiles)
+    {
+        for (PassRecord const& pass : profile.passes)
+        {
+            writeCsvString_(stream, profile.circuit);
+            stream << ",";
+            writeCsvString_(stream, pass.name);
+            stream << "," << pass.depth << "," << pass.start << "," << pass.duration << ",";
+            if (with_peak_rss)
+            {
+                stream << pass.peak_rss_delta_kb << ",";
+            }
+            stream << pass.gates_before << "," << pass.gates_after << "\n";
+        }
+    }
+}
+
+/**
+ * Writes profiles in Chrome trace event format, which is opened by `chrome://tracing`
+ * or Perfetto. Each circuit is shown as a separate thread, named by the circuit.
+ * @param with_peak_rss -- whether peak RSS deltas are written, which is meaningful only
+ *        if circuits were simplified one by one.
+ */
+inline void writeChromeTrace(
+    std::ostream& stream,
+    std::span<CircuitProfile const> profiles,
+    bool with_peak_rss = true)
+{
+    stream << std::fixed << std::setprecision(3) << "{\"traceEvents\": [";
+    bool first = true;
+    for (std::size_t circuit = 0; circuit < profiles.size(); ++circuit)
+    {
+        stream << (first ? "\n" : ",\n") << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+               << circuit << ", \"args\": {\"name\": ";
+        writeJsonString_(stream, profiles[circuit].circuit);
+        stream << "}}";
+        first = false;
+
+        for (PassRecord const& pass : profiles[circuit].passes)
+        {
+            // Timestamps of trace events are in microseconds.
+            stream << ",\n  {\"name\": ";
+            writeJsonString_(stream, pass.name);
+            stream << ", \"cat\": \"pass\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << circuit
+                   << ", \"ts\": " << pass.start * 1e6 << ", \"dur\": " << pass.duration * 1e6
+                   << ", \"args\": {\"gates_before\": " << pass.gates_before
+                   << ", \"gates_after\": " << pass.gates_after;
+            if (with_peak_rss)
+            {
+                stream << ", \"peak_rss_delta_kb\": " << pass.peak_rss_delta_kb;
+            }
+            stream << "}}";
+        }
+    }
+    stream << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+}  // namespace csat::simplification
@@ -8,8 +8,7 @@
 #include "src/algo.hpp"
 #include "src/common/csat_types.hpp"
 #include "src/simplification/transformer_base.hpp"
-#include "src/structures/circuit/gate_info.hpp"
-#include "src/structures/circuit/icircuit.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
 #include "src/utility/logger.hpp"
 
 namespace csat::simplification
@@ -23,7 +22,7 @@ namespace csat::simplification
  *
  * @tparam CircuitT
  */
-template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<IMutableCircuit, CircuitT>>>
 class ReduceNotComposition_ : public ITransformer<CircuitT>
 {
   private:
@@ -35,11 +34,13 @@ class ReduceNotComposition_ : public ITransformer<CircuitT>
      * Applies ReduceNotComposition_ transformer to `circuit`
      * @param circuit -- circuit to transform.
      * @param encoder -- circuit encoder.
+     * @param context -- context of the simplification run.
      * @return  circuit and encoder after transformation.
      */
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& /*context*/)
     {
         logger.debug("=========================================================================================");
         logger.debug("START ReduceNotComposition");
@@ -47,33 +48,38 @@ class ReduceNotComposition_ : public ITransformer<CircuitT>
         logger.debug("Top sort");
         csat::GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
 
-        logger.debug("Rebuild schema");
-        GateInfoContainer gate_info(circuit->getNumberOfGates());
-
+        logger.debug("Rewire operands");
+        // Gates are processed from users to operands, so operands of all gates,
+        // reachable from the current one, are not modified yet.
+        GateIdContainer new_operands_{};
         for (GateId gateId : gate_sorting)
         {
-            GateIdContainer new_operands_{};
+            bool modified = false;
+            new_operands_.clear();
             for (GateId operands : circuit->getGateOperands(gateId))
             {
                 // if the current operand is NOT, then we look at its operand and, if possible, reduce the number of NOT
                 if (circuit->getGateType(operands) == GateType::NOT)
                 {
                     new_operands_.push_back(get_operand(*circuit, operands));
+                    modified = modified || (new_operands_.back() != operands);
                 }
                 else
                 {
                     new_operands_.push_back(operands);
                 }
             }
-            gate_info.at(gateId) = {circuit->getGateType(gateId), new_operands_};
+
+            if (modified)
+            {
+                circuit->setGate(gateId, circuit->getGateType(gateId), new_operands_);
+            }
         }
 
         logger.debug("END ReduceNotComposition");
         logger.debug("=========================================================================================");
 
-        return {
-            std::make_unique<CircuitT>(gate_info, circuit->getOutputGates()),
-            std::make_unique<GateEncoder<std::string>>(*encoder)};
+        return {std::move(circuit), std::move(encoder)};
     };
 
   private:
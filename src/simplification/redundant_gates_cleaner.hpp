@@ -1,6 +1,5 @@
 #pragma once
 
-#include <cassert>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -8,8 +7,7 @@
 #include "src/algo.hpp"
 #include "src/common/csat_types.hpp"
 #include "src/simplification/transformer_base.hpp"
-#include "src/structures/circuit/gate_info.hpp"
-#include "src/structures/circuit/icircuit.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
 #include "src/utility/encoder.hpp"
 #include "src/utility/logger.hpp"
 
@@ -26,7 +24,7 @@ namespace csat::simplification
 template<
     class CircuitT,
     bool preserveInputs = false,
-    typename            = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+    typename            = std::enable_if_t<std::is_base_of_v<IMutableCircuit, CircuitT>>>
 class RedundantGatesCleaner_ : public ITransformer<CircuitT>
 {
     csat::Logger logger{"RedundantGatesCleaner"};
@@ -36,65 +34,42 @@ class RedundantGatesCleaner_ : public ITransformer<CircuitT>
      * Applies RedundantGatesCleaner_ transformer to `circuit`
      * @param circuit -- circuit to transform.
      * @param encoder -- circuit encoder.
+     * @param context -- context of the simplification run.
      * @return  circuit and encoder after transformation.
      */
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& /*context*/)
     {
         logger.debug("=========================================================================================");
         logger.debug("START RedundantGatesCleaner.");
 
-        GateEncoder<GateId> encoder_old_to_new{};
         // Use dfs to get markers of visited and unvisited gates
         auto mask_use_output = algo::performDepthFirstSearch(*circuit, circuit->getOutputGates());
 
-        // first step: getting valid encoding
         for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
         {
             if (mask_use_output.at(gateId) != algo::DFSState::UNVISITED ||
                 (preserveInputs && circuit->getGateType(gateId) == GateType::INPUT))
             {
-                encoder_old_to_new.encodeGate(gateId);
                 continue;
             }
 
             logger.debug("Gate number ", gateId, " is redundant and will be removed");
+            circuit->markDead(gateId);
         }
 
-        // Rebuid circuit
-        GateInfoContainer gate_info(encoder_old_to_new.size());
-        for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
-        {
-            if (encoder_old_to_new.keyExists(gateId))
-            {
-                GateIdContainer encoded_operands_{};
-                for (GateId operand : circuit->getGateOperands(gateId))
-                {
-                    assert(
-                        mask_use_output.at(gateId) != algo::DFSState::UNVISITED ||
-                        (preserveInputs && circuit->getGateType(gateId) == GateType::INPUT));
-
-                    encoded_operands_.push_back(encoder_old_to_new.encodeGate(operand));
-                }
-                gate_info.at(encoder_old_to_new.encodeGate(gateId)) = {
-                    circuit->getGateType(gateId), std::move(encoded_operands_)};
-            }
-        }
-
-        // All outputs must be visited since DFS starts from them.
-        GateIdContainer new_output_gates{};
-        new_output_gates.reserve(circuit->getOutputGates().size());
-        for (GateId output_gate : circuit->getOutputGates())
+        // All users of redundant gates are redundant as well, and all outputs
+        // are visited since DFS starts from them, so the circuit stays consistent.
+        if (circuit->hasDeadGates())
         {
-            new_output_gates.push_back(encoder_old_to_new.encodeGate(output_gate));
+            encoder->renumber(circuit->compact());
         }
 
         logger.debug("END RedundantGatesCleaner.");
         logger.debug("=========================================================================================");
-        return {
-            std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)),
-            utils::mergeGateEncoders(*encoder, encoder_old_to_new)};
+        return {std::move(circuit), std::move(encoder)};
     };
 };
 
@@ -0,0 +1,384 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "src/simplification/transformer_base.hpp"
+#include "src/simplification/transformer_registry.hpp"
+#include "src/structures/circuit/icircuit.hpp"
+#include "src/utility/logger.hpp"
+
+namespace csat::simplification
+{
+
+/**
+ * Budgets of a `repeat` statement of simplification script. Iteration is started
+ * only if all budgets are satisfied, so a running iteration is never interrupted.
+ */
+struct RepeatOptions
+{
+    /* Maximum number of iterations. */
+    std::size_t max_iterations = SIZE_MAX;
+    /* Whether repetition stops after an iteration, which didn't decrease number of gates. */
+    bool until_fixpoint = false;
+    /* Time in seconds, after which no new iteration is started. */
+    double time_limit = std::numeric_limits<double>::infinity();
+    /* Number of gates, above which no new iteration is started. */
+    std::size_t max_gates = SIZE_MAX;
+};
+
+/**
+ * Statement of simplification script: either application of a registered transformer,
+ * or repetition of a nested sequence of statements.
+ */
+struct ScriptStatement
+{
+    /* Name of transformer, empty for `repeat` statement. */
+    std::string transformer{};
+    /* Budgets of `repeat` statement. */
+    RepeatOptions repeat{};
+    /* Repeated statements. */
+    std::vector<ScriptStatement> body{};
+};
+
+/**
+ * Runtime counterpart of `Composition`: applies transformers in left-to-right order.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+class Sequence_ : public ITransformer<CircuitT>
+{
+    std::vector<std::unique_ptr<ITransformer<CircuitT>>> transformers_;
+    /* Names of transformers, under which they are recorded to pass profile. */
+    std::vector<std::string> names_;
+
+  public:
+    Sequence_(std::vector<std::unique_ptr<ITransformer<CircuitT>>> transformers, std::vector<std::string> names)
+        : transformers_(std::move(transformers))
+        , names_(std::move(names))
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context) override
+    {
+        for (std::size_t idx = 0; idx < transformers_.size(); ++idx)
+        {
+            std::tie(circuit, encoder) = profilePass_(
+                std::move(circuit),
+                std::move(encoder),
+                context,
+                [this, idx]() { return names_[idx]; },
+                [&](auto circuit_, auto encoder_)
+                { return transformers_[idx]->transform(std::move(circuit_), std::move(encoder_), context); });
+        }
+        return {std::move(circuit), std::move(encoder)};
+    }
+};
+
+/**
+ * Runtime counterpart of `Nest`: applies transformer repeatedly, while budgets allow.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+class Repeat_ : public ITransformer<CircuitT>
+{
+    csat::Logger logger{"Repeat"};
+
+    std::unique_ptr<ITransformer<CircuitT>> body_;
+    RepeatOptions options_;
+
+  public:
+    Repeat_(std::unique_ptr<ITransformer<CircuitT>> body, RepeatOptions options)
+        : body_(std::move(body))
+        , options_(options)
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context) override
+    {
+        auto const time_start = std::chrono::steady_clock::now();
+        for (std::size_t iteration = 0; iteration < options_.max_iterations; ++iteration)
+        {
+            double const elapsed =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+            if (elapsed >= options_.time_limit || circuit->getNumberOfGates() > options_.max_gates)
+            {
+                logger.debug("Budget is exhausted after ", iteration, " iterations.");
+                break;
+            }
+
+            std::size_t const gates_before = circuit->getNumberOfGates();
+            std::tie(circuit, encoder)     = profilePass_(
+                std::move(circuit),
+                std::move(encoder),
+                context,
+                [iteration]() { return "repeat iteration " + std::to_string(iteration); },
+                [&](auto circuit_, auto encoder_)
+                { return body_->transform(std::move(circuit_), std::move(encoder_), context); });
+            if (options_.until_fixpoint && circuit->getNumberOfGates() >= gates_before)
+            {
+                logger.debug("Fixpoint is reached after ", iteration + 1, " iterations.");
+                break;
+            }
+        }
+        return {std::move(circuit), std::move(encoder)};
+    }
+};
+
+/**
+ * Parser of simplification scripts, which describe pipelines of transformers at runtime:
+ *
+ *     script    := statement (';' statement)*
+ *     statement := NAME | 'repeat' '(' option (',' option)* ')' '{' script '}'
+ *     option    := COUNT | 'until_fixpoint' | 'max' '=' COUNT | 'time' '=' SECONDS | 'gates' '=' COUNT
+ *
+ * where NAME is a name of transformer in a registry. For example, script
+ *
+ *     dup_ops; repeat(until_fixpoint, max=20, time=60){dup_ops; 3in_min}; dup_ops
+ *
+ * cleans circuit, then minimizes it until number of gates stops decreasing, but
+ * at most 20 times and starting no iteration after a minute, and cleans it again.
+ * Option `gates=N` forbids iterations on circuits with more than N gates. Empty
+ * statements are allowed, so a trailing `;` is not an error.
+ */
+class ScriptParser
+{
+    std::string text_;
+    std::size_t position_ = 0;
+
+  public:
+    explicit ScriptParser(std::string text)
+        : text_(std::move(text))
+    {
+    }
+
+    /**
+     * @return statements of the script. Aborts on malformed script.
+     */
+    std::vector<ScriptStatement> parse()
+    {
+        position_                               = 0;
+        std::vector<ScriptStatement> statements = parseSequence_();
+        if (!peek_().empty())
+        {
+            fail_("unexpected \"" + peek_() + "\"");
+        }
+        return statements;
+    }
+
+  private:
+    static bool isWordChar_(char symbol)
+    {
+        return std::isalnum(static_cast<unsigned char>(symbol)) != 0 || symbol == '_' || symbol == '.';
+    }
+
+    /**
+     * @return next token without consuming it, or empty string at the end of script.
+     */
+    std::string peek_()
+    {
+        while (position_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[position_])) != 0)
+        {
+            ++position_;
+        }
+        if (position_ == text_.size())
+        {
+            return "";
+        }
+        std::size_t end = position_;
+        while (end < text_.size() && isWordChar_(text_[end]))
+        {
+            ++end;
+        }
+        return text_.substr(position_, std::max(end, position_ + 1) - position_);
+    }
+
+    std::string next_()
+    {
+        std::string token = peek_();
+        position_ += token.size();
+        return token;
+    }
+
+    void expect_(std::string const& expected)
+    {
+        if (std::string const token = next_(); token != expected)
+        {
+            position_ -= token.size();
+            fail_("expected \"" + expected + "\", but got \"" + token + "\"");
+        }
+    }
+
+    [[noreturn]]
+    void fail_(std::string const& message) const
+    {
+        std::cerr << "Incorrect simplification script \"" << text_ << "\" at position " << position_ << ": "
+                  << message << "." << std::endl;
+        std::abort();
+    }
+
+    std::vector<ScriptStatement> parseSequence_()
+    {
+        std::vector<ScriptStatement> statements{};
+        while (true)
+        {
+            std::string const token = peek_();
+            if (token == "repeat")
+            {
+                statements.push_back(parseRepeat_());
+            }
+            else if (!token.empty() && isWordChar_(token.front()))
+            {
+                statements.push_back({next_(), {}, {}});
+            }
+            if (peek_() != ";")
+            {
+                return statements;
+            }
+            next_();
+        }
+    }
+
+    ScriptStatement parseRepeat_()
+    {
+        expect_("repeat");
+        ScriptStatement statement{};
+        bool bounded = false;
+        expect_("(");
+        while (true)
+        {
+            std::string const option = next_();
+            if (option == "until_fixpoint")
+            {
+                statement.repeat.until_fixpoint = true;
+            }
+            else if (option == "max" || option == "gates" || option == "time")
+            {
+                expect_("=");
+                if (option == "max")
+                {
+                    statement.repeat.max_iterations = parseCount_();
+                }
+                else if (option == "gates")
+                {
+                    statement.repeat.max_gates = parseCount_();
+                }
+                else
+                {
+                    statement.repeat.time_limit = parseSeconds_();
+                }
+            }
+            else
+            {
+                position_ -= option.size();
+                statement.repeat.max_iterations = parseCount_();
+            }
+            bounded = bounded || option != "gates";
+            if (peek_() != ",")
+            {
+                break;
+            }
+            next_();
+        }
+        expect_(")");
+        if (!bounded)
+        {
+            fail_("repeat requires a number of iterations, `until_fixpoint`, `max` or `time`");
+        }
+
+        expect_("{");
+        statement.body = parseSequence_();
+        expect_("}");
+        return statement;
+    }
+
+    std::size_t parseCount_()
+    {
+        std::string const token = next_();
+        std::size_t count       = 0;
+        auto const [end, error] = std::from_chars(token.data(), token.data() + token.size(), count);
+        if (error != std::errc{} || end != token.data() + token.size())
+        {
+            position_ -= token.size();
+            fail_("expected a number, but got \"" + token + "\"");
+        }
+        return count;
+    }
+
+    double parseSeconds_()
+    {
+        std::string const token = next_();
+        char* end               = nullptr;
+        double const seconds    = std::strtod(token.c_str(), &end);
+        if (token.empty() || end != token.c_str() + token.size() || seconds < 0)
+        {
+            position_ -= token.size();
+            fail_("expected a number of seconds, but got \"" + token + "\"");
+        }
+        return seconds;
+    }
+};
+
+/**
+ * Builds a transformer, which applies script statements in order.
+ * Aborts if script refers to a transformer, which is not in the registry.
+ *
+ * @param statements -- parsed script.
+ * @param registry -- registry of transformers.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+std::unique_ptr<ITransformer<CircuitT>> buildScript(
+    std::vector<ScriptStatement> const& statements,
+    TransformerRegistry<CircuitT> const& registry)
+{
+    std::vector<std::unique_ptr<ITransformer<CircuitT>>> transformers{};
+    std::vector<std::string> names{};
+    transformers.reserve(statements.size());
+    for (ScriptStatement const& statement : statements)
+    {
+        if (statement.transformer.empty())
+        {
+            transformers.push_back(std::make_unique<Repeat_<CircuitT>>(
+                buildScript<CircuitT>(statement.body, registry), statement.repeat));
+            names.emplace_back("repeat");
+        }
+        else
+        {
+            transformers.push_back(registry.create(statement.transformer));
+            names.push_back(statement.transformer);
+        }
+    }
+    return std::make_unique<Sequence_<CircuitT>>(std::move(transformers), std::move(names));
+}
+
+/**
+ * Parses script and builds a transformer from it. Transformers may carry state of a single run,
+ * so a new pipeline should be built for each concurrently simplified circuit.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+std::unique_ptr<ITransformer<CircuitT>> buildScript(
+    std::string const& script,
+    TransformerRegistry<CircuitT> const& registry)
+{
+    return buildScript<CircuitT>(ScriptParser(script).parse(), registry);
+}
+
+}  // namespace csat::simplification
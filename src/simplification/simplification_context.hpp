@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "src/simplification/pass_profile.hpp"
+#include "src/utility/random.hpp"
+#include "src/utility/thread_pool.hpp"
+
+namespace csat::simplification
+{
+
+/**
+ * Statistics of a single iteration of three inputs subcircuits minimization.
+ */
+struct IterationStats
+{
+    /* Number of gates in a circuit before iteration. */
+    std::size_t circuit_size = 0;
+    /* Number of observed three inputs subcircuits. */
+    std::size_t subcircuits_number = 0;
+    /* Number of subcircuits skipped since their inputs were already removed. */
+    std::size_t skipped_subcircuits = 0;
+    /* Maximum size of observed subcircuit (including its inputs). */
+    std::size_t max_subcircuit_size = 0;
+    /* Total number of gates in observed subcircuits (including their inputs). */
+    std::size_t total_gates_in_subcircuits = 0;
+    /* Number of subcircuits replaced by smaller ones from database. */
+    std::size_t reduced_subcircuits = 0;
+    /* Number of gates modified by iteration. */
+    std::size_t simplified_gates = 0;
+};
+
+/**
+ * Collects statistics of three inputs subcircuits minimization over all
+ * iterations of one simplification run. Number of iterations is not fixed
+ * in advance: each minimization pass appends its own `IterationStats`.
+ *
+ * All member functions are synchronized, so an instance may be safely
+ * updated by transformers that are run concurrently.
+ */
+class CircuitStats
+{
+  private:
+    std::vector<IterationStats> iterations_;
+    mutable std::mutex mutex_;
+
+  public:
+    CircuitStats()                               = default;
+    ~CircuitStats()                              = default;
+    CircuitStats(CircuitStats const&)            = delete;
+    CircuitStats& operator=(CircuitStats const&) = delete;
+
+    /**
+     * Appends statistics of a finished minimization iteration.
+     */
+    void addIteration(IterationStats const& iteration)
+    {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        iterations_.push_back(iteration);
+    }
+
+    /**
+     * @return True iff some iteration was already performed and the last one didn't modify any gate.
+     */
+    [[nodiscard]]
+    bool isLastIterationIdle() const
+    {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        return !iterations_.empty() && iterations_.back().simplified_gates == 0;
+    }
+
+    /**
+     * @return Copy of statistics of all performed iterations in order of their execution.
+     */
+    [[nodiscard]]
+    std::vector<IterationStats> getIterations() const
+    {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        return iterations_;
+    }
+
+    /**
+     * @return Total number of gates in subcircuits observed during all iterations.
+     */
+    [[nodiscard]]
+    std::size_t getTotalGatesInSubcircuits() const
+    {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        std::size_t total = 0;
+        for (auto const& iteration : iterations_)
+        {
+            total += iteration.total_gates_in_subcircuits;
+        }
+        return total;
+    }
+
+    /**
+     * Cleans state of this statistics collector.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        iterations_.clear();
+    }
+};
+
+/**
+ * Statistics of functional equivalence sweeping, accumulated over all its applications.
+ */
+struct SweepStats
+{
+    /* Number of gates, whose signature matched signature of an earlier gate. */
+    std::size_t candidates = 0;
+    /* Number of gates merged into an equivalent gate. */
+    std::size_t equivalent_merges = 0;
+    /* Number of gates replaced by negation of a complementary gate. */
+    std::size_t complementary_merges = 0;
+    /* Number of candidates, whose equivalence could be neither proven nor refuted locally. */
+    std::size_t unproven = 0;
+    /* Total wall time of sweeping in seconds. */
+    double time = 0;
+
+    /**
+     * @return total number of merged gates.
+     */
+    [[nodiscard]]
+    std::size_t getMerges() const
+    {
+        return equivalent_merges + complementary_merges;
+    }
+};
+
+/**
+ * Statistics of worklist driven simplification, accumulated over all its applications.
+ */
+struct WorklistStats
+{
+    /* Number of gates taken from the worklist, including repeated visits. */
+    std::size_t processed_gates = 0;
+    /* Number of in place rewrites of type or operands of gates. */
+    std::size_t rewritten_gates = 0;
+    /* Number of gates replaced by other gates, e.g. by their operands or structural duplicates. */
+    std::size_t replaced_gates = 0;
+    /* Number of gates replaced by three inputs resubstitution. */
+    std::size_t resubstituted_gates = 0;
+    /* Total wall time of simplification in seconds. */
+    double time = 0;
+};
+
+/**
+ * State of a single simplification run, which is passed through all
+ * transformers applied to a circuit. Distinct runs (e.g. circuits
+ * simplified concurrently) must use distinct contexts.
+ */
+struct SimplificationContext
+{
+    /* Statistics of subcircuits minimization. */
+    CircuitStats stats;
+    /* Statistics of functional equivalence sweeping. */
+    SweepStats sweep_stats{};
+    /* Statistics of worklist driven simplification. */
+    WorklistStats worklist_stats{};
+    /* Measurements of applied passes, recorded if built with `ENABLE_PASS_PROFILING`. */
+    PassProfile profile{};
+    /* Pool, which passes may use to process a circuit in parallel, or nullptr. Not owned. */
+    utils::ThreadPool* thread_pool = nullptr;
+    /*
+     * Generator of unique ids, which prefix names of gates created by passes. It belongs to
+     * the circuit, so names don't depend on the thread, which simplifies the circuit.
+     */
+    std::mt19937 id_generator{static_cast<std::mt19937::result_type>(utils::getCircuitSeed(0))};
+
+    /**
+     * Seeds generator of unique ids by index of the circuit among simplified ones.
+     * @param circuit_index -- index of the circuit, e.g. in sorted list of input files.
+     */
+    void seedIds(std::size_t circuit_index)
+    {
+        id_generator.seed(static_cast<std::mt19937::result_type>(utils::getCircuitSeed(circuit_index)));
+    }
+};
+
+}  // namespace csat::simplification
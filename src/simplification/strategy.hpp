@@ -6,8 +6,10 @@
 #include "src/simplification/constant_gate_reducer.hpp"
 #include "src/simplification/duplicate_gates_cleaner.hpp"
 #include "src/simplification/duplicate_operands_cleaner.hpp"
+#include "src/simplification/equivalence_sweeper.hpp"
 #include "src/simplification/reduce_not_composition.hpp"
 #include "src/simplification/redundant_gates_cleaner.hpp"
+#include "src/simplification/worklist_simplifier.hpp"
 #include "src/structures/circuit/dag.hpp"
 #include "src/structures/circuit/icircuit.hpp"
 
@@ -22,7 +24,7 @@ namespace csat::simplification
  */
 template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
 using RedundantGatesCleaner =
-    csat::simplification::Composition<CircuitT, csat::simplification::RedundantGatesCleaner_<csat::DAG> >;
+    csat::simplification::Composition<CircuitT, csat::simplification::RedundantGatesCleaner_<CircuitT> >;
 
 /**
  * Transformer, that cleans circuit from duplicate gates.
@@ -45,8 +47,8 @@ using DuplicateGatesCleaner = csat::simplification::Composition<
 template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
 using ReduceNotComposition = csat::simplification::Composition<
     CircuitT,
-    csat::simplification::ReduceNotComposition_<csat::DAG>,
-    csat::simplification::RedundantGatesCleaner_<csat::DAG> >;
+    csat::simplification::ReduceNotComposition_<CircuitT>,
+    csat::simplification::RedundantGatesCleaner_<CircuitT> >;
 
 /**
  * Transformer, that cleans the circuit from constant gates ( like AND(x, NOT(x)) = false )
@@ -66,10 +68,10 @@ using ReduceNotComposition = csat::simplification::Composition<
 template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
 using ConstantGateReducer = csat::simplification::Composition<
     CircuitT,
-    csat::simplification::ConstantGateReducer_<csat::DAG>,
-    csat::simplification::ReduceNotComposition_<csat::DAG>,
-    csat::simplification::RedundantGatesCleaner_<csat::DAG>,
-    csat::simplification::DuplicateGatesCleaner_<csat::DAG> >;
+    csat::simplification::ConstantGateReducer_<CircuitT>,
+    csat::simplification::ReduceNotComposition_<CircuitT>,
+    csat::simplification::RedundantGatesCleaner_<CircuitT>,
+    csat::simplification::DuplicateGatesCleaner_<CircuitT> >;
 
 /**
  * Transformer, that cleans the circuit from gates with the same operands. For example:
@@ -102,12 +104,45 @@ using ConstantGateReducer = csat::simplification::Composition<
 template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
 using DuplicateOperandsCleaner = csat::simplification::Composition<
     CircuitT,
-    csat::simplification::RedundantGatesCleaner_<csat::DAG>,
-    csat::simplification::DuplicateOperandsCleaner_<csat::DAG>,
-    csat::simplification::RedundantGatesCleaner_<csat::DAG, true>,  // true == save at least one input
-    csat::simplification::ConstantGateReducer_<csat::DAG>,
-    csat::simplification::ReduceNotComposition_<csat::DAG>,
-    csat::simplification::RedundantGatesCleaner_<csat::DAG>,
-    csat::simplification::DuplicateGatesCleaner_<csat::DAG> >;
+    csat::simplification::RedundantGatesCleaner_<CircuitT>,
+    csat::simplification::DuplicateOperandsCleaner_<CircuitT>,
+    csat::simplification::RedundantGatesCleaner_<CircuitT, true>,  // true == save at least one input
+    csat::simplification::ConstantGateReducer_<CircuitT>,
+    csat::simplification::ReduceNotComposition_<CircuitT>,
+    csat::simplification::RedundantGatesCleaner_<CircuitT>,
+    csat::simplification::DuplicateGatesCleaner_<CircuitT> >;
+
+/**
+ * Transformer, that merges functionally equivalent and complementary gates. Candidates
+ * are found by random simulation, and are merged only if their equivalence is proven.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using EquivalenceSweeping = csat::simplification::Composition<
+    CircuitT,
+    csat::simplification::RedundantGatesCleaner_<CircuitT>,
+    csat::simplification::EquivalenceSweeper_<CircuitT>,
+    csat::simplification::ReduceNotComposition_<CircuitT>,
+    csat::simplification::RedundantGatesCleaner_<CircuitT>,
+    csat::simplification::DuplicateGatesCleaner_<CircuitT> >;
+
+/**
+ * Transformer, that applies local rewrites (constant propagation, NOT folding, duplicate operands
+ * cleaning, structural hashing and three inputs resubstitution) until a fixpoint is reached,
+ * revisiting only gates, whose operands were changed.
+ *
+ * @tparam CircuitT
+ * @tparam basis -- basis of circuit, which defines the database of resubstitution.
+ */
+template<class CircuitT, Basis basis = Basis::AIG, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using IncrementalSimplification = csat::simplification::Composition<
+    CircuitT,
+    csat::simplification::WorklistSimplifier_<CircuitT, basis>,
+    csat::simplification::RedundantGatesCleaner_<CircuitT, true>,  // true == save at least one input
+    csat::simplification::ConstantGateReducer_<CircuitT>,
+    csat::simplification::ReduceNotComposition_<CircuitT>,
+    csat::simplification::RedundantGatesCleaner_<CircuitT>,
+    csat::simplification::DuplicateGatesCleaner_<CircuitT> >;
 
 }  // namespace csat::simplification
@@ -1,28 +1,32 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cassert>
-#include <cerrno>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
-#include <map>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "src/algo.hpp"
 #include "src/common/csat_types.hpp"
 #include "src/simplification/transformer_base.hpp"
 #include "src/simplification/utils/circuits_db.hpp"
+#include "src/simplification/utils/subcircuit_analysis.hpp"
 #include "src/simplification/utils/three_coloring.hpp"
+#include "src/simplification/utils/truth_table.hpp"
 #include "src/simplification/utils/two_coloring.hpp"
 #include "src/structures/circuit/gate_info.hpp"
 #include "src/structures/circuit/icircuit.hpp"
 #include "src/utility/logger.hpp"
+#include "src/utility/profiler.hpp"
 
 namespace csat::simplification
 {
@@ -31,52 +35,23 @@ namespace csat::simplification
  * Algorithm works with unary/binary operations, supports AIG/BENCH basis
  * Main idea is to iterate and try to simplify all subcircuits with 3 inputs using
  * database with small subcircuits.
+ *
+ * @tparam CircuitT
+ * @tparam basis -- basis of circuit, which defines the database of subcircuits.
  */
-struct CircuitStatsSingleton
-{
-  public:
-    std::size_t iter_number                              = 0;
-    std::vector<std::size_t> subcircuits_number_by_iter  = {0, 0, 0, 0, 0};
-    std::vector<std::size_t> skipped_subcircuits_by_iter = {0, 0, 0, 0, 0};
-    std::vector<std::size_t> max_subcircuit_size_by_iter = {0, 0, 0, 0, 0};
-    std::vector<std::size_t> circuit_size_by_iter        = {0, 0, 0, 0, 0};
-    std::vector<std::size_t> reduced_subcircuit_by_iter  = {};
-    std::size_t total_gates_in_subcircuits               = 0;
-    std::size_t last_iter_gates_simplification           = 0;
-
-    static CircuitStatsSingleton& getInstance()
-    {
-        static CircuitStatsSingleton s;
-        return s;
-    }
-
-    CircuitStatsSingleton(CircuitStatsSingleton const&)            = delete;
-    CircuitStatsSingleton& operator=(CircuitStatsSingleton const&) = delete;
-
-    /**
-     * Cleans state of this statistics collector.
-     * Usable when need to collect distinct statistics on several consequent simplification runs.
-     */
-    void cleanState()
-    {
-        iter_number                 = 0;
-        subcircuits_number_by_iter  = {0, 0, 0, 0, 0};
-        skipped_subcircuits_by_iter = {0, 0, 0, 0, 0};
-        max_subcircuit_size_by_iter = {0, 0, 0, 0, 0};
-        circuit_size_by_iter        = {0, 0, 0, 0, 0};
-        reduced_subcircuit_by_iter  = {};
-        total_gates_in_subcircuits  = 0;
-    }
-
-  private:
-    CircuitStatsSingleton()  = default;
-    ~CircuitStatsSingleton() = default;
-};
-
-template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+template<
+    class CircuitT,
+    Basis basis = Basis::AIG,
+    typename    = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
 class ThreeInputsSubcircuitMinimization : public ITransformer<CircuitT>
 {
-    csat::Logger logger{"ThreeInputsSubcircuitMinimization"};
+    csat::Logger logger{
+        basis == Basis::AIG ? "ThreeInputsSubcircuitMinimization" : "ThreeInputsSubcircuitMinimizationBench"};
+
+    /* Number of subcircuits, which are analysed before their improvements are committed. */
+    static constexpr size_t ANALYSIS_BATCH_SIZE_ = 1 << 14;
+    /* Minimal number of subcircuits, which are analysed by a single task of thread pool. */
+    static constexpr size_t ANALYSIS_GRAIN_ = 64;
 
     /**
      * Class for storaging info about observed subcircuits:
@@ -106,6 +81,8 @@ class ThreeInputsSubcircuitMinimization : public ITransformer<CircuitT>
             logger.debug(
                 "Many outputs: ",
                 many_outputs,
+                " | Not in db patterns: ",
+                not_in_db,
                 " | Smaller size: ",
                 smaller_size,
                 " | Same size: ",
@@ -118,12 +95,15 @@ class ThreeInputsSubcircuitMinimization : public ITransformer<CircuitT>
     };
 
   public:
-    std::vector<csat::utils::ThreeColor> colors;  // list of all 3-parent colors
-    std::vector<std::vector<size_t>> gateColors;  // contains up to 2 colors for each gate, otherwise: 'SIZE_MAX'
-    std::map<std::vector<GateId>, size_t> parentsToColor;  // parent ids must be in a sorted order
-
-    bool
-    update_primitive_gate(GateId primitive_gate, int32_t pattern, GateInfoContainer& gate_info, GateIdContainer parents)
+    std::vector<csat::utils::ThreeColor> colors;      // list of all 3-parent colors
+    std::vector<csat::utils::GateColors> gateColors;  // contains up to 2 colors for each gate
+    csat::utils::ParentsHashMap parentsToColor;       // parent ids must be in a sorted order
+
+    bool update_primitive_gate(
+        GateId primitive_gate,
+        int32_t pattern,
+        GateInfoContainer& gate_info,
+        std::array<GateId, 3> const& parents)
     {
         if (pattern == 0)
         {
@@ -176,10 +156,11 @@ class ThreeInputsSubcircuitMinimization : public ITransformer<CircuitT>
 
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<GateEncoder<std::string>> encoder)
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
     {
         logger.debug("=========================================================================================");
-        logger.debug("START ThreeInputsSubcircuitMinimization");
+        logger.debug("START ThreeInputsSubcircuitMinimization", basis == Basis::AIG ? "" : "Bench");
 
         logger.debug("Top sort");
         csat::GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
@@ -188,571 +169,285 @@ class ThreeInputsSubcircuitMinimization : public ITransformer<CircuitT>
         GateInfoContainer gate_info(circuit->getNumberOfGates());
 
         csat::utils::TwoColoring twoVertexColoring = csat::utils::TwoColoring(*circuit);
-        csat::utils::ThreeColoring threeColoring   = csat::utils::ThreeColoring(*circuit);
+        csat::utils::ThreeColoring threeColoring   = csat::utils::ThreeColoring(*circuit, twoVertexColoring);
 
         int circuit_size = circuit->getNumberOfGates();
-        gateColors.resize(circuit_size, {});
 
-        colors         = threeColoring.colors;
-        gateColors     = threeColoring.gateColors;
-        parentsToColor = threeColoring.parentsToColor;
+        // Only negation users are read from the coloring further, so its other parts are moved out.
+        colors         = std::move(threeColoring.colors);
+        gateColors     = std::move(threeColoring.gateColors);
+        parentsToColor = std::move(threeColoring.parentsToColor);
 
         // Filling GateInfoContainer
         for (uint64_t gateId : std::ranges::reverse_view(gate_sorting))
         {
-            GateIdContainer const& operands = circuit->getGateOperands(gateId);
-            gate_info.at(gateId)            = {circuit->getGateType(gateId), operands};
+            GateIdSpan const operands = circuit->getGateOperands(gateId);
+            gate_info.at(gateId)      = {circuit->getGateType(gateId), {operands.begin(), operands.end()}};
         }
 
-        if (CircuitStatsSingleton::getInstance().iter_number != 0 &&
-            CircuitStatsSingleton::getInstance().last_iter_gates_simplification == 0)
+        if (context.stats.isLastIterationIdle())
         {
-            return {
-                std::make_unique<CircuitT>(gate_info, circuit->getOutputGates()),
-                std::make_unique<GateEncoder<std::string>>(*encoder)};
+            return {std::make_unique<CircuitT>(gate_info, circuit->getOutputGates()), std::move(encoder)};
         }
-        CircuitStatsSingleton::getInstance().iter_number += 1;
-        CircuitStatsSingleton::getInstance().last_iter_gates_simplification = 0;
-        CircuitStatsSingleton::getInstance()
-            .circuit_size_by_iter[CircuitStatsSingleton::getInstance().iter_number - 1] = circuit_size;
+
+        // Statistics of current iteration, committed to the context once iteration is over.
+        IterationStats iteration_stats{};
+        iteration_stats.circuit_size = circuit_size;
 
         // Store database
-        auto db                           = DBSingleton::getAigDB();
-        auto& subcircuit_pattern_to_index = db->subcircuit_pattern_to_index;
-        auto& subcircuit_outputs          = db->subcircuit_outputs;
-        auto& subcircuit_gates_operands   = db->gates_operands;
-        auto& subcircuit_AND_number       = db->OPER_number;
-        auto& subcircuit_gates_operations = db->gates_operations;
+        auto db = basis == Basis::AIG ? DBSingleton::getAigDB() : DBSingleton::getBenchDB();
 
         // Parameters for statistics monitoring
         SubcircuitStats stats = SubcircuitStats();
 
-        std::vector<size_t> used_gates(circuit_size, SIZE_MAX);  // contains last color ID when gate occured
         BoolVector is_removed(circuit_size, false);
         BoolVector is_modified(circuit_size, false);
 
-        // Iterating over subcircuits defined by colors and trying to improve them
-        for (size_t color_id = 0; color_id < colors.size(); ++color_id)
+        // Subcircuits are analysed in batches, concurrently if there is a thread pool, and afterwards
+        // their improvements are committed sequentially in order of colors, so that the result
+        // doesn't depend on the number of threads.
+        std::vector<SubcircuitAnalysis> analyses(std::min(colors.size(), ANALYSIS_BATCH_SIZE_));
+        for (size_t batch_begin = 0; batch_begin < colors.size(); batch_begin += analyses.size())
         {
-            csat::utils::ThreeColor color = colors.at(color_id);
-
-            // Check whether subcircuit's inputs were removed (in this case we do not observe it)
-            if (is_removed.at(color.first_parent) || is_removed.at(color.second_parent) ||
-                is_removed.at(color.third_parent))
+            size_t const batch_size = std::min(analyses.size(), colors.size() - batch_begin);
+            auto const analyze      = [&](size_t index)
             {
-                CircuitStatsSingleton::getInstance()
-                    .skipped_subcircuits_by_iter[CircuitStatsSingleton::getInstance().iter_number - 1] += 1;
-                continue;
-            }
-
-            // Will store gates defined by parents of the following color (in topological order), except parents
-            GateIdContainer gatesByColor;
-            // Outputs in observed subcircuit (Some 'real' outputs will be removed according to our heuristic)
-            GateIdContainer outputs;
-            // All 'real' outputs
-            GateIdContainer all_outputs;
-
-            // Getting gates depending from 1 of parents
-            used_gates.at(color.first_parent)  = color_id;
-            used_gates.at(color.second_parent) = color_id;
-            used_gates.at(color.third_parent)  = color_id;
-
-            for (GateId const parent : color.getParents())
+                analyzeSubcircuit(
+                    *circuit,
+                    colors[batch_begin + index],
+                    twoVertexColoring,
+                    threeColoring.negationUsers,
+                    *db,
+                    basis,
+                    analyses[index]);
+            };
+            if (context.thread_pool != nullptr)
             {
-                GateId const negation_user = threeColoring.negationUsers.at(parent);
-                if (negation_user != SIZE_MAX)
-                {
-                    gatesByColor.push_back(negation_user);
-                    used_gates.at(negation_user) = color_id;
-                }
+                context.thread_pool->parallelFor(batch_size, analyze, ANALYSIS_GRAIN_);
             }
-
-            // Getting gates depending from 2 of parents
-            std::vector<std::vector<GateId>> const parents_pairs = {
-                {color.first_parent,  color.second_parent},
-                {color.first_parent,  color.third_parent },
-                {color.second_parent, color.third_parent }
-            };
-            for (auto const& pair : parents_pairs)
+            else
             {
-                if (twoVertexColoring.parentsToColor.find(pair) != twoVertexColoring.parentsToColor.end())
+                for (size_t index = 0; index < batch_size; ++index)
                 {
-                    for (GateId const gateId :
-                         twoVertexColoring.colors.at(twoVertexColoring.parentsToColor.at(pair)).getGates())
-                    {
-                        gatesByColor.push_back(gateId);
-                        used_gates.at(gateId) = color_id;
-                    }
+                    analyze(index);
                 }
             }
 
-            // Getting gates depending from all parents
-            for (GateId const gateId : color.getGates())
-            {
-                gatesByColor.push_back(gateId);
-                used_gates.at(gateId) = color_id;
-            }
-
-            CircuitStatsSingleton::getInstance()
-                .max_subcircuit_size_by_iter[CircuitStatsSingleton::getInstance().iter_number - 1] = std::max(
-                CircuitStatsSingleton::getInstance()
-                    .max_subcircuit_size_by_iter[CircuitStatsSingleton::getInstance().iter_number - 1],
-                gatesByColor.size() + 3);
-            CircuitStatsSingleton::getInstance().total_gates_in_subcircuits += gatesByColor.size() + 3;
-
-            // Check whether subcircuit has modified gates (in this case we do not observe it)
-            bool has_modified_gates = false;
-            for (GateId const gateId : gatesByColor)
+            for (size_t index = 0; index < batch_size; ++index)
             {
-                if (is_removed.at(gateId) || is_modified.at(gateId))
+                CSAT_PROFILE_SCOPE("ThreeInputsSubcircuitMinimization::color");
+                size_t const color_id                = batch_begin + index;
+                csat::utils::ThreeColor const& color = colors[color_id];
+                SubcircuitAnalysis& analysis         = analyses[index];
+
+                // Check whether subcircuit's inputs were removed (in this case we do not observe it)
+                if (is_removed.at(color.first_parent) || is_removed.at(color.second_parent) ||
+                    is_removed.at(color.third_parent))
                 {
-                    has_modified_gates = true;
-                    break;
+                    ++iteration_stats.skipped_subcircuits;
+                    continue;
                 }
-            }
-            if (has_modified_gates)
-            {
-                continue;
-            }
-
-            /*
-             * Gate's pattern describes it in terms of truth table:
-             * For all 8 combinations of inputs assignments we look at the resulting
-             * value in the following gate.
-             * This process is done for all inputs permutations (3! = 6)
-             * Constants: 240, 204, 170 - describe initial inputs patterns
-             */
-            std::vector<std::vector<int32_t>> all_patterns(6, std::vector<int32_t>(circuit_size, INT32_MAX));
-
-            all_patterns[0][color.first_parent]  = 240;
-            all_patterns[0][color.second_parent] = 204;
-            all_patterns[0][color.third_parent]  = 170;
-
-            all_patterns[1][color.first_parent]  = 240;
-            all_patterns[1][color.second_parent] = 170;
-            all_patterns[1][color.third_parent]  = 204;
-
-            all_patterns[2][color.first_parent]  = 204;
-            all_patterns[2][color.second_parent] = 240;
-            all_patterns[2][color.third_parent]  = 170;
-
-            all_patterns[3][color.first_parent]  = 204;
-            all_patterns[3][color.second_parent] = 170;
-            all_patterns[3][color.third_parent]  = 240;
-
-            all_patterns[4][color.first_parent]  = 170;
-            all_patterns[4][color.second_parent] = 240;
-            all_patterns[4][color.third_parent]  = 204;
 
-            all_patterns[5][color.first_parent]  = 170;
-            all_patterns[5][color.second_parent] = 204;
-            all_patterns[5][color.third_parent]  = 240;
+                iteration_stats.max_subcircuit_size =
+                    std::max(iteration_stats.max_subcircuit_size, analysis.gates.size() + 3);
+                iteration_stats.total_gates_in_subcircuits += analysis.gates.size() + 3;
 
-            std::vector<std::vector<int32_t>> output_patterns(6);
-            GateIdContainer primitive_gates;  // constant gates + gates equal to parents or their negations
-
-            // Getting outputs of the following subcircuit (and check that all gates exist)
-            for (GateId gateId : gatesByColor)
-            {
-                GateIdContainer const& operands = circuit->getGateOperands(gateId);
-                GateIdContainer const& users    = circuit->getGateUsers(gateId);
-                GateType oper                   = circuit->getGateType(gateId);
-
-                if (oper == GateType::AND)
-                {
-                    for (size_t i = 0; i < 6; ++i)
-                    {
-                        all_patterns[i][gateId] = all_patterns[i][operands[0]] & all_patterns[i][operands[1]];
-                    }
-                }
-                else if (oper == GateType::NOT)
+                // Check whether subcircuit has modified gates (in this case we do not observe it)
+                bool has_modified_gates = false;
+                for (GateId const gateId : analysis.gates)
                 {
-                    for (size_t i = 0; i < 6; ++i)
+                    if (is_removed.at(gateId) || is_modified.at(gateId))
                     {
-                        all_patterns[i][gateId] = 255 - all_patterns[i][operands[0]];
+                        has_modified_gates = true;
+                        break;
                     }
                 }
-                else
+                if (has_modified_gates)
                 {
-                    std::cerr << "Error! Incorrect operation!" << std::endl;
-                    std::abort();
+                    continue;
                 }
 
-                if (all_patterns[0][gateId] == 0 || all_patterns[0][gateId] == 255 || all_patterns[0][gateId] == 240 ||
-                    all_patterns[0][gateId] == 204 || all_patterns[0][gateId] == 170)
+                // Subcircuit, whose gates read gates outside of it, is not a function of its parents
+                if (!analysis.closed)
                 {
-                    primitive_gates.push_back(gateId);
+                    CSAT_PROFILE_COUNT("ThreeInputsSubcircuitMinimization::not_closed", 1);
+                    ++iteration_stats.skipped_subcircuits;
+                    continue;
                 }
 
-                if (all_patterns[0][gateId] == 15 && (oper != GateType::NOT || operands[0] != color.first_parent))
+                // Replacing outputs, which are equal to constants, parents or other outputs
+                for (SubcircuitAnalysis::Rewrite const& rewrite : analysis.rewrites)
                 {
-                    primitive_gates.push_back(gateId);
-                }
-                if (all_patterns[0][gateId] == 51 && (oper != GateType::NOT || operands[0] != color.second_parent))
-                {
-                    primitive_gates.push_back(gateId);
+                    gate_info.at(rewrite.gate) = {
+                        rewrite.type,
+                        rewrite.second_operand == SIZE_MAX
+                            ? GateIdContainer{rewrite.first_operand}
+                            : GateIdContainer{rewrite.first_operand, rewrite.second_operand}};
+                    if (rewrite.modified)
+                    {
+                        is_modified.at(rewrite.gate) = true;
+                        ++iteration_stats.simplified_gates;
+                    }
                 }
-                if (all_patterns[0][gateId] == 85 && (oper != GateType::NOT || operands[0] != color.third_parent))
+
+                if (analysis.verdict != SubcircuitAnalysis::Verdict::FOUND)
                 {
-                    primitive_gates.push_back(gateId);
+                    if (analysis.verdict == SubcircuitAnalysis::Verdict::MANY_OUTPUTS)
+                    {
+                        ++stats.many_outputs;
+                    }
+                    else
+                    {
+                        ++stats.not_in_db;
+                    }
+                    // Improving primitive gates
+                    for (GateId primitive_gate : analysis.primitive_gates)
+                    {
+                        int32_t pattern = analysis.tables[analysis.findMember(primitive_gate)];
+                        update_primitive_gate(primitive_gate, pattern, gate_info, color.getParents());
+                        is_modified[primitive_gate] = true;
+                        ++iteration_stats.simplified_gates;
+                    }
+                    continue;
                 }
 
-                /**
-                 * New Heuristic (!!!)
-                 * We do not need all the outputs to be real outputs
-                 * As we minimize ANDs number, outputs that are the negations of another outputs
-                 * or negations of inputs gate are useless to count them
-                 * we can just manually add them as NOT(x) where x is the following gate or copy from parents
-                 */
+                int32_t const patternIndex                      = analysis.pattern_index;
+                size_t const true_ind                           = analysis.permutation;
+                std::span<DBGate const> const pattern_gates     = db->getGates(patternIndex);
+                std::span<uint16_t const> const pattern_outputs = db->getOutputs(patternIndex);
 
-                if (circuit->isOutputGate(gateId))
+                if (db->getOperatorsNumber(patternIndex) < analysis.operators_number)
                 {
-                    all_outputs.push_back(gateId);
-                    int32_t pattern           = all_patterns[0][gateId];
-                    GateId gate_first_operand = operands[0];
-                    if (update_primitive_gate(gateId, pattern, gate_info, color.getParents()))
+                    ++stats.smaller_size;
+                    ++iteration_stats.simplified_gates;
+                    for (GateId const gateId : analysis.gates)
                     {
-                        if (all_patterns[0][gateId] == 15)
-                        {
-                            if (oper != GateType::NOT || gate_first_operand != color.first_parent)
-                            {
-                                is_modified.at(gateId) = true;
-                                CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                            }
-                        }
-                        else if (all_patterns[0][gateId] == 51)
-                        {
-                            if (oper != GateType::NOT || gate_first_operand != color.second_parent)
-                            {
-                                is_modified.at(gateId) = true;
-                                CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                            }
-                        }
-                        else if (all_patterns[0][gateId] == 85)
-                        {
-                            if (oper != GateType::NOT || gate_first_operand != color.third_parent)
-                            {
-                                is_modified.at(gateId) = true;
-                                CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                            }
-                        }
-                        else
-                        {
-                            is_modified.at(gateId) = true;
-                            CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                        }
+                        is_removed[gateId] = true;
                     }
-                    else
+                    // Changed outputs -> all_outputs
+                    for (GateId const output : analysis.all_outputs)
                     {
-                        bool fl = false;
-                        for (size_t i = 0; i < output_patterns[0].size(); ++i)
-                        {
-                            int const output_pattern = output_patterns[0][i];
-                            if (all_patterns[0][gateId] == output_pattern)
-                            {
-                                is_modified.at(gateId) = true;
-                                CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                                gate_info.at(gateId) = {
-                                    GateType::AND, {outputs[i], outputs[i]}
-                                };
-                                fl = true;
-                                break;
-                            }
-                            else if (all_patterns[0][gateId] == 255 - output_pattern)
-                            {
-                                /**
-                                 * Check whether we have changed the operation for the gate
-                                 * We do this in order not to add modified status for unchanged gates
-                                 */
-                                if (oper != GateType::NOT || operands[0] != outputs[i])
-                                {
-                                    is_modified.at(gateId) = true;
-                                    CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                                    gate_info.at(gateId) = {GateType::NOT, {outputs[i]}};
-                                }
-                                fl = true;
-                                break;
-                            }
-                        }
-                        if (fl)
-                        {
-                            continue;
-                        }
-
-                        outputs.push_back(gateId);
-                        for (size_t i = 0; i < 6; ++i)
-                        {
-                            output_patterns[i].push_back(all_patterns[i][gateId]);
-                        }
+                        is_modified[output] = true;
+                        is_removed[output]  = false;
                     }
                 }
                 else
                 {
-                    for (GateId const user : users)
+                    if (db->getOperatorsNumber(patternIndex) == analysis.operators_number)
+                    {
+                        ++stats.same_size;
+                    }
+                    else
                     {
-                        if (used_gates[user] != color_id)
-                        {
-                            all_outputs.push_back(gateId);
-                            int32_t pattern           = all_patterns[0][gateId];
-                            GateId gate_first_operand = operands[0];
-                            if (update_primitive_gate(gateId, pattern, gate_info, color.getParents()))
-                            {
-                                if (all_patterns[0][gateId] == 15)
-                                {
-                                    if (oper != GateType::NOT || gate_first_operand != color.first_parent)
-                                    {
-                                        is_modified.at(gateId) = true;
-                                        CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                                    }
-                                }
-                                else if (all_patterns[0][gateId] == 51)
-                                {
-                                    if (oper != GateType::NOT || gate_first_operand != color.second_parent)
-                                    {
-                                        is_modified.at(gateId) = true;
-                                        CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                                    }
-                                }
-                                else if (all_patterns[0][gateId] == 85)
-                                {
-                                    if (oper != GateType::NOT || gate_first_operand != color.third_parent)
-                                    {
-                                        is_modified.at(gateId) = true;
-                                        CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                                    }
-                                }
-                                else
-                                {
-                                    is_modified.at(gateId) = true;
-                                    CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                                }
-                            }
-                            else
-                            {
-                                bool fl = false;
-                                for (size_t i = 0; i < output_patterns[0].size(); ++i)
-                                {
-                                    int const output_pattern = output_patterns[0][i];
-                                    if (all_patterns[0][gateId] == output_pattern)
-                                    {
-                                        is_modified.at(gateId) = true;
-                                        CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                                        gate_info.at(gateId) = {
-                                            GateType::AND, {outputs[i], outputs[i]}
-                                        };
-                                        fl = true;
-                                        break;
-                                    }
-                                    else if (all_patterns[0][gateId] == 255 - output_pattern)
-                                    {
-                                        if (oper != GateType::NOT || operands[0] != outputs[i])
-                                        {
-                                            is_modified.at(gateId) = true;
-                                            CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                                            gate_info.at(gateId) = {GateType::NOT, {outputs[i]}};
-                                        }
-                                        fl = true;
-                                        break;
-                                    }
-                                }
-                                if (fl)
-                                {
-                                    continue;
-                                }
-
-                                outputs.push_back(gateId);
-                                for (size_t i = 0; i < 6; ++i)
-                                {
-                                    output_patterns[i].push_back(all_patterns[i][gateId]);
-                                }
-                                break;
-                            }
-                        }
+                        ++stats.bigger_size;
                     }
+                    continue;
                 }
-            }
 
-            if (outputs.size() > 3)
-            {
-                ++stats.many_outputs;
-                // Improving primitive gates
-                for (GateId primitive_gate : primitive_gates)
+                std::vector<GateId> bijection(pattern_gates.size() + 3, SIZE_MAX);
+                if (true_ind == 0)
                 {
-                    int32_t pattern = all_patterns[0][primitive_gate];
-                    update_primitive_gate(primitive_gate, pattern, gate_info, color.getParents());
-                    is_modified[primitive_gate] = true;
-                    CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
+                    bijection[0] = color.first_parent;
+                    bijection[1] = color.second_parent;
+                    bijection[2] = color.third_parent;
                 }
-                continue;
-            }
 
-            int true_ind = -1;
-
-            for (size_t i = 0; i < 6; ++i)
-            {
-                std::sort(output_patterns[i].begin(), output_patterns[i].end());
-                if (subcircuit_pattern_to_index.find(output_patterns[i]) != subcircuit_pattern_to_index.end())
+                if (true_ind == 1)
                 {
-                    true_ind = static_cast<int>(i);
-                    break;
+                    bijection[0] = color.first_parent;
+                    bijection[1] = color.third_parent;
+                    bijection[2] = color.second_parent;
                 }
-            }
-
-            if (true_ind == -1)
-            {
-                ++stats.not_in_db;
 
-                for (GateId primitive_gate : primitive_gates)
+                if (true_ind == 2)
                 {
-                    int32_t pattern = all_patterns[0][primitive_gate];
-                    update_primitive_gate(primitive_gate, pattern, gate_info, color.getParents());
-                    is_modified[primitive_gate] = true;
-                    CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
+                    bijection[0] = color.second_parent;
+                    bijection[1] = color.first_parent;
+                    bijection[2] = color.third_parent;
                 }
-                continue;
-            }
 
-            int patternIndex = subcircuit_pattern_to_index[output_patterns[true_ind]];
-
-            int32_t AND_number = 0;
-            for (GateId gateId : gatesByColor)
-            {
-                if (circuit->getGateType(gateId) == GateType::AND)
+                if (true_ind == 3)
                 {
-                    ++AND_number;
+                    bijection[0] = color.third_parent;
+                    bijection[1] = color.first_parent;
+                    bijection[2] = color.second_parent;
                 }
-            }
 
-            if (subcircuit_AND_number[patternIndex] < AND_number)
-            {
-                ++stats.smaller_size;
-                CircuitStatsSingleton::getInstance().last_iter_gates_simplification += 1;
-                for (GateId const gateId : gatesByColor)
+                if (true_ind == 4)
                 {
-                    is_removed[gateId] = true;
+                    bijection[0] = color.second_parent;
+                    bijection[1] = color.third_parent;
+                    bijection[2] = color.first_parent;
                 }
-                // Changed outputs -> all_outputs
-                for (GateId const output : all_outputs)
-                {
-                    is_modified[output] = true;
-                    is_removed[output]  = false;
-                }
-            }
-            else
-            {
-                if (subcircuit_AND_number[patternIndex] == AND_number)
-                {
-                    ++stats.same_size;
-                }
-                else
+
+                if (true_ind == 5)
                 {
-                    ++stats.bigger_size;
+                    bijection[0] = color.third_parent;
+                    bijection[1] = color.second_parent;
+                    bijection[2] = color.first_parent;
                 }
-                continue;
-            }
-
-            std::vector<GateId> bijection(subcircuit_gates_operands[patternIndex].size() + 3, SIZE_MAX);
-            if (true_ind == 0)
-            {
-                bijection[0] = color.first_parent;
-                bijection[1] = color.second_parent;
-                bijection[2] = color.third_parent;
-            }
-
-            if (true_ind == 1)
-            {
-                bijection[0] = color.first_parent;
-                bijection[1] = color.third_parent;
-                bijection[2] = color.second_parent;
-            }
 
-            if (true_ind == 2)
-            {
-                bijection[0] = color.second_parent;
-                bijection[1] = color.first_parent;
-                bijection[2] = color.third_parent;
-            }
-
-            if (true_ind == 3)
-            {
-                bijection[0] = color.third_parent;
-                bijection[1] = color.first_parent;
-                bijection[2] = color.second_parent;
-            }
-
-            if (true_ind == 4)
-            {
-                bijection[0] = color.second_parent;
-                bijection[1] = color.third_parent;
-                bijection[2] = color.first_parent;
-            }
-
-            if (true_ind == 5)
-            {
-                bijection[0] = color.third_parent;
-                bijection[1] = color.second_parent;
-                bijection[2] = color.first_parent;
-            }
-
-            for (size_t i = 0; i < outputs.size(); ++i)
-            {
-                for (GateId output : outputs)
+                for (size_t i = 0; i < analysis.pattern_output_gates.size(); ++i)
                 {
-                    if (all_patterns[true_ind][output] == output_patterns[true_ind][i])
+                    if (analysis.pattern_output_gates[i] != SIZE_MAX)
                     {
-                        bijection[subcircuit_outputs[patternIndex][i]] = output;
+                        bijection[pattern_outputs[i]] = analysis.pattern_output_gates[i];
                     }
                 }
-            }
 
-            for (size_t i = 0; i < subcircuit_gates_operands[patternIndex].size(); ++i)
-            {
-                if (bijection[i + 3] == SIZE_MAX)
+                for (size_t i = 0; i < pattern_gates.size(); ++i)
                 {
-                    GateId new_gateID = encoder->encodeGate(
-                        "new_gate_pattern_" + std::to_string(patternIndex) + "_" + std::to_string(color_id) + "_" +
-                        std::to_string(colors.size()) + "_" + std::to_string(i) + "_" +
-                        std::to_string((*encoder).size()));
-                    // Create default gates
-                    gate_info.emplace_back(GateType::NOT, GateIdContainer(color.first_parent));
-                    bijection[i + 3] = new_gateID;
+                    if (bijection[i + 3] == SIZE_MAX)
+                    {
+                        GateId new_gateID = encoder->encodeGate(
+                            "new_gate_pattern_" + std::to_string(patternIndex) + "_" + std::to_string(color_id) +
+                            "_" + std::to_string(colors.size()) + "_" + std::to_string(i) + "_" +
+                            std::to_string((*encoder).size()));
+                        // Create default gates
+                        gate_info.emplace_back(GateType::NOT, GateIdContainer{color.first_parent});
+                        bijection[i + 3] = new_gateID;
+                    }
                 }
-            }
-
-            for (size_t i = 0; i < subcircuit_gates_operands[patternIndex].size(); ++i)
-            {
-                std::vector<GateId> new_operands;
 
-                for (GateId gateId : subcircuit_gates_operands[patternIndex][i])
+                for (size_t i = 0; i < pattern_gates.size(); ++i)
                 {
-                    new_operands.push_back(bijection[gateId]);
-                }
+                    std::vector<GateId> new_operands;
 
-                if (bijection[i + 3] == SIZE_MAX)
-                {
-                    GateId new_gateID = encoder->encodeGate(
-                        "new_gate_pattern_" + std::to_string(patternIndex) + "_" + std::to_string(color_id) + "_" +
-                        std::to_string(colors.size()) + "_" + std::to_string(i) + "_" +
-                        std::to_string((*encoder).size()));
-                    gate_info.emplace_back(subcircuit_gates_operations[patternIndex][i], new_operands);
-                    bijection[i + 3] = new_gateID;
-                }
-                else
-                {
-                    gate_info.at(bijection[i + 3]) = {subcircuit_gates_operations[patternIndex][i], new_operands};
+                    for (GateId gateId : pattern_gates[i].getOperands())
+                    {
+                        new_operands.push_back(bijection[gateId]);
+                    }
+
+                    if (bijection[i + 3] == SIZE_MAX)
+                    {
+                        GateId new_gateID = encoder->encodeGate(
+                            "new_gate_pattern_" + std::to_string(patternIndex) + "_" + std::to_string(color_id) +
+                            "_" + std::to_string(colors.size()) + "_" + std::to_string(i) + "_" +
+                            std::to_string((*encoder).size()));
+                        gate_info.emplace_back(pattern_gates[i].type, new_operands);
+                        bijection[i + 3] = new_gateID;
+                    }
+                    else
+                    {
+                        gate_info.at(bijection[i + 3]) = {pattern_gates[i].type, new_operands};
+                    }
                 }
             }
         }
-        stats.subcircuits_count = colors.size();
-        CircuitStatsSingleton::getInstance()
-            .subcircuits_number_by_iter[CircuitStatsSingleton::getInstance().iter_number - 1] += colors.size();
-        CircuitStatsSingleton::getInstance().reduced_subcircuit_by_iter.push_back(stats.smaller_size);
+        stats.subcircuits_count             = colors.size();
+        iteration_stats.subcircuits_number  = colors.size();
+        iteration_stats.reduced_subcircuits = stats.smaller_size;
+        context.stats.addIteration(iteration_stats);
         stats.print();
 
-        return {
-            std::make_unique<CircuitT>(gate_info, circuit->getOutputGates()),
-            std::make_unique<GateEncoder<std::string>>(*encoder)};
+        return {std::make_unique<CircuitT>(gate_info, circuit->getOutputGates()), std::move(encoder)};
     }
 };
 
+/**
+ * Three inputs subcircuits minimization of circuits in BENCH basis.
+ */
+template<class CircuitT>
+using ThreeInputsSubcircuitMinimizationBench = ThreeInputsSubcircuitMinimization<CircuitT, Basis::BENCH>;
+
 }  // namespace csat::simplification
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "src/common/csat_types.hpp"
+#include "src/simplification/simplification_context.hpp"
 #include "src/structures/circuit/icircuit.hpp"
 #include "src/utility/encoder.hpp"
 #include "src/utility/random.hpp"
@@ -28,25 +29,67 @@ template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit,
 class ITransformer
 {
   public:
+    virtual ~ITransformer() = default;
+
+    CircuitAndEncoder<CircuitT, std::string> apply(
+        CircuitT const& circuit,
+        GateEncoder<std::string> const& encoder,
+        SimplificationContext& context)
+    {
+        return transform(
+            std::make_unique<CircuitT>(circuit), std::make_unique<GateEncoder<std::string>>(encoder), context);
+    }
+
+    /**
+     * Applies transformer within a fresh context, which is discarded afterwards.
+     */
     CircuitAndEncoder<CircuitT, std::string> apply(CircuitT const& circuit, GateEncoder<std::string> const& encoder)
     {
-        return transform(std::make_unique<CircuitT>(circuit), std::make_unique<GateEncoder<std::string>>(encoder));
+        SimplificationContext context{};
+        return apply(circuit, encoder, context);
     }
 
     virtual CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT>,
-        std::unique_ptr<GateEncoder<std::string>>) = 0;
+        std::unique_ptr<GateEncoder<std::string>>,
+        SimplificationContext&) = 0;
 };
 
-static std::string getUniqueId_()
+/**
+ * Applies `transform` to circuit and, if built with `ENABLE_PASS_PROFILING`, records it as a pass
+ * to the profile of context. Otherwise the hook is compiled out, and name of pass is not even built.
+ *
+ * @param get_name -- callable, which returns name of the pass.
+ * @param transform -- callable, which takes circuit and encoder, and returns transformed ones.
+ */
+template<class CircuitT, class NameGetter, class Transform>
+CircuitAndEncoder<CircuitT, std::string> profilePass_(
+    std::unique_ptr<CircuitT> circuit,
+    std::unique_ptr<GateEncoder<std::string>> encoder,
+    SimplificationContext& context,
+    [[maybe_unused]] NameGetter const& get_name,
+    Transform const& transform)
+{
+#ifdef ENABLE_PASS_PROFILING
+    std::size_t const pass = context.profile.beginPass(get_name(), circuit->getNumberOfGates());
+    auto result            = transform(std::move(circuit), std::move(encoder));
+    context.profile.endPass(pass, result.first->getNumberOfGates());
+    return result;
+#else
+    static_cast<void>(context);
+    return transform(std::move(circuit), std::move(encoder));
+#endif
+}
+
+inline std::string getUniqueId_(SimplificationContext& context)
 {
     // Currently not the best way of random number generation
     // is presented, but it should be enough since number of
     // transformers applied to a circuit is relatively low.
-    static auto engine(utils::getNewMersenneTwisterEngine());
-    static std::uniform_int_distribution<> dist(100'000'000, 999'999'999);
+    // Generator belongs to the circuit, so ids don't depend on scheduling of circuits.
+    std::uniform_int_distribution<> dist(100'000'000, 999'999'999);
 
-    return std::to_string(dist(engine));
+    return std::to_string(dist(context.id_generator));
 }
 
 inline std::string getNewGateName_(std::string const& prefix, GateId id)
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/simplification/strategy.hpp"
+#include "src/simplification/three_inputs_optimization.hpp"
+#include "src/simplification/transformer_base.hpp"
+#include "src/structures/circuit/icircuit.hpp"
+
+namespace csat::simplification
+{
+
+/**
+ * Registry of transformers, available by name at runtime. Registry stores factories
+ * rather than transformers, since transformers may carry state of a single run, so
+ * each pipeline, built from the registry, gets its own instances.
+ *
+ * @tparam CircuitT -- type of a circuit structure.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+class TransformerRegistry
+{
+  public:
+    using TransformerPtr = std::unique_ptr<ITransformer<CircuitT>>;
+    using Factory        = std::function<TransformerPtr()>;
+
+  private:
+    std::map<std::string, Factory> factories_{};
+
+  public:
+    /**
+     * Registers a factory of transformer. Factory, which was registered under the same name, is replaced.
+     * @param name -- name of transformer.
+     * @param factory -- callable, which creates a new instance of transformer.
+     */
+    void registerTransformer(std::string const& name, Factory factory)
+    {
+        factories_[name] = std::move(factory);
+    }
+
+    /**
+     * Registers a default constructible transformer.
+     */
+    template<class TransformerT>
+    void registerTransformer(std::string const& name)
+    {
+        static_assert(
+            std::is_base_of_v<ITransformer<CircuitT>, TransformerT>,
+            "Registered transformer must implement ITransformer and be parametrized with CircuitT type.");
+        registerTransformer(name, []() -> TransformerPtr { return std::make_unique<TransformerT>(); });
+    }
+
+    [[nodiscard]]
+    bool contains(std::string const& name) const
+    {
+        return factories_.contains(name);
+    }
+
+    /**
+     * @return new instance of transformer, registered under `name`.
+     */
+    [[nodiscard]]
+    TransformerPtr create(std::string const& name) const
+    {
+        auto const it = factories_.find(name);
+        if (it == factories_.end())
+        {
+            std::cerr << "Unknown transformer \"" << name << "\"." << std::endl;
+            std::abort();
+        }
+        return it->second();
+    }
+
+    /**
+     * @return names of all registered transformers in alphabetic order.
+     */
+    [[nodiscard]]
+    std::vector<std::string> getNames() const
+    {
+        std::vector<std::string> names{};
+        names.reserve(factories_.size());
+        for (auto const& [name, factory] : factories_)
+        {
+            names.push_back(name);
+        }
+        return names;
+    }
+};
+
+/**
+ * Creates registry of all transformers of the project, suitable for circuits in given basis:
+ *
+ *   redundant   -- `RedundantGatesCleaner`,
+ *   dup_gates   -- `DuplicateGatesCleaner`,
+ *   dup_ops     -- `DuplicateOperandsCleaner`,
+ *   const       -- `ConstantGateReducer`,
+ *   reduce_not  -- `ReduceNotComposition`,
+ *   sweep       -- `EquivalenceSweeping`,
+ *   incremental -- `IncrementalSimplification`,
+ *   3in_min     -- three inputs subcircuits minimization of the basis.
+ *
+ * @param basis -- basis of circuits, which defines the database of minimizations.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+TransformerRegistry<CircuitT> makeTransformerRegistry(Basis basis)
+{
+    TransformerRegistry<CircuitT> registry{};
+    registry.template registerTransformer<RedundantGatesCleaner<CircuitT>>("redundant");
+    registry.template registerTransformer<DuplicateGatesCleaner<CircuitT>>("dup_gates");
+    registry.template registerTransformer<DuplicateOperandsCleaner<CircuitT>>("dup_ops");
+    registry.template registerTransformer<ConstantGateReducer<CircuitT>>("const");
+    registry.template registerTransformer<ReduceNotComposition<CircuitT>>("reduce_not");
+    registry.template registerTransformer<EquivalenceSweeping<CircuitT>>("sweep");
+    if (basis == Basis::AIG)
+    {
+        registry.template registerTransformer<IncrementalSimplification<CircuitT, Basis::AIG>>("incremental");
+        registry.template registerTransformer<ThreeInputsSubcircuitMinimization<CircuitT>>("3in_min");
+    }
+    else
+    {
+        registry.template registerTransformer<IncrementalSimplification<CircuitT, Basis::BENCH>>("incremental");
+        registry.template registerTransformer<ThreeInputsSubcircuitMinimizationBench<CircuitT>>("3in_min");
+    }
+    return registry;
+}
+
+}  // namespace csat::simplification
@@ -1,40 +1,133 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <map>
 #include <memory>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "src/common/csat_types.hpp"
 #include "src/utility/converters.hpp"
+#include "src/utility/mapped_file.hpp"
 
 namespace csat::simplification
 {
 
+/**
+ * Gate of a database circuit. Operands are indices of inputs and gates of the circuit.
+ */
+struct DBGate
+{
+    GateType type           = GateType::UNDEFINED;
+    uint8_t operands_number = 0;
+    std::array<uint16_t, 2> operands{};
+
+    [[nodiscard]]
+    std::span<uint16_t const> getOperands() const
+    {
+        return {operands.data(), operands_number};
+    }
+};
+
 /**
  * Structure for storing a circuit database.
+ *
+ * Circuits are stored in flat arrays, and are indexed by packed truth tables of their
+ * outputs (see `packPatterns`) in an open addressing hash table, which keeps keys and
+ * values together, so a lookup is typically a single load.
+ *
+ * A database is read either from a text file (see `read_db`), or from a binary image
+ * (see `writeImage`), which is memory-mapped and used as is, without any parsing.
  */
 struct CircuitDB
 {
-    std::map<std::vector<int32_t>, int32_t> subcircuit_pattern_to_index;
-    std::vector<GateIdContainer> subcircuit_outputs;
-    std::vector<std::vector<GateIdContainer>> gates_operands;
-    std::vector<int32_t> OPER_number;
-    std::vector<std::vector<GateType>> gates_operations;
+    /* Marks absence of pattern in the database. */
+    static constexpr int32_t NOT_FOUND = -1;
+    /* Marks patterns, which can't be packed, and so are never found in the database. */
+    static constexpr uint32_t INVALID_KEY = UINT32_MAX;
+    /* Maximum number of outputs of an indexed circuit. */
+    static constexpr size_t MAX_OUTPUTS = 3;
+
+    /* First bytes of a binary image. */
+    static constexpr std::array<char, 8> IMAGE_MAGIC{'C', 'S', 'A', 'T', 'C', 'D', 'B', '\0'};
+    /* Version of binary image layout, must be increased on any change of it. */
+    static constexpr uint32_t IMAGE_VERSION = 1;
+    /* Written in native byte order, so images of another endianness are detected. */
+    static constexpr uint32_t IMAGE_BYTE_ORDER = 0x01020304;
+
+    /**
+     * Header of a binary image. It is followed by arrays `pattern_slots_`, `gates_begin_`,
+     * `outputs_begin_`, `operators_number_`, `outputs_` and `gates_` in native byte order,
+     * each starting at an offset, which is a multiple of 8.
+     */
+    struct ImageHeader
+    {
+        std::array<char, 8> magic{};
+        uint32_t version         = 0;
+        uint32_t byte_order      = 0;
+        uint32_t basis           = 0;
+        uint32_t reserved        = 0;
+        uint64_t slots_number    = 0;
+        uint64_t circuits_number = 0;
+        uint64_t gates_number    = 0;
+        uint64_t outputs_number  = 0;
+    };
+
+  protected:
+    /* Marks empty slot of the hash table. */
+    static constexpr uint64_t EMPTY_SLOT_ = UINT64_MAX;
+
+    static_assert(sizeof(ImageHeader) % 8 == 0);
+    static_assert(std::is_trivially_copyable_v<DBGate> && sizeof(DBGate) == 6);
 
+    /* Arrays of a database, read from a text file. */
+    struct Storage_
+    {
+        std::vector<uint64_t> pattern_slots{};
+        std::vector<DBGate> gates{};
+        std::vector<uint32_t> gates_begin{0};
+        std::vector<uint16_t> outputs{};
+        std::vector<uint32_t> outputs_begin{0};
+        std::vector<int32_t> operators_number{};
+    };
+
+    Basis basis_;
+    /* Owns arrays of a database, read from a text file. */
+    Storage_ storage_{};
+    /* Owns arrays of a database, read from a binary image. */
+    std::unique_ptr<utils::MappedFile> image_ = nullptr;
+
+    // Views below refer either to `storage_`, or to `image_`.
+    /* Hash table slots, each holds a packed key in high half and index of circuit in low half. */
+    std::span<uint64_t const> pattern_slots_{};
+    /* Gates of all circuits, gates of circuit `i` are `[gates_begin_[i], gates_begin_[i + 1])`. */
+    std::span<DBGate const> gates_{};
+    std::span<uint32_t const> gates_begin_{};
+    /* Indices of outputs of all circuits, laid out as gates. */
+    std::span<uint16_t const> outputs_{};
+    std::span<uint32_t const> outputs_begin_{};
+    /* Number of binary operators in each circuit. */
+    std::span<int32_t const> operators_number_{};
+
+  public:
     /**
      * Reads a database for simplification in a specific format.
-     * @param db_path -- path to the database text file
+     * Binary images are recognized by their first bytes, other files are read as text.
+     *
+     * @param db_path -- path to the database text file or binary image
      * @param basis -- the database basis in which it will be read
      */
     CircuitDB(std::filesystem::path const& db_path, Basis basis)
+        : basis_(basis)
     {
         if (basis != Basis::BENCH and basis != Basis::AIG)
         {
@@ -47,7 +140,170 @@ struct CircuitDB
             std::abort();
         }
 
-        read_db(db_path);
+        if (readImageHeader_(db_path).magic == IMAGE_MAGIC)
+        {
+            mapImage_(db_path);
+        }
+        else
+        {
+            read_db(db_path);
+        }
+    }
+
+    // Views may refer to own storage, so database is never copied.
+    CircuitDB(CircuitDB const&)            = delete;
+    CircuitDB& operator=(CircuitDB const&) = delete;
+
+    /**
+     * @param image_path -- path to a file.
+     * @param basis -- expected basis of the database.
+     * @return true iff file is a binary image of a database in given basis, which
+     *         has the current version and was written on a machine of the same endianness.
+     */
+    static bool isCompatibleImage(std::filesystem::path const& image_path, Basis basis)
+    {
+        if (!std::filesystem::is_regular_file(image_path))
+        {
+            return false;
+        }
+        ImageHeader const header = readImageHeader_(image_path);
+        return header.magic == IMAGE_MAGIC && header.version == IMAGE_VERSION &&
+               header.byte_order == IMAGE_BYTE_ORDER && header.basis == static_cast<uint32_t>(basis) &&
+               std::filesystem::file_size(image_path) == imageLayout_(header).size;
+    }
+
+    /**
+     * Writes the database as a binary image, which may be loaded by the constructor.
+     * @param image_path -- path to the image to write.
+     */
+    void writeImage(std::filesystem::path const& image_path) const
+    {
+        std::ofstream image(image_path, std::ios::binary | std::ios::trunc);
+        if (!image.is_open())
+        {
+            std::cerr << "Can't open file \"" << image_path.string() << "\" for writing." << std::endl;
+            std::abort();
+        }
+
+        ImageHeader header{};
+        header.magic           = IMAGE_MAGIC;
+        header.version         = IMAGE_VERSION;
+        header.byte_order      = IMAGE_BYTE_ORDER;
+        header.basis           = static_cast<uint32_t>(basis_);
+        header.slots_number    = pattern_slots_.size();
+        header.circuits_number = operators_number_.size();
+        header.gates_number    = gates_.size();
+        header.outputs_number  = outputs_.size();
+
+        writeImageArray_(image, std::span<ImageHeader const>(&header, 1));
+        writeImageArray_(image, pattern_slots_);
+        writeImageArray_(image, gates_begin_);
+        writeImageArray_(image, outputs_begin_);
+        writeImageArray_(image, operators_number_);
+        writeImageArray_(image, outputs_);
+        writeImageArray_(image, gates_);
+
+        if (!image.good())
+        {
+            std::cerr << "Failed to write database image \"" << image_path.string() << "\"." << std::endl;
+            std::abort();
+        }
+    }
+
+    /**
+     * Packs up to `MAX_OUTPUTS` truth tables of three inputs into a key. Order of tables
+     * matters, so ones, which are looked up, should be sorted as in the database.
+     *
+     * @param patterns -- truth tables of outputs, each in range [0, 255].
+     * @return packed key, or `INVALID_KEY` if patterns can't be packed.
+     */
+    static uint32_t packPatterns(std::span<int32_t const> patterns)
+    {
+        if (patterns.size() > MAX_OUTPUTS)
+        {
+            return INVALID_KEY;
+        }
+        uint32_t key = static_cast<uint32_t>(patterns.size());
+        for (int32_t const pattern : patterns)
+        {
+            if (pattern < 0 || pattern > UINT8_MAX)
+            {
+                return INVALID_KEY;
+            }
+            key = (key << 8) | static_cast<uint32_t>(pattern);
+        }
+        return key;
+    }
+
+    /**
+     * @param key -- packed truth tables of outputs, see `packPatterns`.
+     * @return index of circuit with such outputs, or `NOT_FOUND`.
+     */
+    [[nodiscard]]
+    int32_t findPattern(uint32_t key) const
+    {
+        if (key == INVALID_KEY || pattern_slots_.empty())
+        {
+            return NOT_FOUND;
+        }
+        size_t const mask = pattern_slots_.size() - 1;
+        for (size_t slot = hashKey_(key) & mask;; slot = (slot + 1) & mask)
+        {
+            uint64_t const entry = pattern_slots_[slot];
+            if (entry == EMPTY_SLOT_)
+            {
+                return NOT_FOUND;
+            }
+            if (static_cast<uint32_t>(entry >> 32) == key)
+            {
+                return static_cast<int32_t>(entry & UINT32_MAX);
+            }
+        }
+    }
+
+    /**
+     * @return number of circuits in the database.
+     */
+    [[nodiscard]]
+    size_t size() const
+    {
+        return operators_number_.size();
+    }
+
+    /**
+     * @return true iff the database is a memory-mapped binary image.
+     */
+    [[nodiscard]]
+    bool isMapped() const
+    {
+        return image_ != nullptr;
+    }
+
+    /**
+     * @return gates of circuit, which are numbered after its three inputs.
+     */
+    [[nodiscard]]
+    std::span<DBGate const> getGates(int32_t index) const
+    {
+        return gates_.subspan(gates_begin_[index], gates_begin_[index + 1] - gates_begin_[index]);
+    }
+
+    /**
+     * @return indices of outputs of circuit, in order of truth tables in its key.
+     */
+    [[nodiscard]]
+    std::span<uint16_t const> getOutputs(int32_t index) const
+    {
+        return outputs_.subspan(outputs_begin_[index], outputs_begin_[index + 1] - outputs_begin_[index]);
+    }
+
+    /**
+     * @return number of binary operators of circuit.
+     */
+    [[nodiscard]]
+    int32_t getOperatorsNumber(int32_t index) const
+    {
+        return operators_number_[index];
     }
 
     /**
@@ -66,8 +322,8 @@ struct CircuitDB
         // Creates ifstream object to read from the file whose path is passed as an argument.
         std::ifstream database(db_path);
 
-        int32_t subcircuit_index = 0;
-        size_t inputs_number     = 0;
+        std::vector<uint32_t> keys;
+        size_t inputs_number = 0;
 
         // A loop is started that continues as long as data can be read from the file.
         // The number of inputs is read first.
@@ -83,50 +339,193 @@ struct CircuitDB
             {
                 database >> outputs_patterns[i];
             }
-            subcircuit_pattern_to_index[outputs_patterns] = subcircuit_index;
+            keys.push_back(packPatterns(outputs_patterns));
 
             // Read the output indices and determine their maximum index for further gate parsing
-            std::vector<GateId> cur_outputs(outputs_number);
             GateId max_index = 0;
             for (size_t i = 0; i < outputs_number; ++i)
             {
-                database >> cur_outputs[i];
-                max_index = std::max(max_index, cur_outputs[i]);
+                GateId output = 0;
+                database >> output;
+                storage_.outputs.push_back(checkedIndex_(output));
+                max_index = std::max(max_index, output);
             }
-            subcircuit_outputs.push_back(cur_outputs);
+            storage_.outputs_begin.push_back(static_cast<uint32_t>(storage_.outputs.size()));
 
             // Parse gates
-            gates_operands.emplace_back();
-            gates_operations.emplace_back();
-            OPER_number.push_back(0);
-
+            storage_.operators_number.push_back(0);
             for (size_t i = inputs_number; i <= max_index; ++i)
             {
                 std::string operation;
-                GateIdContainer operands;
                 GateId operand_1 = 0;
                 GateId operand_2 = 0;
+                DBGate gate{};
 
                 // The database uses only basic gate types (i.e. it doesn't use IFF, BUFF, MUX, CONST_FALSE
                 // and CONST_TRUE), and also it works only with binary gates except for NOT, which is unary.
                 database >> operation;
-                gates_operations[subcircuit_index].push_back(csat::utils::stringToGateType(operation));
+                gate.type = csat::utils::stringToGateType(operation);
 
                 database >> operand_1;
-                operands.push_back(operand_1);
-                max_index = std::max(max_index, operand_1);
+                gate.operands[gate.operands_number++] = checkedIndex_(operand_1);
+                max_index                             = std::max(max_index, operand_1);
 
                 if (operation != "NOT")
                 {
                     database >> operand_2;
-                    operands.push_back(operand_2);
-                    max_index = std::max(max_index, operand_2);
-                    ++OPER_number[subcircuit_index];
+                    gate.operands[gate.operands_number++] = checkedIndex_(operand_2);
+                    max_index                             = std::max(max_index, operand_2);
+                    ++storage_.operators_number.back();
                 }
 
-                gates_operands[subcircuit_index].push_back(operands);
+                storage_.gates.push_back(gate);
+            }
+            storage_.gates_begin.push_back(static_cast<uint32_t>(storage_.gates.size()));
+        }
+
+        buildPatternIndex_(keys);
+
+        image_            = nullptr;
+        pattern_slots_    = storage_.pattern_slots;
+        gates_            = storage_.gates;
+        gates_begin_      = storage_.gates_begin;
+        outputs_          = storage_.outputs;
+        outputs_begin_    = storage_.outputs_begin;
+        operators_number_ = storage_.operators_number;
+    }
+
+  protected:
+    /* Offsets of arrays of a binary image in bytes, see `ImageHeader`. */
+    struct ImageLayout_
+    {
+        size_t pattern_slots    = 0;
+        size_t gates_begin      = 0;
+        size_t outputs_begin    = 0;
+        size_t operators_number = 0;
+        size_t outputs          = 0;
+        size_t gates            = 0;
+        size_t size             = 0;
+    };
+
+    static size_t alignedSize_(size_t bytes)
+    {
+        return (bytes + 7) & ~size_t{7};
+    }
+
+    static ImageLayout_ imageLayout_(ImageHeader const& header)
+    {
+        ImageLayout_ layout{};
+        size_t offset  = sizeof(ImageHeader);
+        auto const put = [&offset](size_t bytes)
+        {
+            size_t const begin = offset;
+            offset += alignedSize_(bytes);
+            return begin;
+        };
+        layout.pattern_slots    = put(header.slots_number * sizeof(uint64_t));
+        layout.gates_begin      = put((header.circuits_number + 1) * sizeof(uint32_t));
+        layout.outputs_begin    = put((header.circuits_number + 1) * sizeof(uint32_t));
+        layout.operators_number = put(header.circuits_number * sizeof(int32_t));
+        layout.outputs          = put(header.outputs_number * sizeof(uint16_t));
+        layout.gates            = put(header.gates_number * sizeof(DBGate));
+        layout.size             = offset;
+        return layout;
+    }
+
+    /**
+     * @return header of binary image at given path, or a zeroed header if file is too short.
+     */
+    static ImageHeader readImageHeader_(std::filesystem::path const& path)
+    {
+        ImageHeader header{};
+        std::ifstream file(path, std::ios::binary);
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            return ImageHeader{};
+        }
+        return header;
+    }
+
+    template<class T>
+    static void writeImageArray_(std::ofstream& image, std::span<T const> array)
+    {
+        static constexpr std::array<char, 8> padding{};
+        size_t const bytes = array.size_bytes();
+        image.write(reinterpret_cast<char const*>(array.data()), static_cast<std::streamsize>(bytes));
+        image.write(padding.data(), static_cast<std::streamsize>(alignedSize_(bytes) - bytes));
+    }
+
+    /**
+     * Maps binary image into memory and points views to its arrays. Aborts if image
+     * is not compatible with the current build or basis, see `isCompatibleImage`.
+     */
+    void mapImage_(std::filesystem::path const& image_path)
+    {
+        if (!isCompatibleImage(image_path, basis_))
+        {
+            std::cerr << "Database image " << image_path.string() << " is incompatible or corrupted, "
+                      << "recompile it from the text database." << std::endl;
+            std::abort();
+        }
+
+        image_ = std::make_unique<utils::MappedFile>(image_path.string(), utils::MappedFile::Access::RANDOM);
+        // Mapping is page-aligned and all offsets are multiples of 8, so arrays are properly aligned.
+        char const* data = image_->view().data();
+        ImageHeader header{};
+        std::memcpy(&header, data, sizeof(header));
+        ImageLayout_ const layout = imageLayout_(header);
+
+        pattern_slots_ = {reinterpret_cast<uint64_t const*>(data + layout.pattern_slots), header.slots_number};
+        gates_begin_ = {reinterpret_cast<uint32_t const*>(data + layout.gates_begin), header.circuits_number + 1};
+        outputs_begin_ = {reinterpret_cast<uint32_t const*>(data + layout.outputs_begin), header.circuits_number + 1};
+        operators_number_ = {reinterpret_cast<int32_t const*>(data + layout.operators_number), header.circuits_number};
+        outputs_          = {reinterpret_cast<uint16_t const*>(data + layout.outputs), header.outputs_number};
+        gates_            = {reinterpret_cast<DBGate const*>(data + layout.gates), header.gates_number};
+    }
+
+    static size_t hashKey_(uint32_t key)
+    {
+        // Fibonacci hashing spreads dense packed keys over the whole table.
+        return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    static uint16_t checkedIndex_(GateId index)
+    {
+        if (index > UINT16_MAX)
+        {
+            std::cerr << "Too large gate index " << index << " in the small-circuit database." << std::endl;
+            std::abort();
+        }
+        return static_cast<uint16_t>(index);
+    }
+
+    /**
+     * Builds hash table of given keys of circuits. If some key is repeated, the last
+     * circuit with such key is indexed. Load factor of the table is at most 1/2.
+     */
+    void buildPatternIndex_(std::vector<uint32_t> const& keys)
+    {
+        size_t capacity = 1;
+        while (capacity < 2 * keys.size())
+        {
+            capacity <<= 1;
+        }
+        std::vector<uint64_t>& slots = storage_.pattern_slots;
+        slots.assign(capacity, EMPTY_SLOT_);
+
+        size_t const mask = capacity - 1;
+        for (size_t index = 0; index < keys.size(); ++index)
+        {
+            if (keys[index] == INVALID_KEY)
+            {
+                continue;
+            }
+            size_t slot = hashKey_(keys[index]) & mask;
+            while (slots[slot] != EMPTY_SLOT_ && static_cast<uint32_t>(slots[slot] >> 32) != keys[index])
+            {
+                slot = (slot + 1) & mask;
             }
-            ++subcircuit_index;
+            slots[slot] = (static_cast<uint64_t>(keys[index]) << 32) | index;
         }
     }
 };
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+
+namespace csat::utils
+{
+
+using ColorId = size_t;
+
+/**
+ * Open addressing hash map from parents of a color (two or three gates in ascending order)
+ * to the color. The first two parents are packed into a single 64-bit key, and the third one
+ * is kept next to it, so the map is a single flat array, and neither keys nor lookups allocate
+ * memory. Gate ids and color ids must be less than `MAX_ID`.
+ */
+class ParentsHashMap
+{
+  public:
+    static constexpr ColorId NOT_FOUND = SIZE_MAX;
+    /* Third parent of colors of two parents. */
+    static constexpr GateId NO_PARENT = UINT32_MAX;
+    /* Upper bound of gate ids and color ids, which may be stored in the map. */
+    static constexpr size_t MAX_ID = UINT32_MAX;
+
+  protected:
+    static constexpr uint32_t EMPTY_SLOT_ = UINT32_MAX;
+
+    struct Slot_
+    {
+        uint64_t key   = 0;
+        uint32_t third = 0;
+        /* `EMPTY_SLOT_` if slot is empty. */
+        uint32_t color = EMPTY_SLOT_;
+    };
+
+    std::vector<Slot_> slots_ = std::vector<Slot_>(16);
+    size_t size_              = 0;
+
+  public:
+    /**
+     * @return color of parents, or `NOT_FOUND` if there is no such color.
+     */
+    [[nodiscard]]
+    ColorId find(GateId first, GateId second, GateId third = NO_PARENT) const
+    {
+        uint64_t const key = packKey_(first, second);
+        for (size_t slot = slotOf_(key, third);; slot = (slot + 1) & (slots_.size() - 1))
+        {
+            Slot_ const& entry = slots_[slot];
+            if (entry.color == EMPTY_SLOT_)
+            {
+                return NOT_FOUND;
+            }
+            if (entry.key == key && entry.third == third)
+            {
+                return entry.color;
+            }
+        }
+    }
+
+    /**
+     * Maps parents to the color. Parents must not be mapped yet.
+     */
+    void insert(GateId first, GateId second, GateId third, ColorId color)
+    {
+        if (third >= MAX_ID)
+        {
+            std::cerr << "ParentsHashMap supports gate ids less than " << MAX_ID << " only, got " << third << std::endl;
+            std::abort();
+        }
+        insertColor_(first, second, third, color);
+    }
+
+    void insert(GateId first, GateId second, ColorId color)
+    {
+        insertColor_(first, second, NO_PARENT, color);
+    }
+
+    [[nodiscard]]
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+  protected:
+    static uint64_t packKey_(GateId first, GateId second)
+    {
+        if (first >= MAX_ID || second >= MAX_ID)
+        {
+            std::cerr << "ParentsHashMap supports gate ids less than " << MAX_ID << " only, got " << first << " and "
+                      << second << std::endl;
+            std::abort();
+        }
+        return (static_cast<uint64_t>(first) << 32) | second;
+    }
+
+    [[nodiscard]]
+    size_t slotOf_(uint64_t key, uint64_t third) const
+    {
+        uint64_t hash = (key ^ (third << 16)) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 32;
+        return static_cast<size_t>(hash) & (slots_.size() - 1);
+    }
+
+    void insertColor_(GateId first, GateId second, GateId third, ColorId color)
+    {
+        if (color >= MAX_ID)
+        {
+            std::cerr << "ParentsHashMap supports color ids less than " << MAX_ID << " only, got " << color
+                      << std::endl;
+            std::abort();
+        }
+        if (2 * (size_ + 1) > slots_.size())
+        {
+            rehash_(2 * slots_.size());
+        }
+        insert_({packKey_(first, second), static_cast<uint32_t>(third), static_cast<uint32_t>(color)});
+        ++size_;
+    }
+
+    void insert_(Slot_ const& entry)
+    {
+        size_t slot = slotOf_(entry.key, entry.third);
+        while (slots_[slot].color != EMPTY_SLOT_)
+        {
+            slot = (slot + 1) & (slots_.size() - 1);
+        }
+        slots_[slot] = entry;
+    }
+
+    void rehash_(size_t capacity)
+    {
+        std::vector<Slot_> old_slots(capacity);
+        old_slots.swap(slots_);
+        for (Slot_ const& entry : old_slots)
+        {
+            if (entry.color != EMPTY_SLOT_)
+            {
+                insert_(entry);
+            }
+        }
+    }
+};
+
+}  // namespace csat::utils
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+
+namespace csat::simplification
+{
+
+/**
+ * Hash table of gate structures -- pairs of gate type and list of operands, which maps
+ * each structure to an id (e.g. of a gate, which has such structure). Lists of operands
+ * are compared as is, so they must be normalized by the caller (e.g. operands of symmetric
+ * operators must be sorted), if gates are considered up to the order of operands.
+ *
+ * Table uses open addressing with linear probing, keeps operands of all structures
+ * in a single flat array, and never allocates per structure.
+ */
+class StructuralHashTable
+{
+  public:
+    /* Marks absence of structure in the table. */
+    static constexpr GateId NOT_FOUND = SIZE_MAX;
+
+  protected:
+    /* Marks empty slot of the hash table. */
+    static constexpr size_t EMPTY_SLOT_ = SIZE_MAX;
+
+    struct Entry_
+    {
+        uint64_t hash          = 0;
+        size_t operands_begin  = 0;
+        size_t operands_number = 0;
+        GateId value           = NOT_FOUND;
+        GateType type          = GateType::UNDEFINED;
+    };
+
+    /* Slots of the hash table, each holds index of entry or `EMPTY_SLOT_`. */
+    std::vector<size_t> slots_{};
+    /* Stored structures, including erased ones, whose value is `NOT_FOUND`. */
+    std::vector<Entry_> entries_{};
+    /* Operands of all stored structures. */
+    GateIdContainer operands_{};
+    /* Number of stored structures, which were not erased. */
+    size_t size_ = 0;
+
+  public:
+    /**
+     * @param expected_size -- number of structures, which may be inserted without rehashing.
+     */
+    explicit StructuralHashTable(size_t expected_size = 0)
+    {
+        reserve(expected_size);
+    }
+
+    /**
+     * Prepares table to store `expected_size` structures without rehashing.
+     */
+    void reserve(size_t expected_size)
+    {
+        entries_.reserve(expected_size);
+        operands_.reserve(2 * expected_size);
+        if (2 * expected_size > slots_.size())
+        {
+            rehash_(expected_size);
+        }
+    }
+
+    /**
+     * @return number of stored structures.
+     */
+    [[nodiscard]]
+    size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * Removes all structures from the table, keeping allocated memory.
+     */
+    void clear()
+    {
+        std::fill(slots_.begin(), slots_.end(), EMPTY_SLOT_);
+        entries_.clear();
+        operands_.clear();
+        size_ = 0;
+    }
+
+    /**
+     * @return id of structure, or `NOT_FOUND` if there is no such structure in the table.
+     */
+    [[nodiscard]]
+    GateId find(GateType type, std::span<GateId const> operands) const
+    {
+        if (slots_.empty())
+        {
+            return NOT_FOUND;
+        }
+        size_t const slot = findSlot_(type, operands, hash(type, operands));
+        return slots_[slot] == EMPTY_SLOT_ ? NOT_FOUND : entries_[slots_[slot]].value;
+    }
+
+    /**
+     * Looks up a structure, and inserts it with id `value`, if it is not in the table yet.
+     * Value must differ from `NOT_FOUND`.
+     * @return id of found structure, or `value` if structure was inserted.
+     */
+    GateId findOrInsert(GateType type, std::span<GateId const> operands, GateId value)
+    {
+        return findOrInsert(type, operands, value, hash(type, operands));
+    }
+
+    /**
+     * Same as `findOrInsert` above, but takes a hash of the structure, which was computed in
+     * advance by `hash` (e.g. for many structures in parallel).
+     */
+    GateId findOrInsert(GateType type, std::span<GateId const> operands, GateId value, uint64_t hash)
+    {
+        // Erased structures are dropped on rehashing, so they don't pile up either.
+        if (2 * (size_ + 1) > slots_.size() || entries_.size() >= slots_.size())
+        {
+            rehash_(std::max<size_t>(2 * size_, 8));
+        }
+        size_t const slot = findSlot_(type, operands, hash);
+        if (slots_[slot] != EMPTY_SLOT_)
+        {
+            return entries_[slots_[slot]].value;
+        }
+
+        slots_[slot] = entries_.size();
+        entries_.push_back({hash, operands_.size(), operands.size(), value, type});
+        operands_.insert(operands_.end(), operands.begin(), operands.end());
+        ++size_;
+        return value;
+    }
+
+    /**
+     * Removes structure from the table, if it is there.
+     * @return true iff structure was removed.
+     */
+    bool erase(GateType type, std::span<GateId const> operands)
+    {
+        if (slots_.empty())
+        {
+            return false;
+        }
+        size_t hole = findSlot_(type, operands, hash(type, operands));
+        if (slots_[hole] == EMPTY_SLOT_)
+        {
+            return false;
+        }
+        entries_[slots_[hole]].value = NOT_FOUND;
+        --size_;
+
+        // Backward shift deletion keeps probe sequences of other structures unbroken.
+        size_t const mask = slots_.size() - 1;
+        for (size_t next = (hole + 1) & mask; slots_[next] != EMPTY_SLOT_; next = (next + 1) & mask)
+        {
+            size_t const ideal = entries_[slots_[next]].hash & mask;
+            if (((next - ideal) & mask) >= ((next - hole) & mask))
+            {
+                slots_[hole] = slots_[next];
+                hole         = next;
+            }
+        }
+        slots_[hole] = EMPTY_SLOT_;
+        return true;
+    }
+
+    /**
+     * @return hash of structure, which is used by the table. Hash doesn't depend on the
+     * table, so it may be computed concurrently.
+     */
+    static uint64_t hash(GateType type, std::span<GateId const> operands)
+    {
+        uint64_t hash = static_cast<uint64_t>(type) + 1;
+        for (GateId const operand : operands)
+        {
+            hash = (hash ^ static_cast<uint64_t>(operand)) * 0x9E3779B97F4A7C15ULL;
+            hash ^= hash >> 32;
+        }
+        return hash;
+    }
+
+  protected:
+    [[nodiscard]]
+    bool equals_(Entry_ const& entry, GateType type, std::span<GateId const> operands) const
+    {
+        return entry.type == type && entry.operands_number == operands.size() &&
+               std::equal(operands.begin(), operands.end(), operands_.begin() + entry.operands_begin);
+    }
+
+    /**
+     * @return slot of the structure, or the empty slot, where it may be inserted.
+     */
+    [[nodiscard]]
+    size_t findSlot_(GateType type, std::span<GateId const> operands, uint64_t hash) const
+    {
+        size_t const mask = slots_.size() - 1;
+        size_t slot       = hash & mask;
+        while (slots_[slot] != EMPTY_SLOT_)
+        {
+            Entry_ const& entry = entries_[slots_[slot]];
+            if (entry.hash == hash && equals_(entry, type, operands))
+            {
+                return slot;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    /**
+     * Rebuilds table with load factor at most 1/2 for `expected_size` structures,
+     * and drops erased structures.
+     */
+    void rehash_(size_t expected_size)
+    {
+        size_t capacity = 1;
+        while (capacity < 2 * std::max(expected_size, size_))
+        {
+            capacity <<= 1;
+        }
+
+        std::vector<Entry_> entries{};
+        GateIdContainer operands{};
+        entries.reserve(std::max(entries_.capacity(), size_));
+        operands.reserve(operands_.capacity());
+        for (Entry_ const& entry : entries_)
+        {
+            if (entry.value != NOT_FOUND)
+            {
+                entries.push_back(entry);
+                entries.back().operands_begin = operands.size();
+                operands.insert(
+                    operands.end(),
+                    operands_.begin() + entry.operands_begin,
+                    operands_.begin() + entry.operands_begin + entry.operands_number);
+            }
+        }
+        entries_  = std::move(entries);
+        operands_ = std::move(operands);
+
+        slots_.assign(capacity, EMPTY_SLOT_);
+        size_t const mask = capacity - 1;
+        for (size_t index = 0; index < entries_.size(); ++index)
+        {
+            size_t slot = entries_[index].hash & mask;
+            while (slots_[slot] != EMPTY_SLOT_)
+            {
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = index;
+        }
+    }
+};
+
+}  // namespace csat::simplification
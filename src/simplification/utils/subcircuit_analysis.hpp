@@ -0,0 +1,404 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/simplification/utils/circuits_db.hpp"
+#include "src/simplification/utils/three_coloring.hpp"
+#include "src/simplification/utils/truth_table.hpp"
+#include "src/simplification/utils/two_coloring.hpp"
+#include "src/utility/profiler.hpp"
+
+namespace csat::simplification
+{
+
+/**
+ * Result of the analysis of a three inputs subcircuit, which is defined by a color. Analysis
+ * only reads the circuit, its colorings and the database, so subcircuits of all colors may be
+ * analysed concurrently, while rewrites, which are found by the analysis, are applied to the
+ * circuit afterwards in order of colors.
+ */
+struct SubcircuitAnalysis
+{
+    /* Replacement of an output of subcircuit by a constant, a parent or another output. */
+    struct Rewrite
+    {
+        GateId gate;
+        GateType type;
+        GateId first_operand;
+        /* SIZE_MAX for unary operations. */
+        GateId second_operand;
+        /* Whether gate is counted as modified, i.e. its operation was actually changed. */
+        bool modified;
+    };
+
+    enum class Verdict
+    {
+        MANY_OUTPUTS,
+        NOT_IN_DB,
+        FOUND
+    };
+
+    /* Gates of subcircuit, except parents, in order of evaluation. Gate may occur several times. */
+    GateIdContainer gates;
+    /* Sorted parents and gates of subcircuit, their truth tables and whether table is evaluated. */
+    GateIdContainer members;
+    std::vector<utils::TruthTable3> tables;
+    BoolVector evaluated;
+    /*
+     * False if some gate reads truth table of a gate, which is not evaluated within subcircuit.
+     * Such subcircuit is not described by its parents, so it is neither rewritten nor looked up.
+     */
+    bool closed = true;
+
+    std::vector<Rewrite> rewrites;
+    /* Gates, which compute a constant or a parent (except negations of parents, which are left as is). */
+    GateIdContainer primitive_gates;
+    /* Gates of subcircuit, which are used outside of it. */
+    GateIdContainer all_outputs;
+
+    Verdict verdict = Verdict::NOT_IN_DB;
+    int32_t pattern_index = CircuitDB::NOT_FOUND;
+    /* Permutation of parents, under which subcircuit is found in database. */
+    size_t permutation = 0;
+    /* Gate of subcircuit, which computes each output of database pattern, or SIZE_MAX. */
+    GateIdContainer pattern_output_gates;
+    /* Number of operators in subcircuit, which is compared with size of database pattern. */
+    int32_t operators_number = 0;
+
+    /**
+     * Resets analysis, keeping memory of its containers.
+     */
+    void clear()
+    {
+        gates.clear();
+        members.clear();
+        tables.clear();
+        evaluated.clear();
+        closed = true;
+        rewrites.clear();
+        primitive_gates.clear();
+        all_outputs.clear();
+        verdict          = Verdict::NOT_IN_DB;
+        pattern_index    = CircuitDB::NOT_FOUND;
+        permutation      = 0;
+        pattern_output_gates.clear();
+        operators_number = 0;
+    }
+
+    /**
+     * @return index of gate in `members`, or SIZE_MAX if gate is not a member of subcircuit.
+     */
+    [[nodiscard]]
+    size_t findMember(GateId gateId) const
+    {
+        auto const it = std::lower_bound(members.begin(), members.end(), gateId);
+        return it != members.end() && *it == gateId ? static_cast<size_t>(it - members.begin()) : SIZE_MAX;
+    }
+};
+
+/**
+ * Finds operation, which computes given truth table as a constant or as a parent of subcircuit.
+ * @return true iff truth table is primitive.
+ */
+inline bool primitiveRewrite_(
+    utils::TruthTable3 table,
+    utils::ThreeColor const& color,
+    SubcircuitAnalysis::Rewrite& rewrite)
+{
+    rewrite.second_operand = SIZE_MAX;
+    switch (table)
+    {
+        case 0:
+            rewrite.type           = GateType::XOR;
+            rewrite.first_operand  = color.first_parent;
+            rewrite.second_operand = color.first_parent;
+            return true;
+        case 255:
+            rewrite.type           = GateType::NXOR;
+            rewrite.first_operand  = color.first_parent;
+            rewrite.second_operand = color.first_parent;
+            return true;
+        case 240:
+            rewrite.type           = GateType::AND;
+            rewrite.first_operand  = color.first_parent;
+            rewrite.second_operand = color.first_parent;
+            return true;
+        case 204:
+            rewrite.type           = GateType::AND;
+            rewrite.first_operand  = color.second_parent;
+            rewrite.second_operand = color.second_parent;
+            return true;
+        case 170:
+            rewrite.type           = GateType::AND;
+            rewrite.first_operand  = color.third_parent;
+            rewrite.second_operand = color.third_parent;
+            return true;
+        case 15:
+            rewrite.type          = GateType::NOT;
+            rewrite.first_operand = color.first_parent;
+            return true;
+        case 51:
+            rewrite.type          = GateType::NOT;
+            rewrite.first_operand = color.second_parent;
+            return true;
+        case 85:
+            rewrite.type          = GateType::NOT;
+            rewrite.first_operand = color.third_parent;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Analyses subcircuit of a color: collects its gates, evaluates their truth tables, finds outputs,
+ * which are equal to constants, parents or other outputs, and looks the subcircuit up in database.
+ *
+ * Truth tables are kept within the analysis. If a gate reads truth table of a gate, which is not
+ * evaluated within the subcircuit, the analysis is marked as not closed, and neither rewrites nor
+ * primitive gates are reported for it.
+ *
+ * @param circuit -- circuit, which is simplified.
+ * @param color -- color, which defines subcircuit.
+ * @param two_coloring -- two coloring of the circuit.
+ * @param negation_users -- NOT user of each gate or `SIZE_MAX`, see `ThreeColoring::negationUsers`.
+ * @param db -- database of subcircuits of the basis.
+ * @param basis -- basis of the circuit. In AIG basis operators are AND gates, otherwise binary gates.
+ * @param analysis -- result of the analysis.
+ */
+template<class CircuitT>
+void analyzeSubcircuit(
+    CircuitT const& circuit,
+    utils::ThreeColor const& color,
+    utils::TwoColoring const& two_coloring,
+    GateIdContainer const& negation_users,
+    CircuitDB const& db,
+    Basis basis,
+    SubcircuitAnalysis& analysis)
+{
+    CSAT_PROFILE_SCOPE("SubcircuitAnalysis::analyze");
+    analysis.clear();
+    GateIdContainer& gates = analysis.gates;
+
+    // Getting gates depending from 1 of parents
+    for (GateId const parent : color.getParents())
+    {
+        GateId const negation_user = negation_users.at(parent);
+        if (negation_user != SIZE_MAX)
+        {
+            gates.push_back(negation_user);
+        }
+    }
+
+    // Getting gates depending from 2 of parents
+    auto const add_two_color_gates = [&gates, &two_coloring](GateId first_parent, GateId second_parent)
+    {
+        utils::ColorId const two_color = two_coloring.parentsToColor.find(first_parent, second_parent);
+        if (two_color != utils::ParentsHashMap::NOT_FOUND)
+        {
+            GateIdContainer const& two_color_gates = two_coloring.colors.at(two_color).getGates();
+            gates.insert(gates.end(), two_color_gates.begin(), two_color_gates.end());
+        }
+    };
+    add_two_color_gates(color.first_parent, color.second_parent);
+    add_two_color_gates(color.first_parent, color.third_parent);
+    add_two_color_gates(color.second_parent, color.third_parent);
+
+    // Getting gates depending from all parents
+    gates.insert(gates.end(), color.getGates().begin(), color.getGates().end());
+
+    analysis.members.assign(gates.begin(), gates.end());
+    analysis.members.insert(analysis.members.end(), {color.first_parent, color.second_parent, color.third_parent});
+    std::sort(analysis.members.begin(), analysis.members.end());
+    analysis.members.erase(
+        std::unique(analysis.members.begin(), analysis.members.end()), analysis.members.end());
+    analysis.tables.assign(analysis.members.size(), 0);
+    analysis.evaluated.assign(analysis.members.size(), false);
+
+    auto const write_table = [&analysis](GateId gateId, utils::TruthTable3 table)
+    {
+        size_t const member        = analysis.findMember(gateId);
+        analysis.tables[member]    = table;
+        analysis.evaluated[member] = true;
+    };
+    auto const read_table = [&analysis](GateId gateId) -> utils::TruthTable3
+    {
+        size_t const member = analysis.findMember(gateId);
+        if (member != SIZE_MAX && analysis.evaluated[member])
+        {
+            return analysis.tables[member];
+        }
+        analysis.closed = false;
+        return 0;
+    };
+
+    /*
+     * Gate's pattern describes it in terms of truth table:
+     * For all 8 combinations of inputs assignments we look at the resulting
+     * value in the following gate.
+     * This process is done for all inputs permutations (3! = 6)
+     * Constants: 240, 204, 170 - describe initial inputs patterns
+     */
+    // Truth tables are evaluated on the identity permutation of parents only, since
+    // truth tables on other permutations are mere permutations of their bits.
+    write_table(color.first_parent, utils::FIRST_INPUT_TT);
+    write_table(color.second_parent, utils::SECOND_INPUT_TT);
+    write_table(color.third_parent, utils::THIRD_INPUT_TT);
+
+    std::vector<std::vector<int32_t>> output_patterns(utils::INPUTS_PERMUTATIONS_NUMBER);
+    // Outputs in observed subcircuit (Some 'real' outputs will be removed according to our heuristic)
+    GateIdContainer outputs;
+
+    /**
+     * New Heuristic (!!!)
+     * We do not need all the outputs to be real outputs
+     * As we minimize ANDs number, outputs that are the negations of another outputs
+     * or negations of inputs gate are useless to count them
+     * we can just manually add them as NOT(x) where x is the following gate or copy from parents
+     *
+     * @return true iff gate becomes a new output of subcircuit.
+     */
+    auto const process_output = [&](GateId gateId, utils::TruthTable3 table, GateType oper, GateIdSpan operands)
+    {
+        analysis.all_outputs.push_back(gateId);
+        SubcircuitAnalysis::Rewrite rewrite{gateId, GateType::UNDEFINED, SIZE_MAX, SIZE_MAX, true};
+        if (primitiveRewrite_(table, color, rewrite))
+        {
+            // Negations of parents are counted as modified only if they were not such negations before.
+            if (rewrite.type == GateType::NOT)
+            {
+                rewrite.modified = oper != GateType::NOT || operands[0] != rewrite.first_operand;
+            }
+            analysis.rewrites.push_back(rewrite);
+            return false;
+        }
+        for (size_t i = 0; i < output_patterns[0].size(); ++i)
+        {
+            int const output_pattern = output_patterns[0][i];
+            if (table == output_pattern)
+            {
+                analysis.rewrites.push_back({gateId, GateType::AND, outputs[i], outputs[i], true});
+                return false;
+            }
+            if (table == 255 - output_pattern)
+            {
+                /**
+                 * Check whether we have changed the operation for the gate
+                 * We do this in order not to add modified status for unchanged gates
+                 */
+                if (oper != GateType::NOT || operands[0] != outputs[i])
+                {
+                    analysis.rewrites.push_back({gateId, GateType::NOT, outputs[i], SIZE_MAX, true});
+                }
+                return false;
+            }
+        }
+
+        outputs.push_back(gateId);
+        for (size_t i = 0; i < utils::INPUTS_PERMUTATIONS_NUMBER; ++i)
+        {
+            output_patterns[i].push_back(utils::permuteTruthTable(i, table));
+        }
+        return true;
+    };
+
+    // Getting outputs of the following subcircuit (and check that all gates exist)
+    for (GateId const gateId : gates)
+    {
+        GateIdSpan const operands = circuit.getGateOperands(gateId);
+        GateType const oper       = circuit.getGateType(gateId);
+
+        utils::TruthTable3 const first_table  = read_table(operands[0]);
+        utils::TruthTable3 const second_table = read_table(operands[operands.size() - 1]);
+        utils::TruthTable3 table              = 0;
+        if ((basis == Basis::AIG && oper != GateType::AND && oper != GateType::NOT) ||
+            !utils::evaluateTruthTable(oper, first_table, second_table, table))
+        {
+            std::cerr << "Error! Incorrect operation!" << std::endl;
+            std::abort();
+        }
+        write_table(gateId, table);
+
+        if (table == 0 || table == 255 || table == 240 || table == 204 || table == 170 ||
+            (table == 15 && (oper != GateType::NOT || operands[0] != color.first_parent)) ||
+            (table == 51 && (oper != GateType::NOT || operands[0] != color.second_parent)) ||
+            (table == 85 && (oper != GateType::NOT || operands[0] != color.third_parent)))
+        {
+            analysis.primitive_gates.push_back(gateId);
+        }
+
+        if (circuit.isOutputGate(gateId))
+        {
+            process_output(gateId, table, oper, operands);
+            continue;
+        }
+        for (GateId const user : circuit.getGateUsers(gateId))
+        {
+            // Gate is an output, if it has a user outside of subcircuit.
+            if (analysis.findMember(user) == SIZE_MAX && process_output(gateId, table, oper, operands))
+            {
+                break;
+            }
+        }
+    }
+
+    if (!analysis.closed)
+    {
+        analysis.rewrites.clear();
+        analysis.primitive_gates.clear();
+        return;
+    }
+
+    if (outputs.size() > CircuitDB::MAX_OUTPUTS)
+    {
+        analysis.verdict = SubcircuitAnalysis::Verdict::MANY_OUTPUTS;
+        return;
+    }
+
+    for (size_t i = 0; i < utils::INPUTS_PERMUTATIONS_NUMBER; ++i)
+    {
+        std::sort(output_patterns[i].begin(), output_patterns[i].end());
+        analysis.pattern_index = db.findPattern(CircuitDB::packPatterns(output_patterns[i]));
+        if (analysis.pattern_index != CircuitDB::NOT_FOUND)
+        {
+            analysis.permutation = i;
+            break;
+        }
+    }
+    if (analysis.pattern_index == CircuitDB::NOT_FOUND)
+    {
+        analysis.verdict = SubcircuitAnalysis::Verdict::NOT_IN_DB;
+        return;
+    }
+    analysis.verdict = SubcircuitAnalysis::Verdict::FOUND;
+
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        GateId pattern_output_gate = SIZE_MAX;
+        for (GateId const output : outputs)
+        {
+            if (utils::permuteTruthTable(analysis.permutation, read_table(output)) ==
+                output_patterns[analysis.permutation][i])
+            {
+                pattern_output_gate = output;
+            }
+        }
+        analysis.pattern_output_gates.push_back(pattern_output_gate);
+    }
+
+    for (GateId const gateId : gates)
+    {
+        bool const is_operator = basis == Basis::AIG ? circuit.getGateType(gateId) == GateType::AND
+                                                     : circuit.getGateOperands(gateId).size() == 2;
+        analysis.operators_number += is_operator ? 1 : 0;
+    }
+}
+
+}  // namespace csat::simplification
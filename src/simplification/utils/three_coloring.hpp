@@ -1,23 +1,25 @@
 #pragma once
 
+#include <array>
 #include <cassert>
+#include <cstdlib>
+#include <iostream>
 #include <memory>
 #include <ranges>
 #include <type_traits>
-#include <unordered_map>
 #include <vector>
 
 #include "src/algo.hpp"
 #include "src/common/csat_types.hpp"
 #include "src/simplification/transformer_base.hpp"
+#include "src/simplification/utils/parents_hash_map.hpp"
 #include "src/simplification/utils/two_coloring.hpp"
 #include "src/utility/converters.hpp"
+#include "src/utility/profiler.hpp"
 
 namespace csat::utils
 {
 
-using ColorId = size_t;
-
 /**
  * Class for selecting a subcircuit of three inputs and the gates that use them. To distinguish
  * this subcircuit from the other gates of the circuit, we will put color marks. If the gates
@@ -38,10 +40,10 @@ struct ThreeColor
   public:
     ThreeColor(GateId parent_one, GateId parent_two, GateId parent_three)
     {
-        GateIdContainer parents = ThreeColor::sortedParents(parent_one, parent_two, parent_three);
-        first_parent            = parents[0];
-        second_parent           = parents[1];
-        third_parent            = parents[2];
+        auto const parents = ThreeColor::sortedParents(parent_one, parent_two, parent_three);
+        first_parent       = parents[0];
+        second_parent      = parents[1];
+        third_parent       = parents[2];
     }
 
     void addGate(GateId gateId)
@@ -56,7 +58,7 @@ struct ThreeColor
     }
 
     [[nodiscard]]
-    GateIdContainer getParents() const
+    std::array<GateId, 3> getParents() const
     {
         return {first_parent, second_parent, third_parent};
     }
@@ -67,23 +69,74 @@ struct ThreeColor
         return first_parent == gateId || second_parent == gateId || third_parent == gateId;
     }
 
-    static GateIdContainer sortedParents(GateId parent_one, GateId parent_two, GateId parent_three)
+    static std::array<GateId, 3> sortedParents(GateId parent_one, GateId parent_two, GateId parent_three)
     {
-        GateIdContainer parents = {parent_one, parent_two, parent_three};
+        std::array<GateId, 3> parents = {parent_one, parent_two, parent_three};
         std::sort(parents.begin(), parents.end());
         return parents;
     }
 };
 
+/**
+ * Colors of a gate. Gate has at most two colors, so they are stored inline.
+ */
+class GateColors
+{
+  protected:
+    /* Unused entries are 'SIZE_MAX'. */
+    std::array<ColorId, 2> colors_{SIZE_MAX, SIZE_MAX};
+
+  public:
+    void add(ColorId colorId)
+    {
+        if (colors_[1] != SIZE_MAX)
+        {
+            std::cerr << "Gate can't have more than two colors." << std::endl;
+            std::abort();
+        }
+        colors_[colors_[0] == SIZE_MAX ? 0 : 1] = colorId;
+    }
+
+    [[nodiscard]]
+    size_t size() const noexcept
+    {
+        return colors_[0] == SIZE_MAX ? 0 : (colors_[1] == SIZE_MAX ? 1 : 2);
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+        return colors_[0] == SIZE_MAX;
+    }
+
+    [[nodiscard]]
+    ColorId operator[](size_t index) const noexcept
+    {
+        return colors_[index];
+    }
+
+    [[nodiscard]]
+    ColorId const* begin() const noexcept
+    {
+        return colors_.data();
+    }
+
+    [[nodiscard]]
+    ColorId const* end() const noexcept
+    {
+        return colors_.data() + size();
+    }
+};
+
 /**
  * Сlass for coloring the whole circuit.
  */
 class ThreeColoring
 {
   public:
-    std::vector<ThreeColor> colors;                         // list of all colors
-    std::vector<std::vector<ColorId>> gateColors;           // contains up to 2 colors for each gate
-    std::map<std::vector<GateId>, ColorId> parentsToColor;  // takes parent ids in ascdending order
+    std::vector<ThreeColor> colors;      // list of all colors
+    std::vector<GateColors> gateColors;  // contains up to 2 colors for each gate
+    ParentsHashMap parentsToColor;       // takes parent ids in ascdending order
     GateIdContainer negationUsers;
 
     /**
@@ -108,9 +161,10 @@ class ThreeColoring
      */
     ColorId addColor(GateId first_parent, GateId second_parent, GateId third_parent)
     {
+        CSAT_PROFILE_COUNT("ThreeColoring::colors", 1);
         colors.emplace_back(first_parent, second_parent, third_parent);
-        GateIdContainer const sortedParents = ThreeColor::sortedParents(first_parent, second_parent, third_parent);
-        parentsToColor[sortedParents]       = next_color_id_;
+        auto const parents = ThreeColor::sortedParents(first_parent, second_parent, third_parent);
+        parentsToColor.insert(parents[0], parents[1], parents[2], next_color_id_);
         return next_color_id_++;
     }
 
@@ -122,7 +176,21 @@ class ThreeColoring
     void paintGate(GateId gateId, ColorId colorId)
     {
         colors.at(colorId).addGate(gateId);
-        gateColors.at(gateId).push_back(colorId);
+        gateColors.at(gateId).add(colorId);
+    }
+
+    /**
+     * Finds color of three parents, or creates it if there is no such color yet.
+     * @param parent_one -- first input
+     * @param parent_two -- second input
+     * @param parent_three -- third input
+     * @return color ID
+     */
+    ColorId findOrAddColor(GateId parent_one, GateId parent_two, GateId parent_three)
+    {
+        auto const parents  = ThreeColor::sortedParents(parent_one, parent_two, parent_three);
+        ColorId const color = parentsToColor.find(parents[0], parents[1], parents[2]);
+        return color != ParentsHashMap::NOT_FOUND ? color : addColor(parents[0], parents[1], parents[2]);
     }
 
   public:
@@ -130,20 +198,28 @@ class ThreeColoring
      * Painting the whole circuit.
      */
     explicit ThreeColoring(ICircuit const& circuit)
+        : ThreeColoring(circuit, TwoColoring(circuit))
     {
+    }
+
+    /**
+     * Painting the whole circuit, reusing its two coloring.
+     * @param circuit -- circuit to paint
+     * @param twoColoring -- two coloring of the same circuit
+     */
+    ThreeColoring(ICircuit const& circuit, TwoColoring const& twoColoring)
+    {
+        CSAT_PROFILE_SCOPE("ThreeColoring::ThreeColoring");
         // Top sort and some preparations
         csat::GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(circuit));
         size_t const circuit_size = circuit.getNumberOfGates();
         gateColors.resize(circuit_size, {});
         negationUsers.resize(circuit_size, SIZE_MAX);
 
-        // Color circuit in two colors
-        TwoColoring twoColoring = TwoColoring(circuit);
-
         // Painting process in three color start from input to output
         for (uint64_t const gateId : std::ranges::reverse_view(gate_sorting))
         {
-            GateIdContainer const& operands = circuit.getGateOperands(gateId);
+            GateIdSpan const operands = circuit.getGateOperands(gateId);
 
             // Gate is input or constant
             if (operands.empty())
@@ -276,12 +352,7 @@ class ThreeColoring
                     }
                     else
                     {
-                        GateIdContainer color_parents = ThreeColor::sortedParents(parent_1, parent_2, child_2);
-                        if (parentsToColor.find(color_parents) == parentsToColor.end())
-                        {
-                            addColor(color_parents[0], color_parents[1], color_parents[2]);
-                        }
-                        paintGate(gateId, parentsToColor[color_parents]);
+                        paintGate(gateId, findOrAddColor(parent_1, parent_2, child_2));
                     }
                 }
                 continue;
@@ -314,12 +385,7 @@ class ThreeColoring
                     }
                     else
                     {
-                        GateIdContainer color_parents = ThreeColor::sortedParents(parent_1, parent_2, child_1);
-                        if (parentsToColor.find(color_parents) == parentsToColor.end())
-                        {
-                            addColor(color_parents[0], color_parents[1], color_parents[2]);
-                        }
-                        paintGate(gateId, parentsToColor[color_parents]);
+                        paintGate(gateId, findOrAddColor(parent_1, parent_2, child_1));
                     }
                 }
                 continue;
@@ -392,63 +458,36 @@ class ThreeColoring
                 // in the existing color of these parents or in the newly created color.
                 if (twoColoring.colors.at(second_child_two_color).hasParent(parent_1))
                 {
-                    GateIdContainer color_parents = ThreeColor::sortedParents(parent_2, parent_3, parent_4);
-                    if (parentsToColor.find(color_parents) == parentsToColor.end())
-                    {
-                        addColor(color_parents[0], color_parents[1], color_parents[2]);
-                    }
-                    paintGate(gateId, parentsToColor[color_parents]);
+                    paintGate(gateId, findOrAddColor(parent_2, parent_3, parent_4));
                 }
                 else if (twoColoring.colors.at(second_child_two_color).hasParent(parent_2))
                 {
-                    GateIdContainer color_parents = ThreeColor::sortedParents(parent_1, parent_3, parent_4);
-                    if (parentsToColor.find(color_parents) == parentsToColor.end())
-                    {
-                        addColor(color_parents[0], color_parents[1], color_parents[2]);
-                    }
-                    paintGate(gateId, parentsToColor[color_parents]);
+                    paintGate(gateId, findOrAddColor(parent_1, parent_3, parent_4));
                 }
                 else
                 {
                     // Else create containers for two colors with parents that includes the first and second parent
                     // of the first color and one of the parents of our gate color, and color the current gate.
-                    GateIdContainer color_parents = ThreeColor::sortedParents(parent_1, parent_2, child_2);
-                    if (parentsToColor.find(color_parents) == parentsToColor.end())
-                    {
-                        addColor(color_parents[0], color_parents[1], color_parents[2]);
-                    }
-                    paintGate(gateId, parentsToColor[color_parents]);
+                    paintGate(gateId, findOrAddColor(parent_1, parent_2, child_2));
 
-                    color_parents = ThreeColor::sortedParents(parent_3, parent_4, child_1);
-                    if (parentsToColor.find(color_parents) == parentsToColor.end())
-                    {
-                        addColor(color_parents[0], color_parents[1], color_parents[2]);
-                    }
-                    paintGate(gateId, parentsToColor[color_parents]);
+                    paintGate(gateId, findOrAddColor(parent_3, parent_4, child_1));
                 }
                 continue;
             }
 
             // Create new color or paint gate in the color of three parents
-            GateIdContainer color_parents = {};
             if (first_child_two_color != SIZE_MAX)
             {
                 GateId const parent_1 = twoColoring.colors.at(first_child_two_color).first_parent;
                 GateId const parent_2 = twoColoring.colors.at(first_child_two_color).second_parent;
-                color_parents         = ThreeColor::sortedParents(parent_1, parent_2, child_2);
+                paintGate(gateId, findOrAddColor(parent_1, parent_2, child_2));
             }
             else
             {
                 GateId const parent_1 = twoColoring.colors.at(second_child_two_color).first_parent;
                 GateId const parent_2 = twoColoring.colors.at(second_child_two_color).second_parent;
-                color_parents         = ThreeColor::sortedParents(parent_1, parent_2, child_1);
-            }
-
-            if (parentsToColor.find(color_parents) == parentsToColor.end())
-            {
-                addColor(color_parents[0], color_parents[1], color_parents[2]);
+                paintGate(gateId, findOrAddColor(parent_1, parent_2, child_1));
             }
-            paintGate(gateId, parentsToColor[color_parents]);
         }
     }
 };
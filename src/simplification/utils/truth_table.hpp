@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "src/common/csat_types.hpp"
+
+namespace csat::utils
+{
+
+/**
+ * Truth table of a boolean function of three inputs. Bit `4a + 2b + c`
+ * holds value of the function on the assignment `(a, b, c)`.
+ */
+using TruthTable3 = uint8_t;
+
+/* Truth tables of the first, second and third input respectively. */
+constexpr TruthTable3 FIRST_INPUT_TT  = 240;
+constexpr TruthTable3 SECOND_INPUT_TT = 204;
+constexpr TruthTable3 THIRD_INPUT_TT  = 170;
+
+/* Number of permutations of three inputs. */
+constexpr size_t INPUTS_PERMUTATIONS_NUMBER = 6;
+
+/**
+ * Truth tables, assigned to the first, second and third input under each permutation of inputs.
+ * Permutation `0` is the identity, which is used for evaluation of subcircuits.
+ */
+constexpr std::array<std::array<TruthTable3, 3>, INPUTS_PERMUTATIONS_NUMBER> INPUTS_PERMUTATIONS{
+    {{FIRST_INPUT_TT, SECOND_INPUT_TT, THIRD_INPUT_TT},
+     {FIRST_INPUT_TT, THIRD_INPUT_TT, SECOND_INPUT_TT},
+     {SECOND_INPUT_TT, FIRST_INPUT_TT, THIRD_INPUT_TT},
+     {SECOND_INPUT_TT, THIRD_INPUT_TT, FIRST_INPUT_TT},
+     {THIRD_INPUT_TT, FIRST_INPUT_TT, SECOND_INPUT_TT},
+     {THIRD_INPUT_TT, SECOND_INPUT_TT, FIRST_INPUT_TT}}
+};
+
+/**
+ * Builds table, which maps truth table of a gate, evaluated on the identity permutation
+ * of inputs, to its truth table, evaluated on each of `INPUTS_PERMUTATIONS`. Since gates
+ * operate bitwise, a permutation of inputs is a mere permutation of truth table bits.
+ */
+constexpr std::array<std::array<TruthTable3, 256>, INPUTS_PERMUTATIONS_NUMBER> buildTruthTablePermutations_()
+{
+    std::array<std::array<TruthTable3, 256>, INPUTS_PERMUTATIONS_NUMBER> permutations{};
+    for (size_t permutation = 0; permutation < INPUTS_PERMUTATIONS_NUMBER; ++permutation)
+    {
+        auto const& inputs = INPUTS_PERMUTATIONS[permutation];
+        for (size_t table = 0; table < 256; ++table)
+        {
+            unsigned permuted = 0;
+            for (unsigned bit = 0; bit < 8; ++bit)
+            {
+                // Values of the inputs of the identity permutation on assignment `bit`.
+                unsigned const first  = (inputs[0] >> bit) & 1U;
+                unsigned const second = (inputs[1] >> bit) & 1U;
+                unsigned const third  = (inputs[2] >> bit) & 1U;
+                permuted |= ((table >> (4 * first + 2 * second + third)) & 1U) << bit;
+            }
+            permutations[permutation][table] = static_cast<TruthTable3>(permuted);
+        }
+    }
+    return permutations;
+}
+
+/* Precomputed permutations of truth table bits, see `buildTruthTablePermutations_`. */
+constexpr std::array<std::array<TruthTable3, 256>, INPUTS_PERMUTATIONS_NUMBER> TRUTH_TABLE_PERMUTATIONS =
+    buildTruthTablePermutations_();
+
+/**
+ * @param permutation -- index of permutation of inputs in `INPUTS_PERMUTATIONS`.
+ * @param table -- truth table, evaluated on the identity permutation of inputs.
+ * @return truth table, evaluated on the given permutation of inputs.
+ */
+constexpr TruthTable3 permuteTruthTable(size_t permutation, TruthTable3 table)
+{
+    return TRUTH_TABLE_PERMUTATIONS[permutation][table];
+}
+
+/**
+ * Evaluates truth table of a gate of given type by truth tables of its operands.
+ * Only binary operators and `NOT` are supported.
+ * @return true iff gate type is supported.
+ */
+constexpr bool evaluateTruthTable(GateType type, TruthTable3 first, TruthTable3 second, TruthTable3& result)
+{
+    switch (type)
+    {
+        case GateType::NOT:
+            result = static_cast<TruthTable3>(~first);
+            return true;
+        case GateType::AND:
+            result = first & second;
+            return true;
+        case GateType::NAND:
+            result = static_cast<TruthTable3>(~(first & second));
+            return true;
+        case GateType::OR:
+            result = first | second;
+            return true;
+        case GateType::NOR:
+            result = static_cast<TruthTable3>(~(first | second));
+            return true;
+        case GateType::XOR:
+            result = first ^ second;
+            return true;
+        case GateType::NXOR:
+            result = static_cast<TruthTable3>(~(first ^ second));
+            return true;
+        default:
+            return false;
+    }
+}
+
+static_assert(permuteTruthTable(0, 0b10010110) == 0b10010110);
+static_assert(permuteTruthTable(1, FIRST_INPUT_TT & SECOND_INPUT_TT) == (FIRST_INPUT_TT & THIRD_INPUT_TT));
+static_assert(permuteTruthTable(3, SECOND_INPUT_TT) == THIRD_INPUT_TT);
+static_assert(permuteTruthTable(5, FIRST_INPUT_TT | (SECOND_INPUT_TT & ~THIRD_INPUT_TT)) ==
+              (THIRD_INPUT_TT | (SECOND_INPUT_TT & ~FIRST_INPUT_TT & 0xFF)));
+
+}  // namespace csat::utils
@@ -1,21 +1,20 @@
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <memory>
 #include <ranges>
-#include <unordered_map>
 #include <vector>
 
 #include "src/algo.hpp"
 #include "src/common/csat_types.hpp"
 #include "src/simplification/transformer_base.hpp"
+#include "src/simplification/utils/parents_hash_map.hpp"
 #include "src/utility/converters.hpp"
 
 namespace csat::utils
 {
 
-using ColorId = size_t;
-
 /**
  * Class for selecting a subcircuit of two inputs and the gates that use them. To distinguish
  * this subcircuit from the other gates of the circuit, we will put color marks. If the gates
@@ -49,7 +48,7 @@ struct TwoColor
     }
 
     [[nodiscard]]
-    GateIdContainer getParents() const
+    std::array<GateId, 2> getParents() const
     {
         return {first_parent, second_parent};
     }
@@ -60,7 +59,7 @@ struct TwoColor
         return first_parent == gateId || second_parent == gateId;
     }
 
-    static GateIdContainer sortedParents(GateId first_parent, GateId second_parent)
+    static std::array<GateId, 2> sortedParents(GateId first_parent, GateId second_parent)
     {
         return {std::min(first_parent, second_parent), std::max(first_parent, second_parent)};
     }
@@ -74,7 +73,7 @@ class TwoColoring
   public:
     std::vector<TwoColor> colors;    // list of all colors
     std::vector<ColorId> gateColor;  // what color is the gate, if vertex is not colored, then value is 'SIZE_MAX'
-    std::map<GateIdContainer, ColorId> parentsToColor;  // map of parents of colors (inputs subcircuit)
+    ParentsHashMap parentsToColor;   // map of parents of colors (inputs subcircuit)
 
     [[nodiscard]]
     size_t getColorsNumber() const
@@ -104,7 +103,8 @@ class TwoColoring
     ColorId addColor(GateId first_parent, GateId second_parent)
     {
         colors.emplace_back(first_parent, second_parent);
-        parentsToColor[TwoColor::sortedParents(first_parent, second_parent)] = next_color_id_;
+        auto const parents = TwoColor::sortedParents(first_parent, second_parent);
+        parentsToColor.insert(parents[0], parents[1], next_color_id_);
         return next_color_id_++;
     }
 
@@ -134,7 +134,7 @@ class TwoColoring
         // Painting process in two color start from input to output
         for (uint64_t const gateId : std::ranges::reverse_view(gate_sorting))
         {
-            GateIdContainer const& operands = circuit.getGateOperands(gateId);
+            GateIdSpan const operands = circuit.getGateOperands(gateId);
 
             // Gate is input or constant
             if (operands.empty())
@@ -190,7 +190,6 @@ class TwoColoring
                 continue;
             }
 
-            GateIdContainer const children = TwoColor::sortedParents(child_1, child_2);
             if (color_1 != SIZE_MAX && color_1 == color_2)
             {
                 // we color our gate if the operands have a color and they match
@@ -208,16 +207,21 @@ class TwoColoring
                 // and the first operand is its parent (the input of the subcircuit)
                 paintGate(gateId, color_2);
             }
-            else if (parentsToColor.find(children) == parentsToColor.end())
-            {
-                // Create new color if the operands are not parents of any color
-                ColorId const newColor = addColor(child_1, child_2);
-                paintGate(gateId, newColor);
-            }
             else
             {
-                // Paint in the color of the operands, which in turn are parents of the same color
-                paintGate(gateId, parentsToColor.at(children));
+                auto const children          = TwoColor::sortedParents(child_1, child_2);
+                ColorId const children_color = parentsToColor.find(children[0], children[1]);
+                if (children_color == ParentsHashMap::NOT_FOUND)
+                {
+                    // Create new color if the operands are not parents of any color
+                    ColorId const newColor = addColor(child_1, child_2);
+                    paintGate(gateId, newColor);
+                }
+                else
+                {
+                    // Paint in the color of the operands, which in turn are parents of the same color
+                    paintGate(gateId, children_color);
+                }
             }
         }
     }
@@ -0,0 +1,853 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "src/algo.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/simplification/transformer_base.hpp"
+#include "src/simplification/utils/circuits_db.hpp"
+#include "src/simplification/utils/structural_hash_table.hpp"
+#include "src/simplification/utils/truth_table.hpp"
+#include "src/simulation/bit_parallel_simulator.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
+#include "src/utility/converters.hpp"
+#include "src/utility/encoder.hpp"
+#include "src/utility/logger.hpp"
+
+namespace csat::simplification
+{
+
+/**
+ * Transformer, that applies local rewrites to gates until none of them is applicable:
+ *  -- constant propagation, e.g. AND(x, FALSE) => FALSE, XOR(x, TRUE) => NOT(x);
+ *  -- NOT folding, e.g. NOT(NOT(x)) => x;
+ *  -- duplicate and opposite operands, e.g. AND(x, x, y) => AND(x, y), OR(x, NOT(x)) => TRUE;
+ *  -- structural hashing: a gate with the same type and operands as another gate is merged into it;
+ *  -- three inputs resubstitution: a gate, whose cone has at most three leaves, is replaced by
+ *     a leaf, its negation or a constant if it computes one, or by a smaller circuit from the database.
+ *
+ * Unlike a fixed number of passes, each of which rescans the whole circuit, rewrites are driven
+ * by a worklist of dirty gates. All gates are visited once in topological order, and afterwards
+ * a gate is revisited only if its operands were changed, so the cost of reaching a fixpoint is
+ * proportional to the number of changes rather than to the size of the circuit.
+ *
+ * Gates are modified in place, and a gate becomes dead as soon as it has no alive users and
+ * is not an output. Constant gates may be left as outputs, so this algorithm requires
+ * RedundantGatesCleaner_ (which saves at least one input) and ConstantGateReducer_ to be
+ * applied right after.
+ *
+ * @tparam CircuitT
+ * @tparam basis -- basis of circuit, which defines the database of resubstitution.
+ */
+template<
+    class CircuitT,
+    Basis basis = Basis::AIG,
+    typename    = std::enable_if_t<std::is_base_of_v<IMutableCircuit, CircuitT>>>
+class WorklistSimplifier_ : public ITransformer<CircuitT>
+{
+    csat::Logger logger{"WorklistSimplifier"};
+
+  public:
+    /* Maximum number of gates in a cone, which is resubstituted. */
+    static constexpr size_t MAX_CONE_SIZE = 16;
+    /* Maximum number of leaves of a resubstituted cone. */
+    static constexpr size_t MAX_CUT_LEAVES = 3;
+
+  protected:
+    CircuitT* circuit_                 = nullptr;
+    GateEncoder<std::string>* encoder_ = nullptr;
+    WorklistStats* stats_              = nullptr;
+    std::shared_ptr<CircuitDB> db_     = nullptr;
+    std::string new_gate_name_prefix_{};
+
+    /* Structures of gates, which are indexed by `structures_`. */
+    StructuralHashTable structures_{};
+    BoolVector indexed_{};
+    /* Number of occurrences of gate among operands of alive gates and among outputs. */
+    std::vector<size_t> references_{};
+    /* Number of occurrences of gate among outputs. */
+    std::vector<size_t> outputs_number_{};
+    /* Gate, which replaced a removed gate, or `SIZE_MAX`. */
+    GateIdContainer replacement_{};
+
+    std::deque<GateId> worklist_{};
+    BoolVector queued_{};
+
+    /* Cone of resubstitution: its gates, its leaves and membership marks of both. */
+    GateIdContainer cone_{};
+    GateIdContainer leaves_{};
+    BoolVector in_cone_{};
+    /* Truth tables of cone gates over its leaves, see `utils::TruthTable3`. */
+    std::vector<uint64_t> tables_{};
+
+    /* Buffers of new operands of a gate. */
+    GateIdContainer operands_{};
+    GateIdContainer replaced_operands_{};
+    /* Stack of unreferenced gates, which are to be marked dead. */
+    GateIdContainer kill_stack_{};
+
+  public:
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext& context)
+    {
+        logger.debug("=========================================================================================");
+        logger.debug("START WorklistSimplifier");
+        auto const time_start = std::chrono::steady_clock::now();
+
+        circuit_              = circuit.get();
+        encoder_              = encoder.get();
+        stats_                = &context.worklist_stats;
+        new_gate_name_prefix_ = getUniqueId_(context) + "::new_gate_WorklistSimplifier@";
+        db_ = basis == Basis::AIG ? DBSingleton::getInstance().aig_db : DBSingleton::getInstance().bench_db;
+        if (db_ == nullptr)
+        {
+            logger.debug("Database is not loaded, resubstitution by database circuits is disabled");
+        }
+
+        size_t const circuit_size = circuit_->getNumberOfGates();
+        structures_.clear();
+        structures_.reserve(circuit_size);
+        indexed_.assign(circuit_size, 0);
+        references_.assign(circuit_size, 0);
+        outputs_number_.assign(circuit_size, 0);
+        replacement_.assign(circuit_size, SIZE_MAX);
+        queued_.assign(circuit_size, 0);
+        in_cone_.assign(circuit_size, 0);
+        tables_.assign(circuit_size, 0);
+        for (GateId gateId = 0; gateId < circuit_size; ++gateId)
+        {
+            for (GateId const operand : circuit_->getGateOperands(gateId))
+            {
+                ++references_[operand];
+            }
+        }
+        for (GateId const output : circuit_->getOutputGates())
+        {
+            ++references_[output];
+            ++outputs_number_[output];
+        }
+
+        logger.debug("Initial sweep in topological order");
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit_));
+        for (GateId const gateId : std::ranges::reverse_view(gate_sorting))
+        {
+            enqueue_(gateId);
+        }
+        // Gates, which are not reachable from outputs, are removed right away.
+        for (GateId gateId = 0; gateId < circuit_size; ++gateId)
+        {
+            if (references_[gateId] == 0 && circuit_->getGateType(gateId) != GateType::INPUT &&
+                !circuit_->isDead(gateId))
+            {
+                kill_(gateId);
+            }
+        }
+
+        logger.debug("Processing of dirty gates");
+        while (!worklist_.empty())
+        {
+            GateId const gateId = worklist_.front();
+            worklist_.pop_front();
+            queued_[gateId] = 0;
+            if (!circuit_->isDead(gateId))
+            {
+                ++stats_->processed_gates;
+                processGate_(gateId);
+            }
+        }
+
+        GateIdContainer output_gates(circuit_->getOutputGates());
+        for (GateId& output : output_gates)
+        {
+            output = getReplacement_(output);
+        }
+        circuit_->setOutputGates(std::move(output_gates));
+        encoder->renumber(circuit_->compact());
+
+        stats_->time += std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+        logger.debug(
+            "Processed ",
+            stats_->processed_gates,
+            " gates, rewritten ",
+            stats_->rewritten_gates,
+            ", replaced ",
+            stats_->replaced_gates,
+            ", resubstituted ",
+            stats_->resubstituted_gates);
+        logger.debug("END WorklistSimplifier");
+        logger.debug("=========================================================================================");
+        return {std::move(circuit), std::move(encoder)};
+    }
+
+  protected:
+    /**
+     * Applies all rewrites to gate, until either none of them is applicable,
+     * or the gate is replaced by another one.
+     */
+    void processGate_(GateId gateId)
+    {
+        if (circuit_->getGateType(gateId) == GateType::INPUT)
+        {
+            return;
+        }
+
+        GateType type = GateType::UNDEFINED;
+        while (true)
+        {
+            GateId const replacement = normalize_(gateId, type);
+            if (replacement != SIZE_MAX)
+            {
+                ++stats_->replaced_gates;
+                replace_(gateId, replacement);
+                return;
+            }
+            GateIdSpan const operands = circuit_->getGateOperands(gateId);
+            if (type == circuit_->getGateType(gateId) &&
+                std::equal(operands.begin(), operands.end(), operands_.begin(), operands_.end()))
+            {
+                break;
+            }
+            ++stats_->rewritten_gates;
+            rewrite_(gateId, type, operands_);
+        }
+
+        GateIdSpan const operands = circuit_->getGateOperands(gateId);
+        GateId const representative =
+            structures_.findOrInsert(type, operands, gateId);
+        if (representative != gateId)
+        {
+            ++stats_->replaced_gates;
+            replace_(gateId, representative);
+            return;
+        }
+        indexed_[gateId] = 1;
+
+        resubstitute_(gateId);
+    }
+
+    /**
+     * Computes type and operands of gate after constant propagation, NOT folding and
+     * removal of duplicate and opposite operands. Operands are written to `operands_`.
+     * @return gate, which replaces the given one, or `SIZE_MAX` if gate is to be kept.
+     */
+    GateId normalize_(GateId gateId, GateType& type)
+    {
+        type                      = circuit_->getGateType(gateId);
+        GateIdSpan const operands = circuit_->getGateOperands(gateId);
+        operands_.assign(operands.begin(), operands.end());
+
+        switch (type)
+        {
+            case GateType::IFF:
+            case GateType::BUFF:
+                return operands[0];
+            case GateType::NOT:
+            {
+                GateType const operand_type = circuit_->getGateType(operands[0]);
+                if (operand_type == GateType::NOT)
+                {
+                    return circuit_->getGateOperands(operands[0])[0];
+                }
+                if (operand_type == GateType::CONST_FALSE || operand_type == GateType::CONST_TRUE)
+                {
+                    setConstant_(type, operand_type == GateType::CONST_FALSE);
+                }
+                return SIZE_MAX;
+            }
+            case GateType::MUX:
+            {
+                // Value of the second operand is taken if the first one is false, otherwise of the third one.
+                GateType const selector_type = circuit_->getGateType(operands[0]);
+                if (selector_type == GateType::CONST_FALSE || operands[1] == operands[2])
+                {
+                    return operands[1];
+                }
+                return selector_type == GateType::CONST_TRUE ? operands[2] : SIZE_MAX;
+            }
+            case GateType::AND:
+            case GateType::NAND:
+            case GateType::OR:
+            case GateType::NOR:
+            case GateType::XOR:
+            case GateType::NXOR:
+                return normalizeSymmetric_(type);
+            default:
+                return SIZE_MAX;
+        }
+    }
+
+    /**
+     * Normalizes operands of AND, OR, XOR and their negations, which are already in `operands_`.
+     * @return gate, which replaces the given one, or `SIZE_MAX` if gate is to be kept.
+     */
+    GateId normalizeSymmetric_(GateType& type)
+    {
+        bool const is_and = type == GateType::AND || type == GateType::NAND;
+        bool const is_or  = type == GateType::OR || type == GateType::NOR;
+        // Value of gate is negated, either by its type, or by constant and opposite operands of XOR.
+        bool negated = type == GateType::NAND || type == GateType::NOR || type == GateType::NXOR;
+
+        size_t kept = 0;
+        for (GateId const operand : operands_)
+        {
+            GateType const operand_type = circuit_->getGateType(operand);
+            if (operand_type != GateType::CONST_FALSE && operand_type != GateType::CONST_TRUE)
+            {
+                operands_[kept++] = operand;
+                continue;
+            }
+            bool const value = operand_type == GateType::CONST_TRUE;
+            if ((is_and && !value) || (is_or && value))
+            {
+                // Controlling value defines value of the gate.
+                setConstant_(type, value != negated);
+                return SIZE_MAX;
+            }
+            if (!is_and && !is_or)
+            {
+                negated = negated != value;
+            }
+        }
+        operands_.resize(kept);
+
+        // Operands of symmetric gates are sorted, so duplicates are adjacent.
+        if (is_and || is_or)
+        {
+            operands_.erase(std::unique(operands_.begin(), operands_.end()), operands_.end());
+        }
+        else
+        {
+            kept = 0;
+            for (size_t idx = 0; idx < operands_.size(); ++idx)
+            {
+                if (idx + 1 < operands_.size() && operands_[idx] == operands_[idx + 1])
+                {
+                    ++idx;
+                    continue;
+                }
+                operands_[kept++] = operands_[idx];
+            }
+            operands_.resize(kept);
+        }
+
+        // Opposite operands `x` and `NOT(x)`.
+        for (size_t idx = 0; idx < operands_.size(); ++idx)
+        {
+            if (circuit_->getGateType(operands_[idx]) != GateType::NOT)
+            {
+                continue;
+            }
+            GateId const negated_operand = circuit_->getGateOperands(operands_[idx])[0];
+            auto const opposite = std::lower_bound(operands_.begin(), operands_.end(), negated_operand);
+            if (opposite == operands_.end() || *opposite != negated_operand)
+            {
+                continue;
+            }
+            if (is_and || is_or)
+            {
+                setConstant_(type, is_or != negated);
+                return SIZE_MAX;
+            }
+            // XOR(x, NOT(x), ...) = NOT(XOR(...)).
+            negated = !negated;
+            operands_.erase(std::max(opposite, operands_.begin() + static_cast<std::ptrdiff_t>(idx)));
+            operands_.erase(std::min(opposite, operands_.begin() + static_cast<std::ptrdiff_t>(idx)));
+            idx = SIZE_MAX;
+        }
+
+        if (operands_.empty())
+        {
+            // AND of nothing is true, while OR and XOR of nothing are false.
+            setConstant_(type, is_and != negated);
+            return SIZE_MAX;
+        }
+        if (operands_.size() == 1)
+        {
+            if (!negated)
+            {
+                return operands_[0];
+            }
+            type = GateType::NOT;
+            return SIZE_MAX;
+        }
+        if (is_and)
+        {
+            type = negated ? GateType::NAND : GateType::AND;
+        }
+        else if (is_or)
+        {
+            type = negated ? GateType::NOR : GateType::OR;
+        }
+        else
+        {
+            type = negated ? GateType::NXOR : GateType::XOR;
+        }
+        return SIZE_MAX;
+    }
+
+    /**
+     * Tries to replace gate by a leaf, negation of a leaf, a constant, or a smaller circuit
+     * from the database, if its cone has at most `MAX_CUT_LEAVES` leaves.
+     */
+    void resubstitute_(GateId gateId)
+    {
+        if (!collectCone_(gateId))
+        {
+            releaseCone_();
+            return;
+        }
+
+        for (size_t idx = 0; idx < leaves_.size(); ++idx)
+        {
+            tables_[leaves_[idx]] = utils::INPUTS_PERMUTATIONS[0][idx];
+        }
+        evaluateCone_(gateId);
+        auto const table = static_cast<utils::TruthTable3>(tables_[gateId]);
+
+        if (table == 0 || table == UINT8_MAX)
+        {
+            releaseCone_();
+            ++stats_->resubstituted_gates;
+            rewrite_(gateId, table == 0 ? GateType::CONST_FALSE : GateType::CONST_TRUE, {});
+            return;
+        }
+        for (size_t idx = 0; idx < leaves_.size(); ++idx)
+        {
+            GateId const leaf = leaves_[idx];
+            if (table == utils::INPUTS_PERMUTATIONS[0][idx])
+            {
+                releaseCone_();
+                ++stats_->resubstituted_gates;
+                replace_(gateId, leaf);
+                return;
+            }
+            if (table == static_cast<utils::TruthTable3>(~utils::INPUTS_PERMUTATIONS[0][idx]))
+            {
+                releaseCone_();
+                if (circuit_->getGateType(gateId) != GateType::NOT)
+                {
+                    ++stats_->resubstituted_gates;
+                    rewrite_(gateId, GateType::NOT, {leaf});
+                }
+                return;
+            }
+        }
+
+        if (db_ == nullptr || cone_.size() < 2)
+        {
+            releaseCone_();
+            return;
+        }
+        resubstituteByDatabase_(gateId, table);
+        releaseCone_();
+    }
+
+    /**
+     * Replaces gate by a circuit from the database, if it is smaller than the part of
+     * the cone, which is used by the gate only. Cone must be collected and evaluated.
+     */
+    void resubstituteByDatabase_(GateId gateId, utils::TruthTable3 table)
+    {
+        int32_t pattern_index = CircuitDB::NOT_FOUND;
+        size_t permutation    = 0;
+        for (; permutation < utils::INPUTS_PERMUTATIONS_NUMBER; ++permutation)
+        {
+            std::array<int32_t, 1> const pattern{utils::permuteTruthTable(permutation, table)};
+            pattern_index = db_->findPattern(CircuitDB::packPatterns(pattern));
+            if (pattern_index != CircuitDB::NOT_FOUND)
+            {
+                break;
+            }
+        }
+        if (pattern_index == CircuitDB::NOT_FOUND)
+        {
+            return;
+        }
+
+        size_t const saved_operators = dereference_(gateId);
+        reference_(gateId);
+        if (static_cast<size_t>(db_->getOperatorsNumber(pattern_index)) >= saved_operators)
+        {
+            return;
+        }
+
+        // Input `k` of database circuit is a leaf, which has its truth table under the permutation.
+        std::span<DBGate const> const pattern_gates = db_->getGates(pattern_index);
+        GateIdContainer bijection(pattern_gates.size() + 3, leaves_[0]);
+        for (size_t input = 0; input < 3; ++input)
+        {
+            for (size_t idx = 0; idx < leaves_.size(); ++idx)
+            {
+                if (utils::INPUTS_PERMUTATIONS[permutation][idx] == utils::INPUTS_PERMUTATIONS[0][input])
+                {
+                    bijection[input] = leaves_[idx];
+                }
+            }
+        }
+
+        GateIdContainer created_gates{};
+        bool reused_gate = false;
+        for (size_t idx = 0; idx < pattern_gates.size() && !reused_gate; ++idx)
+        {
+            operands_.clear();
+            for (uint16_t const operand : pattern_gates[idx].getOperands())
+            {
+                operands_.push_back(bijection[operand]);
+            }
+            if (utils::symmetricOperatorQ(pattern_gates[idx].type))
+            {
+                std::sort(operands_.begin(), operands_.end());
+            }
+            GateId const existing = structures_.find(pattern_gates[idx].type, operands_);
+            // Gate itself may not be reused, since its users would become its operands.
+            reused_gate           = existing == gateId;
+            bijection[idx + 3]    = existing != StructuralHashTable::NOT_FOUND
+                                        ? existing
+                                        : createGate_(pattern_gates[idx].type, operands_, created_gates);
+        }
+
+        GateId const output = bijection[db_->getOutputs(pattern_index)[0]];
+        if (!reused_gate && output != gateId)
+        {
+            ++stats_->resubstituted_gates;
+            replace_(gateId, output);
+        }
+        for (GateId const created : created_gates)
+        {
+            if (references_[created] == 0 && !circuit_->isDead(created))
+            {
+                kill_(created);
+            }
+        }
+    }
+
+    /**
+     * Collects cone of gate with at most `MAX_CUT_LEAVES` leaves, by expanding its leaves greedily.
+     * @return false if operands of gate are too many to form such a cone.
+     */
+    bool collectCone_(GateId gateId)
+    {
+        cone_.assign(1, gateId);
+        in_cone_[gateId] = 1;
+        leaves_.clear();
+        for (GateId const operand : circuit_->getGateOperands(gateId))
+        {
+            addLeaf_(operand);
+        }
+        if (leaves_.size() > MAX_CUT_LEAVES || leaves_.empty())
+        {
+            return false;
+        }
+
+        bool expanded = true;
+        while (expanded && cone_.size() < MAX_CONE_SIZE)
+        {
+            expanded = false;
+            for (size_t idx = 0; idx < leaves_.size() && !expanded; ++idx)
+            {
+                GateId const leaf = leaves_[idx];
+                if (circuit_->getGateType(leaf) == GateType::INPUT)
+                {
+                    continue;
+                }
+                // Leaf is expanded only if the cut stays small enough.
+                size_t new_leaves = leaves_.size() - 1;
+                for (GateId const operand : circuit_->getGateOperands(leaf))
+                {
+                    new_leaves += in_cone_[operand] == 0 ? 1 : 0;
+                    in_cone_[operand] += in_cone_[operand] == 0 ? 2 : 0;
+                }
+                for (GateId const operand : circuit_->getGateOperands(leaf))
+                {
+                    in_cone_[operand] -= in_cone_[operand] == 2 ? 2 : 0;
+                }
+                if (new_leaves > MAX_CUT_LEAVES)
+                {
+                    continue;
+                }
+
+                leaves_.erase(leaves_.begin() + static_cast<std::ptrdiff_t>(idx));
+                cone_.push_back(leaf);
+                for (GateId const operand : circuit_->getGateOperands(leaf))
+                {
+                    addLeaf_(operand);
+                }
+                expanded = true;
+            }
+        }
+        return true;
+    }
+
+    /* Adds gate to leaves of the cone, unless it is already there. */
+    void addLeaf_(GateId gateId)
+    {
+        if (in_cone_[gateId] == 0)
+        {
+            in_cone_[gateId] = 1;
+            leaves_.push_back(gateId);
+        }
+    }
+
+    /* Clears membership marks of the cone. */
+    void releaseCone_()
+    {
+        for (GateId const gateId : cone_)
+        {
+            in_cone_[gateId] = 0;
+        }
+        for (GateId const gateId : leaves_)
+        {
+            in_cone_[gateId] = 0;
+        }
+    }
+
+    /**
+     * Evaluates truth table of cone gate, once truth tables of its operands are evaluated.
+     * Cone is small, so recursion is shallow.
+     */
+    void evaluateCone_(GateId gateId)
+    {
+        for (GateId const operand : circuit_->getGateOperands(gateId))
+        {
+            if (in_cone_[operand] == 1 && std::find(leaves_.begin(), leaves_.end(), operand) == leaves_.end())
+            {
+                evaluateCone_(operand);
+            }
+        }
+        simulation::simulateGate<1>(
+            circuit_->getGateType(gateId),
+            circuit_->getGateOperands(gateId),
+            [this](GateId operand) { return tables_.data() + operand; },
+            tables_.data() + gateId);
+    }
+
+    /**
+     * Dereferences cone gates, which are used by the given gate only, as if it was removed.
+     * References must be restored by `reference_`.
+     * @return number of binary operators among such gates.
+     */
+    size_t dereference_(GateId gateId)
+    {
+        GateIdSpan const operands = circuit_->getGateOperands(gateId);
+        size_t operators          = operands.size() > 1 ? operands.size() - 1 : 0;
+        for (GateId const operand : operands)
+        {
+            if (--references_[operand] == 0 && isInnerGate_(operand))
+            {
+                operators += dereference_(operand);
+            }
+        }
+        return operators;
+    }
+
+    /* Restores references, dropped by `dereference_`. */
+    void reference_(GateId gateId)
+    {
+        for (GateId const operand : circuit_->getGateOperands(gateId))
+        {
+            if (references_[operand]++ == 0 && isInnerGate_(operand))
+            {
+                reference_(operand);
+            }
+        }
+    }
+
+    /* @return true iff gate belongs to the cone, but is not its leaf. */
+    [[nodiscard]]
+    bool isInnerGate_(GateId gateId) const
+    {
+        return in_cone_[gateId] != 0 && std::find(leaves_.begin(), leaves_.end(), gateId) == leaves_.end();
+    }
+
+    /* Writes constant gate of given value to `type` and `operands_`. */
+    void setConstant_(GateType& type, bool value)
+    {
+        type = value ? GateType::CONST_TRUE : GateType::CONST_FALSE;
+        operands_.clear();
+    }
+
+    /**
+     * Adds new gate, which is indexed by structural hashing.
+     * @return id of new gate.
+     */
+    GateId createGate_(GateType type, GateIdContainer const& operands, GateIdContainer& created_gates)
+    {
+        GateId const gateId = circuit_->addGate(type, operands);
+        [[maybe_unused]] GateId const encoded_id =
+            encoder_->encodeGate(getNewGateName_(new_gate_name_prefix_, gateId));
+        assert(encoded_id == gateId);
+
+        indexed_.push_back(1);
+        references_.push_back(0);
+        outputs_number_.push_back(0);
+        replacement_.push_back(SIZE_MAX);
+        queued_.push_back(0);
+        in_cone_.push_back(0);
+        tables_.push_back(0);
+        for (GateId const operand : operands)
+        {
+            ++references_[operand];
+        }
+        structures_.findOrInsert(type, operands, gateId);
+        created_gates.push_back(gateId);
+        enqueue_(gateId);
+        return gateId;
+    }
+
+    /**
+     * Replaces type and operands of gate, and revisits the gate and its users.
+     */
+    void rewrite_(GateId gateId, GateType type, GateIdContainer const& operands)
+    {
+        setGate_(gateId, type, operands);
+        enqueue_(gateId);
+        enqueueUsers_(gateId);
+    }
+
+    /**
+     * Replaces type and operands of gate, keeping references and structural hashing up to date.
+     */
+    void setGate_(GateId gateId, GateType type, GateIdContainer const& operands)
+    {
+        forgetStructure_(gateId);
+        GateIdSpan const old_span = circuit_->getGateOperands(gateId);
+        GateIdContainer const old_operands(old_span.begin(), old_span.end());
+        for (GateId const operand : operands)
+        {
+            ++references_[operand];
+        }
+        circuit_->setGate(gateId, type, operands);
+        for (GateId const operand : old_operands)
+        {
+            release_(operand);
+        }
+    }
+
+    /**
+     * Makes all users of gate and outputs equal to it to refer to `replacement` instead,
+     * so the gate becomes dead. Users are revisited.
+     */
+    void replace_(GateId gateId, GateId replacement)
+    {
+        replacement_[gateId] = replacement;
+
+        // Outputs are redirected once in the end, while references to them are moved right away.
+        references_[replacement] += outputs_number_[gateId];
+        outputs_number_[replacement] += outputs_number_[gateId];
+        references_[gateId] -= outputs_number_[gateId];
+        outputs_number_[gateId] = 0;
+
+        GateIdSpan const users_span = circuit_->getGateUsers(gateId);
+        GateIdContainer users(users_span.begin(), users_span.end());
+        users.erase(std::unique(users.begin(), users.end()), users.end());
+        for (GateId const user : users)
+        {
+            if (circuit_->isDead(user))
+            {
+                continue;
+            }
+            GateIdSpan const operands = circuit_->getGateOperands(user);
+            replaced_operands_.assign(operands.begin(), operands.end());
+            std::replace(replaced_operands_.begin(), replaced_operands_.end(), gateId, replacement);
+            setGate_(user, circuit_->getGateType(user), replaced_operands_);
+            enqueue_(user);
+        }
+
+        if (references_[gateId] == 0 && !circuit_->isDead(gateId))
+        {
+            kill_(gateId);
+        }
+    }
+
+    /* Drops a reference to gate, and removes the gate once it is not referenced. */
+    void release_(GateId gateId)
+    {
+        if (--references_[gateId] == 0 && circuit_->getGateType(gateId) != GateType::INPUT)
+        {
+            kill_(gateId);
+        }
+    }
+
+    /**
+     * Marks gate as dead, and releases its operands. Operands, which are left without
+     * references, are removed too. Search keeps an explicit stack of such gates, so
+     * long chains of unreferenced gates do not exhaust the call stack.
+     */
+    void kill_(GateId gateId)
+    {
+        assert(kill_stack_.empty());
+        kill_stack_.push_back(gateId);
+        while (!kill_stack_.empty())
+        {
+            GateId const dead = kill_stack_.back();
+            kill_stack_.pop_back();
+            forgetStructure_(dead);
+            circuit_->markDead(dead);
+            for (GateId const operand : circuit_->getGateOperands(dead))
+            {
+                if (--references_[operand] == 0 && circuit_->getGateType(operand) != GateType::INPUT)
+                {
+                    kill_stack_.push_back(operand);
+                }
+            }
+        }
+    }
+
+    /* Removes gate from structural hashing, if it is indexed. */
+    void forgetStructure_(GateId gateId)
+    {
+        if (indexed_[gateId] != 0)
+        {
+            GateIdSpan const operands = circuit_->getGateOperands(gateId);
+            structures_.erase(circuit_->getGateType(gateId), operands);
+            indexed_[gateId] = 0;
+        }
+    }
+
+    /* @return gate, which finally replaced the given one, or the gate itself. */
+    GateId getReplacement_(GateId gateId)
+    {
+        while (replacement_[gateId] != SIZE_MAX)
+        {
+            gateId = replacement_[gateId];
+        }
+        return gateId;
+    }
+
+    void enqueue_(GateId gateId)
+    {
+        if (queued_[gateId] == 0)
+        {
+            queued_[gateId] = 1;
+            worklist_.push_back(gateId);
+        }
+    }
+
+    void enqueueUsers_(GateId gateId)
+    {
+        for (GateId const user : circuit_->getGateUsers(gateId))
+        {
+            if (!circuit_->isDead(user))
+            {
+                enqueue_(user);
+            }
+        }
+    }
+};
+
+}  // namespace csat::simplification
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "src/algo.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/icircuit.hpp"
+#include "src/utility/levelization.hpp"
+#include "src/utility/thread_pool.hpp"
+
+namespace csat::simulation
+{
+
+template<size_t Words, class UnaryOp>
+void mapWords_(uint64_t* result, uint64_t const* values, UnaryOp oper)
+{
+    for (size_t word = 0; word < Words; ++word)
+    {
+        result[word] = oper(values[word]);
+    }
+}
+
+template<size_t Words, bool Negate, class ValuesOf, class BinaryOp>
+void foldWords_(uint64_t* result, std::span<GateId const> operands, ValuesOf const& values_of, BinaryOp oper)
+{
+    std::array<uint64_t, Words> accumulator{};
+    uint64_t const* first = values_of(operands[0]);
+    std::copy(first, first + Words, accumulator.begin());
+    for (size_t idx = 1; idx < operands.size(); ++idx)
+    {
+        uint64_t const* values = values_of(operands[idx]);
+        for (size_t word = 0; word < Words; ++word)
+        {
+            accumulator[word] = oper(accumulator[word], values[word]);
+        }
+    }
+    for (size_t word = 0; word < Words; ++word)
+    {
+        result[word] = Negate ? ~accumulator[word] : accumulator[word];
+    }
+}
+
+/**
+ * Kernel of word-parallel gate evaluation, which computes `Words` words of values
+ * of operator gate by values of its operands. Inputs are not supported.
+ *
+ * @param type -- type of gate.
+ * @param operands -- operands of gate.
+ * @param values_of -- callable, which maps operand to pointer to its `Words` words of values.
+ * @param result -- pointer to `Words` words of values of gate.
+ */
+template<size_t Words, class ValuesOf>
+void simulateGate(GateType type, std::span<GateId const> operands, ValuesOf const& values_of, uint64_t* result)
+{
+    using Word = uint64_t;
+    switch (type)
+    {
+        case GateType::NOT:
+            mapWords_<Words>(result, values_of(operands[0]), [](Word value) { return ~value; });
+            return;
+        case GateType::IFF:
+        case GateType::BUFF:
+            mapWords_<Words>(result, values_of(operands[0]), [](Word value) { return value; });
+            return;
+        case GateType::AND:
+            foldWords_<Words, false>(result, operands, values_of, [](Word lhs, Word rhs) { return lhs & rhs; });
+            return;
+        case GateType::NAND:
+            foldWords_<Words, true>(result, operands, values_of, [](Word lhs, Word rhs) { return lhs & rhs; });
+            return;
+        case GateType::OR:
+            foldWords_<Words, false>(result, operands, values_of, [](Word lhs, Word rhs) { return lhs | rhs; });
+            return;
+        case GateType::NOR:
+            foldWords_<Words, true>(result, operands, values_of, [](Word lhs, Word rhs) { return lhs | rhs; });
+            return;
+        case GateType::XOR:
+            foldWords_<Words, false>(result, operands, values_of, [](Word lhs, Word rhs) { return lhs ^ rhs; });
+            return;
+        case GateType::NXOR:
+            foldWords_<Words, true>(result, operands, values_of, [](Word lhs, Word rhs) { return lhs ^ rhs; });
+            return;
+        case GateType::MUX:
+        {
+            // Value of the second operand is taken if the first one is false, otherwise of the third one.
+            Word const* selector = values_of(operands[0]);
+            Word const* if_false = values_of(operands[1]);
+            Word const* if_true  = values_of(operands[2]);
+            for (size_t word = 0; word < Words; ++word)
+            {
+                result[word] = (~selector[word] & if_false[word]) | (selector[word] & if_true[word]);
+            }
+            return;
+        }
+        case GateType::CONST_FALSE:
+            std::fill(result, result + Words, Word{0});
+            return;
+        case GateType::CONST_TRUE:
+            std::fill(result, result + Words, ~Word{0});
+            return;
+        default:
+            std::cerr << "Simulator doesn't support gate type " << static_cast<int>(type) << "." << std::endl;
+            std::abort();
+    }
+}
+
+/**
+ * Word-parallel two-valued simulator of a circuit. Each gate carries `64 * Words`
+ * values, one per simulated input pattern, so a gate is evaluated on all patterns
+ * by a few bitwise instructions. Loops over `Words` are short and branch-free, so
+ * the compiler vectorizes them when SIMD instructions are enabled.
+ *
+ * Simulator takes a snapshot of circuit topology on construction, so values of gates
+ * (signatures) may be used for fast filtering of non-equivalent gates: if signatures
+ * of two gates differ, gates are not equivalent; the converse is not guaranteed.
+ *
+ * @tparam Words -- number of 64-bit words per gate, e.g. 1 for 64 patterns, 4 for 256 ones.
+ */
+template<size_t Words = 1>
+class BitParallelSimulator
+{
+    static_assert(Words > 0, "Simulator must carry at least one word per gate.");
+
+  public:
+    /* Number of patterns, simulated at once. */
+    static constexpr size_t PATTERNS_NUMBER = 64 * Words;
+
+    using Word = uint64_t;
+    /* Values of a single gate on all simulated patterns. */
+    using Patterns = std::array<Word, Words>;
+
+  protected:
+    /* Gates in topological order, where operands precede their users. */
+    GateIdContainer order_{};
+    /* Types of gates. */
+    std::vector<GateType> types_{};
+    /* Operands of all gates, operands of gate `i` are `[operands_begin_[i], operands_begin_[i + 1])`. */
+    GateIdContainer operands_{};
+    std::vector<size_t> operands_begin_{};
+    /* Inputs of circuit, in order of `getInputGates`. */
+    GateIdContainer inputs_{};
+    /* Values of all gates, values of gate `i` are `[i * Words, (i + 1) * Words)`. */
+    std::vector<Word> values_{};
+    /* Pool to simulate gates of each level in parallel, or nullptr. */
+    utils::ThreadPool* pool_ = nullptr;
+    /* Levels of gates, which are built only if simulation is parallel. */
+    utils::Levelization levels_{};
+
+  public:
+    /**
+     * @param circuit -- circuit to simulate. Simulator doesn't refer to it after construction.
+     * @param pool -- pool to simulate gates of each level in parallel, or nullptr to simulate
+     *        them sequentially. Pool must outlive the simulator.
+     */
+    explicit BitParallelSimulator(ICircuit const& circuit, utils::ThreadPool* pool = nullptr)
+        : order_(algo::TopSortAlgorithm<algo::DFSTopSort>::evaluationSorting(circuit))
+        , types_(circuit.getNumberOfGates())
+        , inputs_(circuit.getInputGates())
+        , values_(circuit.getNumberOfGates() * Words, 0)
+        , pool_(pool)
+    {
+        std::reverse(order_.begin(), order_.end());
+
+        operands_begin_.reserve(circuit.getNumberOfGates() + 1);
+        operands_begin_.push_back(0);
+        for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+        {
+            types_[gateId]            = circuit.getGateType(gateId);
+            GateIdSpan const operands = circuit.getGateOperands(gateId);
+            operands_.insert(operands_.end(), operands.begin(), operands.end());
+            operands_begin_.push_back(operands_.size());
+        }
+        if (pool_ != nullptr)
+        {
+            levels_ = utils::Levelization(
+                order_, getNumberOfGates(), [this](GateId gateId) { return getOperands_(gateId); });
+        }
+    }
+
+    /**
+     * @return number of gates of simulated circuit.
+     */
+    [[nodiscard]]
+    size_t getNumberOfGates() const
+    {
+        return types_.size();
+    }
+
+    /**
+     * Simulates circuit on given patterns.
+     * @param input_values -- values of inputs, in order of `getInputGates` of the circuit.
+     */
+    void simulate(std::span<Patterns const> input_values)
+    {
+        if (input_values.size() != inputs_.size())
+        {
+            std::cerr << "Simulator expects values of " << inputs_.size() << " inputs, but got "
+                      << input_values.size() << "." << std::endl;
+            std::abort();
+        }
+        for (size_t idx = 0; idx < inputs_.size(); ++idx)
+        {
+            std::copy(input_values[idx].begin(), input_values[idx].end(), values_.begin() + inputs_[idx] * Words);
+        }
+        propagate_();
+    }
+
+    /**
+     * Simulates circuit on uniformly random patterns.
+     * @param seed -- seed of random patterns, equal seeds produce equal patterns.
+     */
+    void simulateRandom(uint64_t seed)
+    {
+        std::mt19937_64 generator(seed);
+        for (GateId const input : inputs_)
+        {
+            for (size_t word = 0; word < Words; ++word)
+            {
+                values_[input * Words + word] = generator();
+            }
+        }
+        propagate_();
+    }
+
+    /**
+     * @return values of gate on the last simulated patterns. Bit `j` of word `i`
+     *         holds value of the gate on pattern `64 * i + j`.
+     */
+    [[nodiscard]]
+    std::span<Word const, Words> getValues(GateId gateId) const
+    {
+        return std::span<Word const, Words>(values_.data() + gateId * Words, Words);
+    }
+
+    /**
+     * @return false if gates are proven to be non-equivalent by the last simulated patterns.
+     */
+    [[nodiscard]]
+    bool mayBeEquivalent(GateId first, GateId second) const
+    {
+        auto const lhs = getValues(first);
+        auto const rhs = getValues(second);
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    /**
+     * @return false if gates are proven not to be negations of each other by the last simulated patterns.
+     */
+    [[nodiscard]]
+    bool mayBeComplementary(GateId first, GateId second) const
+    {
+        auto const lhs = getValues(first);
+        auto const rhs = getValues(second);
+        for (size_t word = 0; word < Words; ++word)
+        {
+            if (lhs[word] != ~rhs[word])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  protected:
+    /* Evaluates all gates, except for inputs, in topological order. */
+    void propagate_()
+    {
+        if (pool_ != nullptr)
+        {
+            utils::parallelForEachLevel(*pool_, levels_, [this](GateId gateId) { evaluateGate_(gateId); });
+            return;
+        }
+        for (GateId const gateId : order_)
+        {
+            evaluateGate_(gateId);
+        }
+    }
+
+    /* Operands of gate in the snapshot of circuit. */
+    [[nodiscard]]
+    std::span<GateId const> getOperands_(GateId gateId) const
+    {
+        return {operands_.data() + operands_begin_[gateId], operands_begin_[gateId + 1] - operands_begin_[gateId]};
+    }
+
+    /* Evaluates gate on all simulated patterns by values of its operands. */
+    void evaluateGate_(GateId gateId)
+    {
+        if (types_[gateId] == GateType::INPUT)
+        {
+            return;
+        }
+        simulateGate<Words>(
+            types_[gateId],
+            getOperands_(gateId),
+            [this](GateId operand) { return values_.data() + operand * Words; },
+            values_.data() + gateId * Words);
+    }
+};
+
+}  // namespace csat::simulation
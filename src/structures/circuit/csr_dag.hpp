@@ -0,0 +1,628 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/icircuit.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
+
+namespace csat
+{
+
+/**
+ * Auxiliary structure, that stores lists of gate ids of all gates in a single flat array.
+ *
+ * List `i` occupies range `[begin_[i], begin_[i] + size_[i])` of `data_` array. List,
+ * that doesn't fit its place after modification, is relocated to the end of `data_`.
+ * Space left by relocated and shrunk lists is reclaimed once it exceeds half of `data_`.
+ */
+class FlatGateIdLists_
+{
+  public:
+    /* Type of offsets in flat array. */
+    using Offset = uint32_t;
+
+  private:
+    /* Elements of all lists. */
+    GateIdContainer data_;
+    /* Offsets of lists in `data_`. */
+    std::vector<Offset> begin_;
+    /* Sizes of lists. */
+    std::vector<Offset> size_;
+    /* Number of elements in `data_`, that don't belong to any list. */
+    size_t garbage_ = 0;
+
+  public:
+    /**
+     * @return Number of lists.
+     */
+    [[nodiscard]]
+    size_t size() const noexcept
+    {
+        return begin_.size();
+    }
+
+    /**
+     * @param list -- list index.
+     * @return View of list elements.
+     */
+    [[nodiscard]]
+    GateIdSpan get(size_t list) const
+    {
+        return {data_.data() + begin_[list], size_[list]};
+    }
+
+    /**
+     * Reserves memory for `lists` lists with `elements` elements in total.
+     */
+    void reserve(size_t lists, size_t elements)
+    {
+        checkOffsetOverflow_(elements);
+        data_.reserve(elements);
+        begin_.reserve(lists);
+        size_.reserve(lists);
+    }
+
+    /**
+     * Adds new list with given elements.
+     */
+    void append(GateIdSpan values)
+    {
+        ensureSpace_(values.size());
+        begin_.push_back(static_cast<Offset>(data_.size()));
+        size_.push_back(static_cast<Offset>(values.size()));
+        data_.insert(data_.end(), values.begin(), values.end());
+    }
+
+    /**
+     * Replaces all lists by contiguously placed lists of given sizes.
+     * Elements of new lists are to be filled via `mutableData`.
+     */
+    void layout(std::vector<Offset> const& sizes)
+    {
+        begin_.assign(sizes.size(), 0);
+        size_ = sizes;
+
+        size_t total = 0;
+        for (size_t list = 0; list < sizes.size(); ++list)
+        {
+            begin_[list] = static_cast<Offset>(total);
+            total += sizes[list];
+            checkOffsetOverflow_(total);
+        }
+        data_.assign(total, 0);
+        garbage_ = 0;
+    }
+
+    /**
+     * @return Pointer to the first element of list.
+     */
+    [[nodiscard]]
+    GateId* mutableData(size_t list)
+    {
+        return data_.data() + begin_[list];
+    }
+
+    /**
+     * Replaces elements of list.
+     */
+    void assign(size_t list, GateIdContainer const& values)
+    {
+        if (values.size() > size_[list] && !isLast_(list))
+        {
+            relocateToEnd_(list, values.size() - size_[list]);
+        }
+        if (isLast_(list))
+        {
+            data_.resize(begin_[list] + values.size());
+        }
+        else
+        {
+            garbage_ += size_[list] - values.size();
+        }
+        std::copy(values.begin(), values.end(), data_.begin() + begin_[list]);
+        size_[list] = static_cast<Offset>(values.size());
+        collectGarbageIfNeeded_();
+    }
+
+    /**
+     * Inserts element to the sorted list, keeping it sorted.
+     */
+    void insertSorted(size_t list, GateId value)
+    {
+        if (!isLast_(list))
+        {
+            relocateToEnd_(list, 1);
+        }
+        auto const first = data_.begin() + begin_[list];
+        data_.insert(std::upper_bound(first, first + size_[list], value), value);
+        ++size_[list];
+    }
+
+    /**
+     * Removes one occurrence of element from the sorted list, keeping it sorted.
+     */
+    void eraseSorted(size_t list, GateId value)
+    {
+        auto const first = data_.begin() + begin_[list];
+        auto const last  = first + size_[list];
+        auto const it    = std::lower_bound(first, last, value);
+        if (it == last || *it != value)
+        {
+            return;
+        }
+
+        std::copy(it + 1, last, it);
+        --size_[list];
+        if (isLast_(list))
+        {
+            data_.pop_back();
+        }
+        else
+        {
+            ++garbage_;
+            collectGarbageIfNeeded_();
+        }
+    }
+
+  private:
+    [[nodiscard]]
+    bool isLast_(size_t list) const
+    {
+        return begin_[list] + size_[list] == data_.size();
+    }
+
+    /* Moves list to the end of `data_`, so that it can grow by `extra` elements without relocation. */
+    void relocateToEnd_(size_t list, size_t extra)
+    {
+        ensureSpace_(size_[list] + extra);
+        if (isLast_(list))
+        {
+            // Garbage collection could have placed list at the end.
+            return;
+        }
+
+        size_t const old_size = data_.size();
+        data_.resize(old_size + size_[list]);
+        std::copy(data_.begin() + begin_[list], data_.begin() + begin_[list] + size_[list], data_.begin() + old_size);
+        garbage_ += size_[list];
+        begin_[list] = static_cast<Offset>(old_size);
+    }
+
+    /* Makes sure that `elements` more elements may be added to `data_`. */
+    void ensureSpace_(size_t elements)
+    {
+        if (data_.size() + elements > std::numeric_limits<Offset>::max())
+        {
+            collectGarbage_();
+        }
+        checkOffsetOverflow_(data_.size() + elements);
+    }
+
+    void collectGarbageIfNeeded_()
+    {
+        if (garbage_ * 2 > data_.size())
+        {
+            collectGarbage_();
+        }
+    }
+
+    void collectGarbage_()
+    {
+        GateIdContainer data{};
+        data.reserve(data_.size() - garbage_);
+        for (size_t list = 0; list < begin_.size(); ++list)
+        {
+            auto const first = data_.begin() + begin_[list];
+            begin_[list]     = static_cast<Offset>(data.size());
+            data.insert(data.end(), first, first + size_[list]);
+        }
+        data_    = std::move(data);
+        garbage_ = 0;
+    }
+
+    static void checkOffsetOverflow_(size_t elements)
+    {
+        if (elements > std::numeric_limits<Offset>::max())
+        {
+            std::cerr << "CsrDAG: number of arcs in circuit exceeds supported offset range." << std::endl;
+            std::abort();
+        }
+    }
+};
+
+/**
+ * Represents boolean circuit as Directed Acyclic Graph stored in the
+ * compressed sparse row (CSR) format.
+ *
+ * Unlike `DAG`, which keeps two containers per gate, operands and users of
+ * all gates are stored in two flat arrays with 32-bit offsets (see `FlatGateIdLists_`).
+ * Gate types are kept in a separate byte array. Such layout needs only a constant
+ * number of allocations per circuit and keeps adjacent gates close in memory,
+ * which is beneficial for traversals.
+ */
+class CsrDAG : public IMutableCircuit
+{
+  public:
+    /* Type of offsets in flat operands and users arrays. */
+    using Offset = FlatGateIdLists_::Offset;
+
+  protected:
+    /* Type of each gate. */
+    std::vector<GateType> gate_types_;
+    /* Operands of all gates. */
+    FlatGateIdLists_ operands_;
+    /* Users of all gates. */
+    FlatGateIdLists_ users_;
+    /* Carries all input gates. */
+    GateIdContainer input_gates_;
+    /* Carries all output gates. */
+    GateIdContainer output_gates_;
+    /* Mask of output gates. */
+    BoolVector output_mask_;
+    /* Mask of gates, that are marked as dead and will be removed during compaction. */
+    BoolVector dead_mask_;
+    /* Number of gates, that are marked as dead. */
+    size_t dead_gates_number_ = 0;
+
+  public:
+    CsrDAG(CsrDAG const& dag) = default;
+
+    CsrDAG(GateInfoContainer const& gate_info, GateIdContainer const& output_gates)
+        : output_gates_(output_gates)
+    {
+        comprehendGateInfo_(gate_info);
+    }
+
+    CsrDAG(GateInfoContainer&& gate_info, GateIdContainer&& output_gates)
+        : output_gates_(std::move(output_gates))
+    {
+        comprehendGateInfo_(gate_info);
+        // Gate info is fully copied into flat arrays, so it can be released early.
+        GateInfoContainer{}.swap(gate_info);
+    }
+
+    ~CsrDAG() override = default;
+
+  private:
+    void comprehendGateInfo_(GateInfoContainer const& gate_info)
+    {
+        buildGates_(gate_info);
+        calculateGateUsers_();
+        buildOutputMask_();
+        dead_mask_.assign(gate_types_.size(), 0);
+    }
+
+    void buildGates_(GateInfoContainer const& gate_info)
+    {
+        size_t total_operands = 0;
+        for (auto const& info : gate_info)
+        {
+            total_operands += info.getOperands().size();
+        }
+
+        gate_types_.reserve(gate_info.size());
+        operands_.reserve(gate_info.size(), total_operands);
+        for (size_t gateId = 0; gateId < gate_info.size(); ++gateId)
+        {
+            gate_types_.push_back(gate_info[gateId].getType());
+            operands_.append(gate_info[gateId].getOperands());
+
+            if (gate_info[gateId].getType() == GateType::INPUT)
+            {
+                input_gates_.push_back(gateId);
+            }
+        }
+    }
+
+    void calculateGateUsers_()
+    {
+        // Counting sort of arcs by operand: first count users of each gate,
+        // then fill users in order of gate ids, so that users of each gate
+        // are listed in the same order as in `DAG`.
+        std::vector<Offset> users_number(gate_types_.size(), 0);
+        for (GateId gateId = 0; gateId < gate_types_.size(); ++gateId)
+        {
+            for (GateId operand : operands_.get(gateId))
+            {
+                // `at` here is used to implicitly check that
+                // any operand is contained in this graph.
+                ++users_number.at(operand);
+            }
+        }
+
+        users_.layout(users_number);
+        std::fill(users_number.begin(), users_number.end(), 0);
+        for (GateId gateId = 0; gateId < gate_types_.size(); ++gateId)
+        {
+            for (GateId operand : operands_.get(gateId))
+            {
+                users_.mutableData(operand)[users_number[operand]++] = gateId;
+            }
+        }
+    }
+
+    void buildOutputMask_()
+    {
+        output_mask_.assign(gate_types_.size(), 0);
+        for (GateId output : output_gates_)
+        {
+            output_mask_.at(output) = 1;
+        }
+    }
+
+  public:
+    /**
+     * @return Number of gates in Circuit instance.
+     */
+    [[nodiscard]]
+    GateId getNumberOfGates() const noexcept override
+    {
+        return gate_types_.size();
+    };
+
+    /**
+     * @return Number of gates in Circuit instance.
+     */
+    [[nodiscard]]
+    GateId getNumberOfGatesWithoutInputs() const noexcept override
+    {
+        return gate_types_.size() - input_gates_.size();
+    };
+
+    /**
+     * @return Container with all Output gates.
+     */
+    [[nodiscard]]
+    GateIdContainer const& getOutputGates() const noexcept override
+    {
+        return output_gates_;
+    };
+
+    /**
+     * @return Container with all Input gates.
+     */
+    [[nodiscard]]
+    GateIdContainer const& getInputGates() const noexcept override
+    {
+        return input_gates_;
+    };
+
+    /**
+     * @param gateId
+     * @return true iff gateId is output.
+     */
+    [[nodiscard]]
+    bool isOutputGate(GateId gateId) const noexcept override
+    {
+        return output_mask_[gateId] != 0;
+    };
+
+    /**
+     * @param gateId -- gate id.
+     * @return type of gate with id=gateId.
+     */
+    [[nodiscard]]
+    GateType getGateType(GateId gateId) const override
+    {
+        return gate_types_[gateId];
+    };
+
+    /**
+     * @param gateId -- gate id.
+     * @return View of all operands (gate ids) of gate with id=gateId.
+     */
+    [[nodiscard]]
+    GateIdSpan getGateOperands(GateId gateId) const override
+    {
+        return operands_.get(gateId);
+    };
+
+    /**
+     * @param gateId -- gate id.
+     * @return View of all gates, that use gate with id=gateId as operand.
+     */
+    [[nodiscard]]
+    GateIdSpan getGateUsers(GateId gateId) const override
+    {
+        return users_.get(gateId);
+    };
+
+    // ========== Circuit Modification ========== //
+    using IMutableCircuit::compact;
+
+    /**
+     * Adds new gate to the circuit.
+     * @param type -- type of new gate.
+     * @param operands -- operands of new gate.
+     * @return id of new gate.
+     */
+    GateId addGate(GateType type, GateIdContainer operands) override
+    {
+        GateId const gateId = gate_types_.size();
+        normalizeOperands_(type, operands);
+        for (GateId operand : operands)
+        {
+            assert(operand < gateId);
+            users_.insertSorted(operand, gateId);
+        }
+        onGateAdded_(gateId, operands);
+        gate_types_.push_back(type);
+        operands_.append(operands);
+        users_.append({});
+        output_mask_.push_back(0);
+        dead_mask_.push_back(0);
+
+        if (type == GateType::INPUT)
+        {
+            input_gates_.push_back(gateId);
+        }
+        return gateId;
+    }
+
+    /**
+     * Replaces type and operands of gate.
+     * @param gateId -- gate id.
+     * @param type -- new type of gate.
+     * @param operands -- new operands of gate.
+     */
+    void setGate(GateId gateId, GateType type, GateIdContainer operands) override
+    {
+        normalizeOperands_(type, operands);
+        // Operands and users are kept in distinct arrays, so modification
+        // of users doesn't invalidate view of gate operands.
+        for (GateId operand : operands_.get(gateId))
+        {
+            users_.eraseSorted(operand, gateId);
+        }
+        for (GateId operand : operands)
+        {
+            assert(operand < gate_types_.size());
+            users_.insertSorted(operand, gateId);
+        }
+        onGateModified_(gateId, operands_.get(gateId), operands);
+        operands_.assign(gateId, operands);
+
+        if (gate_types_[gateId] == GateType::INPUT && type != GateType::INPUT)
+        {
+            input_gates_.erase(std::lower_bound(input_gates_.begin(), input_gates_.end(), gateId));
+        }
+        else if (gate_types_[gateId] != GateType::INPUT && type == GateType::INPUT)
+        {
+            input_gates_.insert(std::lower_bound(input_gates_.begin(), input_gates_.end(), gateId), gateId);
+        }
+        gate_types_[gateId] = type;
+    }
+
+    /**
+     * Replaces list of output gates.
+     * @param output_gates -- new output gates.
+     */
+    void setOutputGates(GateIdContainer output_gates) override
+    {
+        for (GateId output : output_gates_)
+        {
+            output_mask_[output] = 0;
+        }
+        output_gates_ = std::move(output_gates);
+        for (GateId output : output_gates_)
+        {
+            output_mask_.at(output) = 1;
+        }
+    }
+
+    /**
+     * Marks gate to be removed during next compaction.
+     * @param gateId -- gate id.
+     */
+    void markDead(GateId gateId) override
+    {
+        if (dead_mask_.at(gateId) == 0)
+        {
+            dead_mask_[gateId] = 1;
+            ++dead_gates_number_;
+        }
+    }
+
+    /**
+     * @param gateId -- gate id.
+     * @return true iff gate is marked as dead.
+     */
+    [[nodiscard]]
+    bool isDead(GateId gateId) const override
+    {
+        return dead_mask_[gateId] != 0;
+    }
+
+    /**
+     * @return true iff at least one gate is marked as dead.
+     */
+    [[nodiscard]]
+    bool hasDeadGates() const noexcept override
+    {
+        return dead_gates_number_ != 0;
+    }
+
+    /**
+     * Removes dead gates and renumbers alive gates, so that gate `order[i]` gets id `i`.
+     * The circuit is numbered topologically iff `order` is a topological order.
+     * @param order -- alive gates in their new order.
+     * @return map of old gate ids to new ones, where removed gates are mapped to `SIZE_MAX`.
+     */
+    GateIdContainer compact(GateIdContainer const& order) override
+    {
+        GateIdContainer old_to_new(gate_types_.size(), SIZE_MAX);
+        for (GateId newId = 0; newId < order.size(); ++newId)
+        {
+            assert(dead_mask_.at(order[newId]) == 0);
+            old_to_new.at(order[newId]) = newId;
+        }
+
+        std::vector<GateType> gate_types{};
+        FlatGateIdLists_ operands{};
+        FlatGateIdLists_ users{};
+        gate_types.reserve(order.size());
+        operands.reserve(order.size(), 0);
+        users.reserve(order.size(), 0);
+        input_gates_.clear();
+        numbered_topologically_ = true;
+
+        // Single buffer is reused for all gates to avoid per-gate allocations.
+        GateIdContainer buffer{};
+        for (GateId newId = 0; newId < order.size(); ++newId)
+        {
+            GateId const oldId = order[newId];
+            gate_types.push_back(gate_types_[oldId]);
+
+            buffer.clear();
+            for (GateId operand : operands_.get(oldId))
+            {
+                assert(old_to_new.at(operand) != SIZE_MAX);
+                buffer.push_back(old_to_new[operand]);
+                numbered_topologically_ = numbered_topologically_ && old_to_new[operand] < newId;
+            }
+            normalizeOperands_(gate_types_[oldId], buffer);
+            operands.append(buffer);
+
+            // Users of alive gates may still refer to dead gates, which are dropped here.
+            buffer.clear();
+            for (GateId user : users_.get(oldId))
+            {
+                if (old_to_new[user] != SIZE_MAX)
+                {
+                    buffer.push_back(old_to_new[user]);
+                }
+            }
+            std::sort(buffer.begin(), buffer.end());
+            users.append(buffer);
+
+            if (gate_types_[oldId] == GateType::INPUT)
+            {
+                input_gates_.push_back(newId);
+            }
+        }
+        gate_types_ = std::move(gate_types);
+        operands_   = std::move(operands);
+        users_      = std::move(users);
+
+        for (GateId& output : output_gates_)
+        {
+            assert(old_to_new.at(output) != SIZE_MAX);
+            output = old_to_new[output];
+        }
+        buildOutputMask_();
+
+        topological_order_.reset();
+        dead_mask_.assign(gate_types_.size(), 0);
+        dead_gates_number_ = 0;
+        return old_to_new;
+    }
+};
+
+}  // namespace csat
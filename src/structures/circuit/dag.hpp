@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -9,6 +11,7 @@
 #include "src/common/operators.hpp"
 #include "src/structures/assignment/vector_assignment.hpp"
 #include "src/structures/circuit/icircuit.hpp"
+#include "src/structures/circuit/imutable_circuit.hpp"
 #include "src/utility/logger.hpp"
 
 namespace csat
@@ -99,10 +102,53 @@ struct Node_
     {
         users_.push_back(gateId);
     }
+
+    void setId(GateId gateId) noexcept
+    {
+        id_ = gateId;
+    }
+
+    void setType(GateType type) noexcept
+    {
+        type_ = type;
+    }
+
+    void setOperands(GateIdContainer&& operands) noexcept
+    {
+        operands_ = std::move(operands);
+    }
+
+    [[nodiscard]]
+    GateIdContainer& getOperands() noexcept
+    {
+        return operands_;
+    }
+
+    [[nodiscard]]
+    GateIdContainer& getGateUsers() noexcept
+    {
+        return users_;
+    }
+
+    /* Inserts user keeping users sorted. */
+    void insertUser(GateId gateId)
+    {
+        users_.insert(std::upper_bound(users_.begin(), users_.end(), gateId), gateId);
+    }
+
+    /* Removes one occurrence of user, keeping users sorted. */
+    void removeUser(GateId gateId)
+    {
+        auto it = std::lower_bound(users_.begin(), users_.end(), gateId);
+        if (it != users_.end() && *it == gateId)
+        {
+            users_.erase(it);
+        }
+    }
 };
 
 /** Represents boolean circuit as Directed Acyclic Graph. **/
-class DAG : public ICircuit
+class DAG : public IMutableCircuit
 {
   protected:
     /* Carries all gates. */
@@ -111,13 +157,19 @@ class DAG : public ICircuit
     GateIdContainer input_gates_;
     /* Carries all output gates.. */
     GateIdContainer output_gates_;
+    /* Mask of gates, that are marked as dead and will be removed during compaction. */
+    BoolVector dead_mask_;
+    /* Number of gates, that are marked as dead. */
+    size_t dead_gates_number_ = 0;
 
   public:
     DAG(DAG const& dag)
-        : ICircuit()
+        : IMutableCircuit(dag)
         , gates_(dag.gates_)
         , input_gates_(dag.input_gates_)
         , output_gates_(dag.output_gates_)
+        , dead_mask_(dag.dead_mask_)
+        , dead_gates_number_(dag.dead_gates_number_)
     {
     }
 
@@ -141,6 +193,7 @@ class DAG : public ICircuit
     {
         buildGates_(std::forward<T>(gate_info));
         calculateGateUsers_();
+        dead_mask_.assign(gates_.size(), 0);
     }
 
     void buildGates_(GateInfoContainer const& gate_info)
@@ -248,7 +301,7 @@ class DAG : public ICircuit
      * @return Container with all operands (gate ids) of gate with id=gateId.
      */
     [[nodiscard]]
-    GateIdContainer const& getGateOperands(GateId gateId) const override
+    GateIdSpan getGateOperands(GateId gateId) const override
     {
         return getGate_(gateId).getOperands();
     };
@@ -258,11 +311,180 @@ class DAG : public ICircuit
      * @return Container with all gates, that use gate with id=gateId as operand.
      */
     [[nodiscard]]
-    GateIdContainer const& getGateUsers(GateId gateId) const override
+    GateIdSpan getGateUsers(GateId gateId) const override
     {
         return getGate_(gateId).getGateUsers();
     };
 
+    // ========== Circuit Modification ========== //
+    using IMutableCircuit::compact;
+
+    /**
+     * Adds new gate to the circuit.
+     * @param type -- type of new gate.
+     * @param operands -- operands of new gate.
+     * @return id of new gate.
+     */
+    GateId addGate(GateType type, GateIdContainer operands) override
+    {
+        GateId const gateId = gates_.size();
+        normalizeOperands_(type, operands);
+        for (GateId operand : operands)
+        {
+            // New gate has the largest id, so users stay sorted.
+            gates_.at(operand).addUser(gateId);
+        }
+        onGateAdded_(gateId, operands);
+        gates_.emplace_back(gateId, type, std::move(operands));
+        dead_mask_.push_back(0);
+
+        if (type == GateType::INPUT)
+        {
+            input_gates_.push_back(gateId);
+        }
+        return gateId;
+    }
+
+    /**
+     * Replaces type and operands of gate.
+     * @param gateId -- gate id.
+     * @param type -- new type of gate.
+     * @param operands -- new operands of gate.
+     */
+    void setGate(GateId gateId, GateType type, GateIdContainer operands) override
+    {
+        normalizeOperands_(type, operands);
+        Node_& gate = gates_.at(gateId);
+        for (GateId operand : gate.getOperands())
+        {
+            gates_[operand].removeUser(gateId);
+        }
+        for (GateId operand : operands)
+        {
+            gates_.at(operand).insertUser(gateId);
+        }
+
+        if (gate.getType() == GateType::INPUT && type != GateType::INPUT)
+        {
+            input_gates_.erase(std::lower_bound(input_gates_.begin(), input_gates_.end(), gateId));
+        }
+        else if (gate.getType() != GateType::INPUT && type == GateType::INPUT)
+        {
+            input_gates_.insert(std::lower_bound(input_gates_.begin(), input_gates_.end(), gateId), gateId);
+        }
+
+        onGateModified_(gateId, gate.getOperands(), operands);
+        gate.setType(type);
+        gate.setOperands(std::move(operands));
+    }
+
+    /**
+     * Replaces list of output gates.
+     * @param output_gates -- new output gates.
+     */
+    void setOutputGates(GateIdContainer output_gates) override
+    {
+        output_gates_ = std::move(output_gates);
+    }
+
+    /**
+     * Marks gate to be removed during next compaction.
+     * @param gateId -- gate id.
+     */
+    void markDead(GateId gateId) override
+    {
+        if (dead_mask_.at(gateId) == 0)
+        {
+            dead_mask_[gateId] = 1;
+            ++dead_gates_number_;
+        }
+    }
+
+    /**
+     * @param gateId -- gate id.
+     * @return true iff gate is marked as dead.
+     */
+    [[nodiscard]]
+    bool isDead(GateId gateId) const override
+    {
+        return dead_mask_[gateId] != 0;
+    }
+
+    /**
+     * @return true iff at least one gate is marked as dead.
+     */
+    [[nodiscard]]
+    bool hasDeadGates() const noexcept override
+    {
+        return dead_gates_number_ != 0;
+    }
+
+    /**
+     * Removes dead gates and renumbers alive gates, so that gate `order[i]` gets id `i`.
+     * Gates are moved, so no per-gate allocations are performed. The circuit is numbered
+     * topologically iff `order` is a topological order.
+     * @param order -- alive gates in their new order.
+     * @return map of old gate ids to new ones, where removed gates are mapped to `SIZE_MAX`.
+     */
+    GateIdContainer compact(GateIdContainer const& order) override
+    {
+        GateIdContainer old_to_new(gates_.size(), SIZE_MAX);
+        for (GateId newId = 0; newId < order.size(); ++newId)
+        {
+            assert(dead_mask_.at(order[newId]) == 0);
+            old_to_new.at(order[newId]) = newId;
+        }
+
+        std::vector<Node_> new_gates;
+        new_gates.reserve(order.size());
+        input_gates_.clear();
+        numbered_topologically_ = true;
+        for (GateId newId = 0; newId < order.size(); ++newId)
+        {
+            Node_& gate = new_gates.emplace_back(std::move(gates_[order[newId]]));
+            gate.setId(newId);
+
+            GateIdContainer& operands = gate.getOperands();
+            for (GateId& operand : operands)
+            {
+                assert(old_to_new.at(operand) != SIZE_MAX);
+                operand                 = old_to_new[operand];
+                numbered_topologically_ = numbered_topologically_ && operand < newId;
+            }
+            normalizeOperands_(gate.getType(), operands);
+
+            // Users of alive gates may still refer to dead gates, which are dropped here.
+            GateIdContainer& users = gate.getGateUsers();
+            size_t alive_users     = 0;
+            for (GateId user : users)
+            {
+                if (old_to_new[user] != SIZE_MAX)
+                {
+                    users[alive_users++] = old_to_new[user];
+                }
+            }
+            users.resize(alive_users);
+            std::sort(users.begin(), users.end());
+
+            if (gate.getType() == GateType::INPUT)
+            {
+                input_gates_.push_back(newId);
+            }
+        }
+        gates_ = std::move(new_gates);
+
+        for (GateId& output : output_gates_)
+        {
+            assert(old_to_new.at(output) != SIZE_MAX);
+            output = old_to_new[output];
+        }
+
+        topological_order_.reset();
+        dead_mask_.assign(gates_.size(), 0);
+        dead_gates_number_ = 0;
+        return old_to_new;
+    }
+
   protected:
     /* Returns reference to Node_. */
     [[nodiscard]]
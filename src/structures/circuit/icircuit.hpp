@@ -2,13 +2,17 @@
 
 #include <algorithm>
 #include <memory>
-#include <stack>
+#include <mutex>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "src/common/csat_types.hpp"
 #include "src/common/operators.hpp"
 #include "src/structures/assignment/vector_assignment.hpp"
 #include "src/structures/circuit/gate_info.hpp"
+#include "src/utility/levelization.hpp"
+#include "src/utility/thread_pool.hpp"
 
 namespace csat
 {
@@ -29,21 +33,38 @@ namespace csat
 class ICircuit
 {
   public:
-    ICircuit()                = default;
-    ICircuit(ICircuit const&) = default;
-    virtual ~ICircuit()       = default;
+    ICircuit()          = default;
+    virtual ~ICircuit() = default;
     ICircuit(GateInfoContainer const& /*unused*/, GateIdContainer const& /*unused*/){};
 
+    ICircuit(ICircuit const& circuit)
+        : numbered_topologically_(circuit.numbered_topologically_)
+    {
+        std::lock_guard const lock(circuit.topological_order_mutex_);
+        topological_order_ = circuit.topological_order_;
+    }
+
+    ICircuit& operator=(ICircuit const& circuit)
+    {
+        if (this != &circuit)
+        {
+            std::scoped_lock const lock(topological_order_mutex_, circuit.topological_order_mutex_);
+            topological_order_      = circuit.topological_order_;
+            numbered_topologically_ = circuit.numbered_topologically_;
+        }
+        return *this;
+    }
+
     // ========== Circuit Info ========== //
     /* Returns type of gate. */
     [[nodiscard]]
     virtual GateType getGateType(GateId gateId) const = 0;
     /* Returns operands of gate. */
     [[nodiscard]]
-    virtual GateIdContainer const& getGateOperands(GateId gateId) const = 0;
+    virtual GateIdSpan getGateOperands(GateId gateId) const = 0;
     /* Returns users of gate -- gates, that use current as operand. */
     [[nodiscard]]
-    virtual GateIdContainer const& getGateUsers(GateId gateId) const = 0;
+    virtual GateIdSpan getGateUsers(GateId gateId) const = 0;
     /* Returns number of gates in structures. */
     [[nodiscard]]
     virtual GateId getNumberOfGates() const = 0;
@@ -60,6 +81,48 @@ class ICircuit
     [[nodiscard]]
     virtual bool isOutputGate(GateId gateId) const = 0;
 
+    // ========== Topological Order ========== //
+    /**
+     * @return true iff each gate is known to have greater id than its operands, so that
+     * ids themselves form a topological order. Ids, given at construction, are not checked,
+     * while mutable circuits establish the property by compaction in a topological order,
+     * and keep track of it on further modifications.
+     */
+    [[nodiscard]]
+    bool isNumberedTopologically() const noexcept
+    {
+        return numbered_topologically_;
+    }
+
+    /**
+     * @return topological order of gates (users precede their operands), cached since the
+     * last modification of the circuit, which could break it, or nullptr if there is no such
+     * order. Once cached, the order isn't replaced until the circuit is modified, so the
+     * pointer stays valid while the circuit is only read, even by several threads.
+     */
+    [[nodiscard]]
+    GateIdContainer const* getCachedTopologicalOrder() const
+    {
+        std::lock_guard const lock(topological_order_mutex_);
+        return topological_order_.has_value() ? &*topological_order_ : nullptr;
+    }
+
+    /**
+     * Caches topological order of gates, in which users precede their operands, unless some
+     * order is already cached. Safe to call concurrently on an unmodified circuit. Mutable
+     * circuits drop the cache on modifications of gates, which may break the order, and on
+     * compaction, which, as any modification, must not run concurrently with other accesses
+     * to the circuit.
+     */
+    void cacheTopologicalOrder(GateIdContainer order) const
+    {
+        std::lock_guard const lock(topological_order_mutex_);
+        if (!topological_order_.has_value())
+        {
+            topological_order_ = std::move(order);
+        }
+    }
+
     // ========== Circuit Evaluation Methods ========== //
     /**
      * @param input_asmt -- some (partial) assignment.
@@ -67,80 +130,164 @@ class ICircuit
      * of gates, which values could be implied by input_asmt. Evaluates
      * only gates reachable from outputs.
      *
+     * Gates are evaluated in a single sweep over topological order of gates,
+     * reachable from outputs, so evaluation takes linear time regardless of
+     * the number of outputs. If a thread pool is given, gates are evaluated
+     * level by level, and gates of each level are evaluated in parallel.
+     *
+     * @param pool -- pool to evaluate gates in parallel, or nullptr.
      * @tparam AssignmentT -- structure to carry resulting assignment.
      */
     template<
         class AssignmentT = VectorAssignment<false>,
         typename          = std::enable_if_t<std::is_base_of_v<IAssignment, AssignmentT> > >
     [[nodiscard]]
-    std::unique_ptr<AssignmentT> evaluateCircuit(IAssignment const& input_asmt) const
+    std::unique_ptr<AssignmentT> evaluateCircuit(IAssignment const& input_asmt, utils::ThreadPool* pool = nullptr)
+        const
     {
         auto internal_asmt = std::make_unique<AssignmentT>();
         internal_asmt->ensureCapacity(getNumberOfGates());
-        evaluateCircuit_(input_asmt, getOutputGates(), *internal_asmt);
 
-        return internal_asmt;
-    }
+        StateVector states(getNumberOfGates(), GateState::UNDEFINED);
+        auto const evaluate_gate = [this, &input_asmt, &states](GateId gateId)
+        {
+            // Gate state is set or gate is Input. If gate is Input, its
+            // state must be either set in input_asmt, or be Unknown.
+            GateType const type = getGateType(gateId);
+            states[gateId]      = (type == GateType::INPUT || !input_asmt.isUndefined(gateId))
+                                      ? input_asmt.getGateState(gateId)
+                                      : evaluateOperator_(type, getGateOperands(gateId), states);
+        };
 
-  protected:
-    void evaluateCircuit_(IAssignment const& input_asmt, GateIdContainer const& sinks, IAssignment& internal_asmt) const
-    {
-        for (auto sink : sinks)
+        GateIdContainer const order = evaluationOrder_(input_asmt);
+        if (pool == nullptr)
         {
-            evaluateGate_(sink, input_asmt, internal_asmt);
+            std::for_each(order.begin(), order.end(), evaluate_gate);
         }
+        else
+        {
+            // Operands of assigned gates are not evaluated, so such gates are of level zero.
+            utils::Levelization const levels(
+                order,
+                getNumberOfGates(),
+                [this, &input_asmt](GateId gateId)
+                { return input_asmt.isUndefined(gateId) ? getGateOperands(gateId) : GateIdSpan{}; });
+            utils::parallelForEachLevel(*pool, levels, evaluate_gate);
+        }
+        for (GateId const gateId : order)
+        {
+            internal_asmt->assign(gateId, states[gateId]);
+        }
+
+        return internal_asmt;
     }
 
-    /* Internal purpose gate evaluation. */
-    GateState evaluateGate_(GateId gateId, IAssignment const& input_asmt, IAssignment& internal_asmt) const
-    {
-        std::stack<GateId> queue_{};
-        queue_.push(gateId);
-        BoolVector evaluated_(getNumberOfGates(), 0);
+  protected:
+    /* Topological order of gates, which is valid until the circuit is modified. */
+    mutable std::optional<GateIdContainer> topological_order_{};
+    /* Guards `topological_order_`, which const methods may fill concurrently. */
+    mutable std::mutex topological_order_mutex_{};
+    /* True iff each gate has greater id than its operands. */
+    bool numbered_topologically_ = false;
 
-        auto get_gate_state_ = [&input_asmt, &internal_asmt](GateId operand)
-        {
-            return (
-                internal_asmt.isUndefined(operand) ? input_asmt.getGateState(operand)
-                                                   : internal_asmt.getGateState(operand));
-        };
+    /**
+     * @return gates, reachable from outputs, in topological order. Search doesn't descend
+     * into operands of gates, which are assigned by `input_asmt`, since they aren't evaluated.
+     */
+    [[nodiscard]]
+    GateIdContainer evaluationOrder_(IAssignment const& input_asmt) const
+    {
+        GateIdContainer order{};
+        order.reserve(getNumberOfGates());
+        BoolVector visited(getNumberOfGates(), 0);
+        // Gate and number of its operands, which were already pushed.
+        std::vector<std::pair<GateId, size_t> > stack{};
 
-        while (!queue_.empty())
+        for (GateId const sink : getOutputGates())
         {
-            GateId const currentGateId = queue_.top();
-
-            // Gate state is set or gate is Input. If gate is Input, its
-            // state must be either set in input_asmt, or be Unknown.
-            if (getGateType(currentGateId) == GateType::INPUT || !input_asmt.isUndefined(currentGateId))
+            if (visited[sink] != 0)
             {
-                internal_asmt.assign(currentGateId, input_asmt.getGateState(currentGateId));
-                evaluated_.at(currentGateId) = 1;
-                queue_.pop();
                 continue;
             }
-
-            bool operandsEvaluated = true;
-            for (auto operandId : getGateOperands(currentGateId))
+            visited[sink] = 1;
+            stack.emplace_back(sink, 0);
+            while (!stack.empty())
             {
-                if (evaluated_.at(operandId) == 0)
+                auto& [gateId, next_operand] = stack.back();
+                GateIdSpan const operands    = getGateOperands(gateId);
+                if (next_operand < operands.size() && input_asmt.isUndefined(gateId))
                 {
-                    operandsEvaluated = false;
-                    queue_.push(operandId);
+                    GateId const operand = operands[next_operand++];
+                    if (visited[operand] == 0)
+                    {
+                        visited[operand] = 1;
+                        stack.emplace_back(operand, 0);
+                    }
+                    continue;
                 }
+                order.push_back(gateId);
+                stack.pop_back();
             }
+        }
 
-            if (operandsEvaluated)
-            {
-                op::OperatorNT<GateId> oper = op::getOperatorNT<GateId>(getGateType(currentGateId));
+        return order;
+    }
 
-                internal_asmt.assign(currentGateId, oper(getGateOperands(currentGateId), get_gate_state_));
-                evaluated_.at(currentGateId) = 1;
-                queue_.pop();
-                continue;
-            }
+    /**
+     * Evaluates operator gate by states of its operands, which must be already evaluated.
+     */
+    static GateState evaluateOperator_(GateType type, GateIdSpan operands, StateVector const& states)
+    {
+        switch (type)
+        {
+            case GateType::NOT:
+                return op::NOT(states[operands[0]]);
+            case GateType::AND:
+                return foldOperands_<&op::AND, GateState::FALSE>(operands, states);
+            case GateType::NAND:
+                return op::NOT(foldOperands_<&op::AND, GateState::FALSE>(operands, states));
+            case GateType::OR:
+                return foldOperands_<&op::OR, GateState::TRUE>(operands, states);
+            case GateType::NOR:
+                return op::NOT(foldOperands_<&op::OR, GateState::TRUE>(operands, states));
+            case GateType::XOR:
+                return foldOperands_<&op::XOR, GateState::UNDEFINED>(operands, states);
+            case GateType::NXOR:
+                return op::NOT(foldOperands_<&op::XOR, GateState::UNDEFINED>(operands, states));
+            case GateType::IFF:
+            case GateType::BUFF:
+                return states[operands[0]];
+            case GateType::MUX:
+                return op::MUX(states[operands[0]], states[operands[1]], states[operands[2]]);
+            case GateType::CONST_FALSE:
+                return GateState::FALSE;
+            case GateType::CONST_TRUE:
+                return GateState::TRUE;
+            default:
+                return GateState::UNDEFINED;
         }
+    }
 
-        return internal_asmt.getGateState(gateId);
+    /**
+     * Folds states of operands with a binary operator. Folding stops as soon as
+     * `TerminalState` is reached, unless it is `UNDEFINED`.
+     */
+    template<op::Operator Oper, GateState TerminalState>
+    static GateState foldOperands_(GateIdSpan operands, StateVector const& states)
+    {
+        GateState state = states[operands[0]];
+        for (size_t idx = 1; idx < operands.size(); ++idx)
+        {
+            if constexpr (TerminalState != GateState::UNDEFINED)
+            {
+                if (state == TerminalState)
+                {
+                    return state;
+                }
+            }
+            state = Oper(state, states[operands[idx]], GateState::UNDEFINED);
+        }
+        return state;
     }
 };
 
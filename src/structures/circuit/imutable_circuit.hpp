@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/icircuit.hpp"
+#include "src/utility/converters.hpp"
+
+namespace csat
+{
+
+/**
+ * Interface of circuits, that may be modified in place.
+ *
+ * Modifications keep the same invariants as construction from `GateInfoContainer`:
+ * operands of symmetric operators are sorted in ascending order, and users of
+ * each gate are listed in ascending order (with repetitions, if a user has the
+ * same operand several times).
+ *
+ * Gate removal is lazy: `markDead` only marks a gate, while gates ids stay valid
+ * until `compact` is called. Dead gates must not be used as operands or outputs
+ * by alive gates at the moment of compaction. Users lists of alive gates may
+ * still reference dead gates until compaction.
+ *
+ * Note that any modification invalidates views returned by `getGateOperands`
+ * and `getGateUsers`.
+ */
+class IMutableCircuit : public ICircuit
+{
+  public:
+    IMutableCircuit()                       = default;
+    IMutableCircuit(IMutableCircuit const&) = default;
+    ~IMutableCircuit() override             = default;
+
+    // ========== Circuit Modification ========== //
+    /* Adds new gate to the circuit. Returns its id, which is equal to previous number of gates. */
+    virtual GateId addGate(GateType type, GateIdContainer operands) = 0;
+    /* Replaces type and all operands of gate. */
+    virtual void setGate(GateId gateId, GateType type, GateIdContainer operands) = 0;
+    /* Replaces list of output gates. */
+    virtual void setOutputGates(GateIdContainer output_gates) = 0;
+    /* Marks gate to be removed from the circuit during next compaction. */
+    virtual void markDead(GateId gateId) = 0;
+    /* Returns true iff gate is marked as dead. */
+    [[nodiscard]]
+    virtual bool isDead(GateId gateId) const = 0;
+    /* Returns true iff there is at least one gate marked as dead. */
+    [[nodiscard]]
+    virtual bool hasDeadGates() const = 0;
+    /**
+     * Removes dead gates from the circuit and renumbers alive gates, so that
+     * the gate `order[i]` gets id `i`. `order` must list each alive gate exactly once.
+     *
+     * @return map of old gate ids to new ones, where removed gates are mapped to `SIZE_MAX`.
+     */
+    virtual GateIdContainer compact(GateIdContainer const& order) = 0;
+
+    /**
+     * Replaces all occurrences of `old_operand` among operands of gate by `new_operand`.
+     */
+    virtual void replaceOperand(GateId gateId, GateId old_operand, GateId new_operand)
+    {
+        GateIdSpan const operands = getGateOperands(gateId);
+        GateIdContainer new_operands(operands.begin(), operands.end());
+        std::replace(new_operands.begin(), new_operands.end(), old_operand, new_operand);
+        setGate(gateId, getGateType(gateId), std::move(new_operands));
+    }
+
+    /**
+     * Replaces type and operands of gate, only if they differ from the current ones.
+     * @return true iff gate was modified.
+     */
+    bool updateGate(GateId gateId, GateType type, GateIdContainer const& operands)
+    {
+        // Operands of symmetric gates are kept sorted, so their order doesn't matter.
+        GateIdSpan const old_operands = getGateOperands(gateId);
+        bool const same_operands =
+            utils::symmetricOperatorQ(type)
+                ? std::is_permutation(old_operands.begin(), old_operands.end(), operands.begin(), operands.end())
+                : std::equal(old_operands.begin(), old_operands.end(), operands.begin(), operands.end());
+        if (getGateType(gateId) == type && same_operands)
+        {
+            return false;
+        }
+        setGate(gateId, type, operands);
+        return true;
+    }
+
+    /**
+     * Makes all alive users of gate `from`, as well as outputs equal to `from`,
+     * to refer to gate `to` instead. Gate `from` is left without alive users.
+     */
+    virtual void redirectUsers(GateId from, GateId to)
+    {
+        if (from == to)
+        {
+            return;
+        }
+
+        // Users are sorted, so repeated users are adjacent.
+        GateIdSpan const users = getGateUsers(from);
+        GateIdContainer unique_users(users.begin(), users.end());
+        unique_users.erase(std::unique(unique_users.begin(), unique_users.end()), unique_users.end());
+        for (GateId user : unique_users)
+        {
+            if (!isDead(user))
+            {
+                replaceOperand(user, from, to);
+            }
+        }
+
+        if (std::find(getOutputGates().begin(), getOutputGates().end(), from) != getOutputGates().end())
+        {
+            GateIdContainer output_gates(getOutputGates());
+            std::replace(output_gates.begin(), output_gates.end(), from, to);
+            setOutputGates(std::move(output_gates));
+        }
+    }
+
+    /**
+     * Removes dead gates from the circuit, preserving relative order of alive gates.
+     *
+     * @return map of old gate ids to new ones, where removed gates are mapped to `SIZE_MAX`.
+     */
+    GateIdContainer compact()
+    {
+        GateIdContainer order{};
+        order.reserve(getNumberOfGates());
+        for (GateId gateId = 0; gateId < getNumberOfGates(); ++gateId)
+        {
+            if (!isDead(gateId))
+            {
+                order.push_back(gateId);
+            }
+        }
+        return compact(order);
+    }
+
+  protected:
+    /* Drops cached topological order, since new gate `gateId` is not listed in it. */
+    void onGateAdded_(GateId gateId, GateIdContainer const& operands) noexcept
+    {
+        topological_order_.reset();
+        keepTopologicalNumbering_(gateId, operands);
+    }
+
+    /**
+     * Keeps track of topological order, when gate `gateId` gets new `operands` instead of
+     * `old_operands`. Depth first search doesn't look at types of gates, so cached order stays
+     * equal to a new sorting if operands are left as they are, e.g. if only the type is changed,
+     * and is dropped otherwise. Note that `markDead` doesn't drop cached order either, so passes,
+     * which edit gates in place, sort the circuit anew only after edits of its structure.
+     */
+    void onGateModified_(GateId gateId, GateIdSpan old_operands, GateIdContainer const& operands) noexcept
+    {
+        if (!std::equal(old_operands.begin(), old_operands.end(), operands.begin(), operands.end()))
+        {
+            topological_order_.reset();
+        }
+        keepTopologicalNumbering_(gateId, operands);
+    }
+
+    /* Topological numbering is kept only if the gate has greater id than all of its operands. */
+    void keepTopologicalNumbering_(GateId gateId, GateIdContainer const& operands) noexcept
+    {
+        numbered_topologically_ = numbered_topologically_ &&
+                                  std::all_of(operands.begin(), operands.end(), [gateId](GateId operand)
+                                              { return operand < gateId; });
+    }
+
+    /* Brings operands of gate to the canonical order, used by `GateInfo`. */
+    static void normalizeOperands_(GateType type, GateIdContainer& operands)
+    {
+        if (utils::symmetricOperatorQ(type))
+        {
+            std::sort(operands.begin(), operands.end());
+        }
+    }
+};
+
+}  // namespace csat
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -15,7 +16,7 @@ namespace csat::utils
  * @return Reference to a string->GateType map.
  */
 [[maybe_unused]]
-inline GateType stringToGateType(std::string const& type_name)
+inline GateType stringToGateType(std::string_view type_name)
 {
     static std::map<std::string, GateType, std::less<>> const _type_map{
         {"NOT",         GateType::NOT        },
@@ -37,7 +38,12 @@ inline GateType stringToGateType(std::string const& type_name)
         {"vdd",         GateType::CONST_TRUE }
     };
 
-    return _type_map.at(type_name);
+    auto const search = _type_map.find(type_name);
+    if (search == _type_map.end())
+    {
+        throw std::out_of_range("Unknown gate type \"" + std::string(type_name) + "\".");
+    }
+    return search->second;
 }
 
 [[maybe_unused]]
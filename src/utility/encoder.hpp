@@ -1,13 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <map>
-#include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "src/common/csat_types.hpp"
+#include "src/utility/profiler.hpp"
 
 namespace csat::utils
 {
@@ -89,14 +92,33 @@ class GateEncoder
 
 /**
  * GateEncoder specification for string, that allows usage of string_view.
+ *
+ * Names are interned in a single contiguous arena and indexed by an open addressing
+ * hash table, while gate ids refer to names through an id-permutation vector. Thus
+ * renumbering of gates (see `renumber`) only composes that permutation and never
+ * touches names themselves, which are resolved only when gates are decoded.
  */
 template<>
 class GateEncoder<std::string>
 {
   protected:
-    size_t next_var_ = 0;
-    std::map<std::string, GateId, std::less<>> encoder_;
-    std::map<GateId, std::string> decoder_;
+    /* Marker of an empty hash slot or of a dropped name. */
+    static constexpr size_t NONE_ = SIZE_MAX;
+
+    /* Concatenation of all interned names. */
+    std::string names_{};
+    /* Name `i` occupies `names_[name_offsets_[i], name_offsets_[i + 1])`. */
+    std::vector<size_t> name_offsets_{0};
+    /* Hashes of interned names, kept to avoid rehashing of strings on growth. */
+    std::vector<size_t> name_hashes_{};
+    /* Hash index with linear probing, holds indices of interned names. */
+    std::vector<size_t> slots_{};
+    /* Map of gate ids to indices of interned names. */
+    GateIdContainer id_to_name_{};
+    /* Map of indices of interned names to gate ids, `NONE_` for dropped names. */
+    GateIdContainer name_to_id_{};
+    /* Number of interned names, that are not used by any gate. */
+    size_t dropped_names_ = 0;
 
   public:
     GateEncoder()                   = default;
@@ -105,59 +127,207 @@ class GateEncoder<std::string>
 
     GateId encodeGate(std::string_view const& key) noexcept
     {
-        auto search = encoder_.find(key);
-        if (search == encoder_.end())
-        {
-            // TODO: rly string???
-            decoder_[next_var_]        = std::string(key);
-            encoder_[std::string(key)] = next_var_;
-            return next_var_++;
-        }
-        else
+        size_t const hash = std::hash<std::string_view>{}(key);
+        size_t const slot = findSlot_(key, hash);
+        if (slot < slots_.size() && slots_[slot] != NONE_)
         {
-            return search->second;
+            size_t const name = slots_[slot];
+            if (name_to_id_[name] == NONE_)
+            {
+                // Name was dropped by renumbering, so it gets a new id.
+                --dropped_names_;
+                name_to_id_[name] = id_to_name_.size();
+                id_to_name_.push_back(name);
+            }
+            return name_to_id_[name];
         }
+
+        size_t const name = name_hashes_.size();
+        names_.append(key.data(), key.size());
+        name_offsets_.push_back(names_.size());
+        name_hashes_.push_back(hash);
+        name_to_id_.push_back(id_to_name_.size());
+        id_to_name_.push_back(name);
+        insertIntoIndex_(name);
+        return name_to_id_[name];
     };
 
     [[nodiscard]]
     std::string decodeGate(GateId id) const
     {
-        return decoder_.at(id);
+        return std::string(decodeGateView(id));
+    };
+
+    /**
+     * @param id -- id of gate in encoding from 0 through N.
+     * @return View of original gate name, which is valid until next modification of encoder.
+     */
+    [[nodiscard]]
+    std::string_view decodeGateView(GateId id) const
+    {
+        return getName_(id_to_name_.at(id));
     };
 
     [[nodiscard]]
     bool keyExists(std::string_view const& key) const
     {
-        return encoder_.find(key) != encoder_.end();
+        size_t const slot = findSlot_(key, std::hash<std::string_view>{}(key));
+        return slot < slots_.size() && slots_[slot] != NONE_ && name_to_id_[slots_[slot]] != NONE_;
     };
 
     [[nodiscard]]
     size_t size() const
     {
-        return next_var_;
+        return id_to_name_.size();
     }
 
     void clear()
     {
-        next_var_ = 0;
-        encoder_.clear();
-        decoder_.clear();
+        names_.clear();
+        name_offsets_.assign(1, 0);
+        name_hashes_.clear();
+        slots_.clear();
+        id_to_name_.clear();
+        name_to_id_.clear();
+        dropped_names_ = 0;
     }
-};
 
-template<class KeyT>
-inline std::unique_ptr<GateEncoder<KeyT>> mergeGateEncoders(
-    GateEncoder<KeyT> const& first,
-    GateEncoder<GateId> const& second) noexcept
-{
-    GateEncoder<KeyT> _newEncoder;
+    /**
+     * Renumbers gates according to map of old gate ids to new ones (e.g. returned
+     * by a circuit compaction). Gates mapped to `SIZE_MAX`, as well as gates, which
+     * are not covered by the map, are dropped. Names are neither copied nor rehashed.
+     *
+     * @param old_to_new -- injective map of old gate ids onto `0, ..., K - 1`.
+     */
+    void renumber(GateIdContainer const& old_to_new)
+    {
+        CSAT_PROFILE_SCOPE("GateEncoder::renumber");
+        size_t new_size = 0;
+        for (GateId new_id : old_to_new)
+        {
+            new_size += (new_id != SIZE_MAX) ? 1 : 0;
+        }
+
+        GateIdContainer new_id_to_name(new_size, NONE_);
+        for (GateId old_id = 0; old_id < id_to_name_.size(); ++old_id)
+        {
+            size_t const name   = id_to_name_[old_id];
+            GateId const new_id = (old_id < old_to_new.size()) ? old_to_new[old_id] : SIZE_MAX;
+            if (new_id == SIZE_MAX)
+            {
+                name_to_id_[name] = NONE_;
+                ++dropped_names_;
+                continue;
+            }
+            new_id_to_name.at(new_id) = name;
+            name_to_id_[name]         = new_id;
+        }
+        id_to_name_ = std::move(new_id_to_name);
+
+        // Dropped names are kept for a while, since simplifications tend to drop
+        // and recreate the same names, but they must not dominate the arena.
+        if (dropped_names_ > id_to_name_.size())
+        {
+            collectGarbage_();
+        }
+    }
 
-    for (size_t code_two = 0; code_two < second.size(); ++code_two)
+  protected:
+    [[nodiscard]]
+    std::string_view getName_(size_t name) const
     {
-        _newEncoder.encodeGate(first.decodeGate(second.decodeGate(code_two)));
+        return std::string_view(names_).substr(name_offsets_[name], name_offsets_[name + 1] - name_offsets_[name]);
     }
 
-    return std::make_unique<GateEncoder<KeyT>>(_newEncoder);
-}
+    /**
+     * Finds slot of hash index, that either holds `key` or is the empty slot, where it
+     * should be inserted. Returns `slots_.size()` if index is not allocated yet.
+     */
+    [[nodiscard]]
+    size_t findSlot_(std::string_view const& key, size_t hash) const
+    {
+        if (slots_.empty())
+        {
+            return 0;
+        }
+
+        size_t const mask = slots_.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            size_t const name = slots_[slot];
+            if (name == NONE_ || (name_hashes_[name] == hash && getName_(name) == key))
+            {
+                return slot;
+            }
+        }
+    }
+
+    /* Inserts interned name into hash index, keeping its load factor at most 1/2. */
+    void insertIntoIndex_(size_t name)
+    {
+        if (2 * name_hashes_.size() > slots_.size())
+        {
+            rebuildIndex_(std::max<size_t>(16, 4 * name_hashes_.size()));
+            return;
+        }
+        size_t const mask = slots_.size() - 1;
+        size_t slot       = name_hashes_[name] & mask;
+        while (slots_[slot] != NONE_)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = name;
+    }
+
+    /* Rebuilds hash index of all interned names with given capacity, rounded up to power of two. */
+    void rebuildIndex_(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        slots_.assign(size, NONE_);
+        size_t const mask = size - 1;
+        for (size_t name = 0; name < name_hashes_.size(); ++name)
+        {
+            size_t slot = name_hashes_[name] & mask;
+            while (slots_[slot] != NONE_)
+            {
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = name;
+        }
+    }
+
+    /* Removes dropped names from arena, so that names get indices equal to ids of their gates. */
+    void collectGarbage_()
+    {
+        std::string names{};
+        std::vector<size_t> name_offsets{0};
+        std::vector<size_t> name_hashes{};
+        name_offsets.reserve(id_to_name_.size() + 1);
+        name_hashes.reserve(id_to_name_.size());
+        for (size_t const name : id_to_name_)
+        {
+            names.append(getName_(name));
+            name_offsets.push_back(names.size());
+            name_hashes.push_back(name_hashes_[name]);
+        }
+
+        names_        = std::move(names);
+        name_offsets_ = std::move(name_offsets);
+        name_hashes_  = std::move(name_hashes);
+        name_to_id_.resize(id_to_name_.size());
+        for (GateId id = 0; id < id_to_name_.size(); ++id)
+        {
+            id_to_name_[id] = id;
+            name_to_id_[id] = id;
+        }
+        dropped_names_ = 0;
+        rebuildIndex_(2 * name_hashes_.size());
+    }
+};
 
 }  // namespace csat::utils
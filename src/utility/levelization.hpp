@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/utility/thread_pool.hpp"
+
+namespace csat::utils
+{
+
+/**
+ * Partition of gates into levels by their depth: gates without operands are of level
+ * zero, and each other gate is one level deeper than its deepest operand. Operands of
+ * a gate are always at lower levels, so gates of the same level are independent, and
+ * may be processed in parallel once all lower levels are processed.
+ *
+ * Gates of each level are stored in the order, in which they appear in the topological
+ * order, the levelization was built from, so that sweeps over levels are deterministic.
+ */
+class Levelization
+{
+  protected:
+    /* Gates sorted by their levels. */
+    GateIdContainer gates_{};
+    /* Gates of level `i` are `gates_[level_begin_[i], level_begin_[i + 1])`. */
+    std::vector<size_t> level_begin_{0};
+
+  public:
+    Levelization() = default;
+
+    /**
+     * @param order -- gates in topological order, where operands precede their users.
+     *        Only these gates are levelized.
+     * @param gates_number -- number of gates of circuit, i.e. upper bound of gate ids.
+     * @param operands_of -- callable, which returns operands of a gate. Operands of
+     *        each gate must precede it in `order`.
+     */
+    template<class OperandsOf>
+    Levelization(GateIdContainer const& order, size_t gates_number, OperandsOf const& operands_of)
+    {
+        std::vector<size_t> level(gates_number, 0);
+        size_t levels_number = order.empty() ? 0 : 1;
+        for (GateId const gateId : order)
+        {
+            for (GateId const operand : operands_of(gateId))
+            {
+                level[gateId] = std::max(level[gateId], level[operand] + 1);
+            }
+            levels_number = std::max(levels_number, level[gateId] + 1);
+        }
+
+        // Stable counting sort of gates by their levels.
+        level_begin_.assign(levels_number + 1, 0);
+        for (GateId const gateId : order)
+        {
+            ++level_begin_[level[gateId] + 1];
+        }
+        for (size_t idx = 1; idx < level_begin_.size(); ++idx)
+        {
+            level_begin_[idx] += level_begin_[idx - 1];
+        }
+        gates_.resize(order.size());
+        std::vector<size_t> position(level_begin_.begin(), level_begin_.end() - 1);
+        for (GateId const gateId : order)
+        {
+            gates_[position[level[gateId]]++] = gateId;
+        }
+    }
+
+    /**
+     * @return number of levels, i.e. depth of the deepest gate plus one.
+     */
+    [[nodiscard]]
+    size_t getNumberOfLevels() const noexcept
+    {
+        return level_begin_.size() - 1;
+    }
+
+    /**
+     * @return gates of given level.
+     */
+    [[nodiscard]]
+    GateIdSpan getLevel(size_t level) const
+    {
+        return {gates_.data() + level_begin_.at(level), level_begin_.at(level + 1) - level_begin_[level]};
+    }
+
+    /**
+     * @return all levelized gates, sorted by their levels.
+     */
+    [[nodiscard]]
+    GateIdContainer const& getGates() const noexcept
+    {
+        return gates_;
+    }
+};
+
+/**
+ * Calls `body(gateId)` for each levelized gate, level by level, so that body is called on
+ * a gate only after it was called on all of its operands. Gates of the same level are
+ * processed in parallel, so the body must only write data of its own gate.
+ *
+ * @param pool -- pool, which runs the sweep.
+ * @param levels -- levelization of gates.
+ * @param body -- callable `(GateId)`.
+ * @param grain -- minimal number of gates, processed by a single thread at once.
+ */
+template<class Body>
+void parallelForEachLevel(ThreadPool& pool, Levelization const& levels, Body const& body, size_t grain = 1024)
+{
+    for (size_t level = 0; level < levels.getNumberOfLevels(); ++level)
+    {
+        GateIdSpan const gates = levels.getLevel(level);
+        pool.parallelForRanges(
+            gates.size(),
+            grain,
+            [&gates, &body](size_t begin, size_t end)
+            {
+                for (size_t idx = begin; idx < end; ++idx)
+                {
+                    body(gates[idx]);
+                }
+            });
+    }
+}
+
+}  // namespace csat::utils
@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <ctime>
 #include <iostream>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -27,32 +29,37 @@ static LogLevel const CompileLogLevel = LogLevel::DEBUG;
 static LogLevel const CompileLogLevel = LogLevel::INFO;
 #endif
 
-// Basic logging to std::cout.
-inline void LOG_OUT()
+// Guards standard streams, so lines logged by concurrently
+// running simplifications are not interleaved with each other.
+inline std::mutex& getLogStreamMutex_()
 {
-    std::cout << std::endl;
+    static std::mutex mutex;
+    return mutex;
 }
 
-// Basic logging to std::cout.
-template<class T, class... Args>
-inline void LOG_OUT(T const& t, Args const&... args)
+// Writes all `args` to `stream` as one line at once.
+template<class... Args>
+inline void LOG_LINE_(std::ostream& stream, Args const&... args)
 {
-    std::cout << t;
-    LOG_OUT(args...);
+    std::ostringstream line;
+    (line << ... << args);
+
+    std::lock_guard<std::mutex> const lock(getLogStreamMutex_());
+    stream << line.str() << std::endl;
 }
 
-// Basic logging to std::cerr.
-inline void LOG_ERR()
+// Basic logging to std::cout.
+template<class... Args>
+inline void LOG_OUT(Args const&... args)
 {
-    std::cerr << std::endl;
+    LOG_LINE_(std::cout, args...);
 }
 
 // Basic logging to std::cerr.
-template<class T, class... Args>
-inline void LOG_ERR(T const& t, Args const&... args)
+template<class... Args>
+inline void LOG_ERR(Args const&... args)
 {
-    std::cerr << t;
-    LOG_ERR(args...);
+    LOG_LINE_(std::cerr, args...);
 }
 
 class Logger
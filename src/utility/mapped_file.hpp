@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CSAT_MAPPED_FILE_USE_MMAP
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace csat::utils
+{
+
+/**
+ * Read-only view of a whole file, which is memory-mapped if platform supports it,
+ * and is read into memory otherwise. Content is available until object is destroyed.
+ */
+class MappedFile
+{
+  public:
+    /* Expected access pattern, which is used as a hint for the kernel. */
+    enum class Access : uint8_t
+    {
+        /* File is read once from start to end. */
+        SEQUENTIAL,
+        /* Whole file is used at random, so it is read ahead at once. */
+        RANDOM
+    };
+
+  private:
+#ifdef CSAT_MAPPED_FILE_USE_MMAP
+    /* Start of mapped region, or nullptr if file is empty. */
+    void* data_ = nullptr;
+    /* Size of file in bytes. */
+    size_t size_ = 0;
+#else
+    /* Content of file. */
+    std::string content_{};
+#endif
+
+  public:
+    /**
+     * Maps file at `path` into memory. Aborts if file can't be opened.
+     * @param path -- path to the file.
+     * @param access -- expected access pattern.
+     */
+    explicit MappedFile(std::string const& path, Access access = Access::SEQUENTIAL)
+    {
+#ifdef CSAT_MAPPED_FILE_USE_MMAP
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        struct stat file_stat
+        {
+        };
+        if (fd < 0 || ::fstat(fd, &file_stat) != 0)
+        {
+            std::cerr << "Can't open file \"" << path << "\"." << std::endl;
+            std::abort();
+        }
+
+        size_ = static_cast<size_t>(file_stat.st_size);
+        if (size_ > 0)
+        {
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data_ == MAP_FAILED)
+            {
+                std::cerr << "Can't map file \"" << path << "\" into memory." << std::endl;
+                std::abort();
+            }
+            ::madvise(data_, size_, access == Access::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_WILLNEED);
+        }
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Can't open file \"" << path << "\"." << std::endl;
+            std::abort();
+        }
+        content_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        (void)access;
+#endif
+    }
+
+    MappedFile(MappedFile const&)            = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    ~MappedFile()
+    {
+#ifdef CSAT_MAPPED_FILE_USE_MMAP
+        if (data_ != nullptr)
+        {
+            ::munmap(data_, size_);
+        }
+#endif
+    }
+
+    /**
+     * @return view of the whole file content.
+     */
+    [[nodiscard]]
+    std::string_view view() const
+    {
+#ifdef CSAT_MAPPED_FILE_USE_MMAP
+        return {static_cast<char const*>(data_), size_};
+#else
+        return content_;
+#endif
+    }
+};
+
+}  // namespace csat::utils
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace csat::profiling
+{
+
+/**
+ * Accumulated measurements of a profiled code section. Sections are updated
+ * concurrently by all threads, so their fields are relaxed atomics.
+ */
+struct Section
+{
+    explicit Section(std::string name_)
+        : name(std::move(name_))
+    {
+    }
+
+    std::string const name;
+    /* Number of executions of a timed scope. */
+    std::atomic<std::uint64_t> calls{0};
+    /* Total wall time of executions of a timed scope. */
+    std::atomic<std::uint64_t> nanoseconds{0};
+    /* Value of a counter. */
+    std::atomic<std::uint64_t> count{0};
+};
+
+/**
+ * Process wide registry of profiled sections. Sections are created once per name
+ * and are never destroyed, so references to them may be cached by call sites.
+ */
+class Profiler
+{
+    std::deque<Section> sections_{};
+    std::map<std::string, Section*, std::less<>> by_name_{};
+    mutable std::mutex mutex_;
+
+    Profiler() = default;
+
+  public:
+    Profiler(Profiler const&)            = delete;
+    Profiler& operator=(Profiler const&) = delete;
+
+    static Profiler& getInstance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    /**
+     * @return section with given name, which is created on the first request.
+     */
+    Section& getSection(std::string const& name)
+    {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        if (auto it = by_name_.find(name); it != by_name_.end())
+        {
+            return *it->second;
+        }
+        Section& section = sections_.emplace_back(name);
+        by_name_[name]   = &section;
+        return section;
+    }
+
+    /**
+     * Resets measurements of all sections.
+     */
+    void reset()
+    {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        for (Section& section : sections_)
+        {
+            section.calls.store(0, std::memory_order_relaxed);
+            section.nanoseconds.store(0, std::memory_order_relaxed);
+            section.count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Writes table of all sections, which were executed or counted, ordered by decreasing total time.
+     */
+    void report(std::ostream& stream) const
+    {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        std::vector<Section const*> sections{};
+        for (Section const& section : sections_)
+        {
+            bool const executed = section.calls.load(std::memory_order_relaxed) != 0;
+            if (executed || section.count.load(std::memory_order_relaxed) != 0)
+            {
+                sections.push_back(&section);
+            }
+        }
+        auto const total_time = [](Section const* section)
+        { return section->nanoseconds.load(std::memory_order_relaxed); };
+        std::stable_sort(
+            sections.begin(),
+            sections.end(),
+            [&total_time](Section const* lhs, Section const* rhs) { return total_time(lhs) > total_time(rhs); });
+
+        stream << std::left << std::setw(48) << "Section" << std::right << std::setw(14) << "Calls" << std::setw(14)
+               << "Total, ms" << std::setw(14) << "Avg, ns" << std::setw(14) << "Count" << "\n";
+        for (Section const* section : sections)
+        {
+            std::uint64_t const calls       = section->calls.load(std::memory_order_relaxed);
+            std::uint64_t const nanoseconds = section->nanoseconds.load(std::memory_order_relaxed);
+            stream << std::left << std::setw(48) << section->name << std::right << std::setw(14) << calls
+                   << std::setw(14) << std::fixed << std::setprecision(3) << static_cast<double>(nanoseconds) / 1e6
+                   << std::setw(14) << std::setprecision(1)
+                   << (calls == 0 ? 0.0 : static_cast<double>(nanoseconds) / static_cast<double>(calls))
+                   << std::setw(14) << section->count.load(std::memory_order_relaxed) << "\n";
+        }
+    }
+};
+
+/**
+ * Adds wall time of its lifetime to a section.
+ */
+class ScopedTimer
+{
+    Section& section_;
+    std::chrono::steady_clock::time_point const start_;
+
+  public:
+    explicit ScopedTimer(Section& section)
+        : section_(section)
+        , start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    ScopedTimer(ScopedTimer const&)            = delete;
+    ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+    ~ScopedTimer()
+    {
+        auto const elapsed = std::chrono::steady_clock::now() - start_;
+        section_.calls.fetch_add(1, std::memory_order_relaxed);
+        section_.nanoseconds.fetch_add(
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+            std::memory_order_relaxed);
+    }
+};
+
+}  // namespace csat::profiling
+
+#define CSAT_PROFILE_CONCAT_IMPL_(lhs, rhs) lhs##rhs
+#define CSAT_PROFILE_CONCAT_(lhs, rhs)      CSAT_PROFILE_CONCAT_IMPL_(lhs, rhs)
+
+// Profiling macros are expanded to nothing unless ENABLE_PROFILING is defined, so
+// they may be placed in hot loops. Section of a call site is looked up only once.
+// Counted value is evaluated in either case, so values computed only to be counted
+// are still used in builds without profiling.
+#ifdef ENABLE_PROFILING
+// Measures wall time from this line up to the end of enclosing scope.
+#define CSAT_PROFILE_SCOPE(name)                                                               \
+    static ::csat::profiling::Section& CSAT_PROFILE_CONCAT_(csat_profile_section_, __LINE__) = \
+        ::csat::profiling::Profiler::getInstance().getSection(name);                           \
+    ::csat::profiling::ScopedTimer const CSAT_PROFILE_CONCAT_(csat_profile_timer_, __LINE__)(  \
+        CSAT_PROFILE_CONCAT_(csat_profile_section_, __LINE__))
+// Adds `value` to a counter.
+#define CSAT_PROFILE_COUNT(name, value)                                                                      \
+    do                                                                                                       \
+    {                                                                                                        \
+        static ::csat::profiling::Section& csat_profile_counter_ =                                           \
+            ::csat::profiling::Profiler::getInstance().getSection(name);                                     \
+        csat_profile_counter_.count.fetch_add(static_cast<std::uint64_t>(value), std::memory_order_relaxed); \
+    } while (false)
+#else
+#define CSAT_PROFILE_SCOPE(name)        static_cast<void>(0)
+#define CSAT_PROFILE_COUNT(name, value) static_cast<void>(value)
+#endif
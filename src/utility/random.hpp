@@ -38,18 +38,33 @@ class GlobalSeed
 /**
  * @return Next random value, determined by GlobalSeed.
  */
-static uint64_t getNextRandomSeed()
+inline uint64_t getNextRandomSeed()
 {
-    static std::mt19937 mtGen(GlobalSeed::get());
-    static std::uniform_int_distribution<uint64_t> dist(0, UINT64_MAX);
+    // Each thread has its own generator, so concurrent callers
+    // don't race and still get reproducible sequence of seeds.
+    static thread_local std::mt19937 mtGen(GlobalSeed::get());
+    static thread_local std::uniform_int_distribution<uint64_t> dist(0, UINT64_MAX);
 
     return dist(mtGen);
 }
 
+/**
+ * @return Seed of a circuit, determined by GlobalSeed and index of the circuit among simplified ones,
+ *         so that each circuit gets its own reproducible sequence regardless of the thread simplifying it.
+ */
+inline uint64_t getCircuitSeed(uint64_t circuit_index)
+{
+    // SplitMix64 finalizer spreads neighbouring indices over the whole range.
+    uint64_t seed = GlobalSeed::get() + (circuit_index + 1) * 0x9E3779B97F4A7C15ULL;
+    seed          = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed          = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    return seed ^ (seed >> 31);
+}
+
 /**
  * @return New Mersenne Twister Engine, seeded by predictable number.
  */
-static std::mt19937 getNewMersenneTwisterEngine()
+inline std::mt19937 getNewMersenneTwisterEngine()
 {
     return std::mt19937(getNextRandomSeed());
 }
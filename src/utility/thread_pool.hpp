@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace csat::utils
+{
+
+/**
+ * Pool of worker threads, which runs loops over index ranges in parallel. Range of
+ * a loop is split into chunks, which are spread over per-worker queues. Each worker
+ * takes chunks from the back of its own queue, and once it is empty steals chunks
+ * from the front of queues of other workers, so that uneven chunks are balanced.
+ *
+ * The thread, which runs a loop, executes chunks as well until the whole loop is
+ * done, so loops may be run concurrently by several threads, sharing the same pool.
+ * Loops, which are run from inside of a chunk, are executed sequentially.
+ *
+ * Loop bodies must not throw.
+ */
+class ThreadPool
+{
+  protected:
+    /* Part of a loop, which is executed by a single thread. */
+    struct Task_
+    {
+        /* Type erased loop body, which is called on `[begin, end)`. */
+        void (*run)(void const*, size_t, size_t) = nullptr;
+        void const* body                         = nullptr;
+        size_t begin                             = 0;
+        size_t end                               = 0;
+        /* Number of not yet finished chunks of the loop. */
+        std::atomic<size_t>* pending = nullptr;
+    };
+
+    struct Queue_
+    {
+        std::mutex mutex;
+        std::deque<Task_> tasks;
+    };
+
+    /* Number of chunks per thread, which loop is split into to balance uneven work. */
+    static constexpr size_t CHUNKS_PER_THREAD_ = 4;
+
+    std::vector<std::unique_ptr<Queue_>> queues_{};
+    std::vector<std::thread> workers_{};
+    /* Number of tasks in all queues. */
+    std::atomic<size_t> queued_{0};
+    /* Queue to which the next loop starts to put its chunks. */
+    std::atomic<size_t> next_queue_{0};
+
+    std::mutex sleep_mutex_{};
+    std::condition_variable wake_up_{};
+    bool stopped_ = false;
+
+    /* True inside of threads, which are executing a chunk. */
+    static inline thread_local bool inside_task_ = false;
+
+  public:
+    /**
+     * @param threads_number -- number of threads, which execute loops, including the
+     *        thread running a loop. Pool of a single thread runs all loops sequentially.
+     */
+    explicit ThreadPool(size_t threads_number = std::thread::hardware_concurrency())
+    {
+        threads_number = std::max<size_t>(1, threads_number);
+        for (size_t worker = 0; worker + 1 < threads_number; ++worker)
+        {
+            queues_.push_back(std::make_unique<Queue_>());
+        }
+        for (size_t worker = 0; worker + 1 < threads_number; ++worker)
+        {
+            workers_.emplace_back([this, worker]() { workerLoop_(worker); });
+        }
+    }
+
+    ThreadPool(ThreadPool const&)            = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> const lock(sleep_mutex_);
+            stopped_ = true;
+        }
+        wake_up_.notify_all();
+        for (std::thread& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @return number of threads, which execute loops, including the thread running a loop.
+     */
+    [[nodiscard]]
+    size_t getNumberOfThreads() const noexcept
+    {
+        return workers_.size() + 1;
+    }
+
+    /**
+     * Calls `body(begin, end)` on disjoint subranges, which cover `[0, size)`, in parallel,
+     * and returns once all calls are finished. Range is split into nearly equal subranges,
+     * at most `size / grain` (rounded up) of them and at most `CHUNKS_PER_THREAD_` per thread,
+     * so that per-call overhead is amortized. Hence subranges are roughly `grain` long or
+     * longer, while rounding may make them slightly shorter than `grain`, e.g. a range of 10
+     * with grain 4 is split into subranges of 3, 3 and 4.
+     *
+     * @param size -- size of the range.
+     * @param grain -- approximate minimal size of subrange.
+     * @param body -- callable `(size_t begin, size_t end)`.
+     */
+    template<class Body>
+    void parallelForRanges(size_t size, size_t grain, Body const& body)
+    {
+        grain                      = std::max<size_t>(1, grain);
+        size_t const chunks_number = std::min(
+            (size + grain - 1) / grain, getNumberOfThreads() * CHUNKS_PER_THREAD_);
+        if (chunks_number <= 1 || workers_.empty() || inside_task_)
+        {
+            if (size > 0)
+            {
+                body(size_t{0}, size);
+            }
+            return;
+        }
+
+        std::atomic<size_t> pending{chunks_number};
+        auto const run = [](void const* erased_body, size_t begin, size_t end)
+        { (*static_cast<Body const*>(erased_body))(begin, end); };
+
+        // Counter is increased in advance, so that it never underflows when chunks are taken.
+        queued_.fetch_add(chunks_number, std::memory_order_release);
+        size_t const first_queue = next_queue_.fetch_add(1, std::memory_order_relaxed);
+        for (size_t chunk = 0; chunk < chunks_number; ++chunk)
+        {
+            Queue_& queue = *queues_[(first_queue + chunk) % queues_.size()];
+            std::lock_guard<std::mutex> const lock(queue.mutex);
+            queue.tasks.push_back(
+                {run, &body, size * chunk / chunks_number, size * (chunk + 1) / chunks_number, &pending});
+        }
+        {
+            // Lock guarantees, that sleeping workers don't miss the notification.
+            std::lock_guard<std::mutex> const lock(sleep_mutex_);
+        }
+        wake_up_.notify_all();
+
+        // Caller helps to execute chunks until all chunks of its loop are finished.
+        while (pending.load(std::memory_order_acquire) != 0)
+        {
+            if (!runTask_(first_queue))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * Calls `body(index)` for each index of `[0, size)` in parallel.
+     *
+     * @param size -- size of the range.
+     * @param body -- callable `(size_t index)`.
+     * @param grain -- approximate minimal number of indices, processed by a single chunk,
+     *                see `parallelForRanges`.
+     */
+    template<class Body>
+    void parallelFor(size_t size, Body const& body, size_t grain = 1024)
+    {
+        parallelForRanges(
+            size,
+            grain,
+            [&body](size_t begin, size_t end)
+            {
+                for (size_t index = begin; index < end; ++index)
+                {
+                    body(index);
+                }
+            });
+    }
+
+  protected:
+    /**
+     * Takes a task from the back of queue `home`, or steals it from the front of another queue.
+     * @return task, whose body is nullptr if all queues are empty.
+     */
+    Task_ takeTask_(size_t home)
+    {
+        if (queued_.load(std::memory_order_acquire) == 0)
+        {
+            return {};
+        }
+        for (size_t offset = 0; offset < queues_.size(); ++offset)
+        {
+            Queue_& queue = *queues_[(home + offset) % queues_.size()];
+            std::lock_guard<std::mutex> const lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                continue;
+            }
+            Task_ task{};
+            if (offset == 0)
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+        return {};
+    }
+
+    /**
+     * Executes a single task, if there is any.
+     * @return true iff a task was executed.
+     */
+    bool runTask_(size_t home)
+    {
+        Task_ const task = takeTask_(home);
+        if (task.body == nullptr)
+        {
+            return false;
+        }
+        inside_task_ = true;
+        task.run(task.body, task.begin, task.end);
+        inside_task_ = false;
+        task.pending->fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void workerLoop_(size_t worker)
+    {
+        while (true)
+        {
+            if (runTask_(worker))
+            {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_up_.wait(lock, [this]() { return stopped_ || queued_.load(std::memory_order_acquire) != 0; });
+            if (stopped_)
+            {
+                return;
+            }
+        }
+    }
+};
+
+}  // namespace csat::utils
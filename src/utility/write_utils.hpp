@@ -3,6 +3,7 @@
 #include <iostream>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "src/common/csat_types.hpp"
@@ -32,14 +33,14 @@ void writeBenchFile(
     logger.debug("recording INPUTs.");
     for (GateId input : circuit.getInputGates())
     {
-        file_out << "INPUT(" << encoder.decodeGate(input) << ")\n";
+        file_out << "INPUT(" << encoder.decodeGateView(input) << ")\n";
     }
     file_out << "\n";
 
     logger.debug("recording OUTPUTs.");
     for (GateId output : circuit.getOutputGates())
     {
-        file_out << "OUTPUT(" << encoder.decodeGate(output) << ")\n";
+        file_out << "OUTPUT(" << encoder.decodeGateView(output) << ")\n";
     }
     file_out << "\n";
 
@@ -48,7 +49,7 @@ void writeBenchFile(
     {
         if (circuit.getGateType(gateId) != GateType::INPUT)
         {
-            file_out << encoder.decodeGate(gateId) << " = "
+            file_out << encoder.decodeGateView(gateId) << " = "
                      << csat::utils::gateTypeToString(circuit.getGateType(gateId)) << "(";
 
             auto operands       = circuit.getGateOperands(gateId);
@@ -62,9 +63,9 @@ void writeBenchFile(
 
             for (size_t operand = 0; operand < (num_operands - 1); ++operand)
             {
-                file_out << encoder.decodeGate(operands.at(operand)) << ", ";
+                file_out << encoder.decodeGateView(operands.at(operand)) << ", ";
             }
-            file_out << encoder.decodeGate(operands.at(num_operands - 1)) << ")\n";
+            file_out << encoder.decodeGateView(operands.at(num_operands - 1)) << ")\n";
         }
     }
     logger.debug("writeBenchFile end.");
@@ -74,23 +75,23 @@ void writeBenchFile(
  * Prints circuit to stdout where each gate is written in the following notation
  * "<encoded name> => <name from original file>"
  */
-void printCircuit(csat::DAG const& circuit, csat::utils::GateEncoder<std::string> const& encoder)
+void printCircuit(csat::ICircuit const& circuit, csat::utils::GateEncoder<std::string> const& encoder)
 {
     for (auto input : circuit.getInputGates())
     {
-        std::cout << "INPUT(" << input << " => " << encoder.decodeGate(input) << ")\n";
+        std::cout << "INPUT(" << input << " => " << encoder.decodeGateView(input) << ")\n";
     }
 
     for (auto output : circuit.getOutputGates())
     {
-        std::cout << "OUTPUT(" << output << " => " << encoder.decodeGate(output) << ")\n";
+        std::cout << "OUTPUT(" << output << " => " << encoder.decodeGateView(output) << ")\n";
     }
 
     for (size_t gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
     {
         if (circuit.getGateType(gateId) != csat::GateType::INPUT)
         {
-            std::cout << gateId << " => " << encoder.decodeGate(gateId) << " = "
+            std::cout << gateId << " => " << encoder.decodeGateView(gateId) << " = "
                       << csat::utils::gateTypeToString(circuit.getGateType(gateId)) << "(";
 
             auto operands       = circuit.getGateOperands(gateId);
@@ -104,10 +105,10 @@ void printCircuit(csat::DAG const& circuit, csat::utils::GateEncoder<std::string
 
             for (size_t operand = 0; operand < (num_operands - 1); ++operand)
             {
-                std::cout << operands.at(operand) << " => " << encoder.decodeGate(operands.at(operand)) << ", ";
+                std::cout << operands.at(operand) << " => " << encoder.decodeGateView(operands.at(operand)) << ", ";
             }
-            std::cout << operands.at(num_operands - 1) << " => " << encoder.decodeGate(operands.at(num_operands - 1))
-                      << ")\n";
+            std::cout << operands.at(num_operands - 1) << " => "
+                      << encoder.decodeGateView(operands.at(num_operands - 1)) << ")\n";
         }
 
         std::cout << std::flush;
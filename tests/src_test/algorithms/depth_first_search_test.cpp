@@ -167,6 +167,56 @@ TEST_F(DepthFirstSearchTestFixture, TestBaseHooks)
     ASSERT_EQ(unvisited_list, std::vector<GateId>({2, 3, 5, 6}));
 }
 
+
+TEST_F(DepthFirstSearchTestFixture, UsersDirection)
+{
+    std::vector<GateId> postorder{};
+    auto const dfs_state = algo::performDepthFirstSearch<false>(
+        simple_graph_01,
+        {1, 3},
+        algo::NoOperation{},
+        [&postorder](GateId gateId, algo::DFSStateVector const&)
+        {
+            postorder.push_back(gateId);
+        });
+
+    ASSERT_EQ(postorder, std::vector<GateId>({7, 4, 5, 1, 6, 3}));
+    ASSERT_EQ(dfs_state.at(0), algo::DFSState::UNVISITED);
+    ASSERT_EQ(dfs_state.at(2), algo::DFSState::UNVISITED);
+}
+
+TEST_F(DepthFirstSearchTestFixture, BreadthFirstSearch)
+{
+    std::vector<GateId> visited{};
+    std::vector<size_t> distances{};
+    auto const mask = algo::performBreadthFirstSearch(
+        simple_graph_01,
+        {7, 6},
+        [&visited, &distances](GateId gateId, size_t distance)
+        {
+            visited.push_back(gateId);
+            distances.push_back(distance);
+        });
+
+    ASSERT_EQ(visited, std::vector<GateId>({7, 6, 4, 2, 3, 0, 1}));
+    ASSERT_EQ(distances, std::vector<size_t>({0, 0, 1, 1, 1, 2, 2}));
+    ASSERT_EQ(mask, BoolVector({1, 1, 1, 1, 1, 0, 1, 1}));
+
+    // Each gate of a cycle is visited once.
+    visited.clear();
+    distances.clear();
+    algo::performBreadthFirstSearch(
+        simple_graph_02,
+        {0},
+        [&visited, &distances](GateId gateId, size_t distance)
+        {
+            visited.push_back(gateId);
+            distances.push_back(distance);
+        });
+    ASSERT_EQ(visited, std::vector<GateId>({0, 3, 2, 1, 4}));
+    ASSERT_EQ(distances, std::vector<size_t>({0, 1, 2, 3, 4}));
+}
+
 } // namespace
 
 
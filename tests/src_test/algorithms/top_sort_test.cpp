@@ -1,6 +1,9 @@
 #include "src/structures/circuit/dag.hpp"
 #include "src/algo.hpp"
 
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 
@@ -131,4 +134,130 @@ TEST(TopSortTest, GatesWithoutUsers)
     );
 }
 
+TEST(TopSortTest, SortingIsCachedUntilModification)
+{
+    auto dag = csat::DAG(
+        {
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::AND, {0, 1}},
+            {csat::GateType::NOT, {2}}
+        },
+        {3}
+    );
+    ASSERT_EQ(dag.getCachedTopologicalOrder(), nullptr);
+
+    csat::GateIdContainer gateSorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(dag));
+    ASSERT_NE(dag.getCachedTopologicalOrder(), nullptr);
+    ASSERT_EQ(*dag.getCachedTopologicalOrder(), gateSorting);
+    ASSERT_EQ(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(dag), gateSorting);
+
+    // Edits, which keep operands of gates, keep cached order.
+    dag.setGate(2, csat::GateType::OR, {0, 1});
+    dag.setGate(3, csat::GateType::NOT, {2});
+    dag.markDead(3);
+    ASSERT_NE(dag.getCachedTopologicalOrder(), nullptr);
+    ASSERT_EQ(*dag.getCachedTopologicalOrder(), gateSorting);
+
+    // Removal of an operand may change order of search, so order must be recomputed.
+    dag.setGate(2, csat::GateType::NOT, {0});
+    ASSERT_EQ(dag.getCachedTopologicalOrder(), nullptr);
+    algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(dag);
+
+    // Gate 3 becomes an operand of gate 2, so order must be recomputed.
+    dag.setGate(3, csat::GateType::NOT, {0});
+    dag.setGate(2, csat::GateType::AND, {3, 1});
+    ASSERT_EQ(dag.getCachedTopologicalOrder(), nullptr);
+    gateSorting = algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(dag);
+    ASSERT_EQ(gateSorting, csat::GateIdContainer({2, 3, 0, 1}));
+}
+
+TEST(TopSortTest, SortingIsCachedConcurrently)
+{
+    auto dag = csat::DAG(
+        {
+            {csat::GateType::NOT, {3}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::AND, {1, 0}},
+            {csat::GateType::INPUT, {}}
+        },
+        {2}
+    );
+
+    std::vector<csat::GateIdContainer> sortings(4);
+    std::vector<std::thread> threads;
+    for (auto& sorting : sortings)
+    {
+        threads.emplace_back([&dag, &sorting]() { sorting = algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(dag); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Sorting is deterministic, so each thread gets the same order, which is cached once.
+    ASSERT_NE(dag.getCachedTopologicalOrder(), nullptr);
+    for (auto const& sorting : sortings)
+    {
+        ASSERT_EQ(sorting, *dag.getCachedTopologicalOrder());
+    }
+}
+
+TEST(TopSortTest, NumberedTopologicallyAfterCompaction)
+{
+    auto dag = csat::DAG(
+        {
+            {csat::GateType::AND, {1, 3}},
+            {csat::GateType::NOT, {3}},
+            {csat::GateType::NOT, {1}},
+            {csat::GateType::INPUT, {}}
+        },
+        {0}
+    );
+    ASSERT_FALSE(dag.isNumberedTopologically());
+
+    dag.markDead(2);
+    csat::GateIdContainer const old_to_new = dag.compact({3, 1, 0});
+    ASSERT_TRUE(dag.isNumberedTopologically());
+    ASSERT_EQ(old_to_new, csat::GateIdContainer({2, 1, SIZE_MAX, 0}));
+    ASSERT_EQ(algo::TopSortAlgorithm<algo::DFSTopSort>::evaluationSorting(dag), csat::GateIdContainer({2, 1, 0}));
+
+    // New gates always have the largest ids.
+    dag.addGate(csat::GateType::NOT, {0});
+    ASSERT_TRUE(dag.isNumberedTopologically());
+    ASSERT_EQ(algo::TopSortAlgorithm<algo::DFSTopSort>::evaluationSorting(dag), csat::GateIdContainer({3, 2, 1, 0}));
+
+    // Compaction preserving relative order keeps the numbering.
+    dag.setGate(2, csat::GateType::AND, {0, 3});
+    dag.markDead(1);
+    ASSERT_FALSE(dag.isNumberedTopologically());
+    dag.compact({0, 3, 2});
+    ASSERT_TRUE(dag.isNumberedTopologically());
+    dag.setGate(1, csat::GateType::AND, {0, 0});
+    dag.compact();
+    ASSERT_TRUE(dag.isNumberedTopologically());
+    GateId const input = dag.addGate(csat::GateType::INPUT, {});
+    dag.setGate(1, csat::GateType::NOT, {input});
+    ASSERT_FALSE(dag.isNumberedTopologically());
+}
+
+TEST(TopSortTest, SortingOfNumberedCircuitIsDepthFirst)
+{
+    auto dag = csat::DAG(
+        {
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::NOT, {0}},
+            {csat::GateType::NOT, {1}}
+        },
+        {2, 3}
+    );
+    dag.compact();
+    ASSERT_TRUE(dag.isNumberedTopologically());
+
+    // Passes depend on the order of gates, so numbering doesn't change it.
+    ASSERT_EQ(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(dag), csat::GateIdContainer({3, 1, 2, 0}));
+    ASSERT_EQ(algo::TopSortAlgorithm<algo::DFSTopSort>::evaluationSorting(dag), csat::GateIdContainer({3, 2, 1, 0}));
+}
+
 } // namespace
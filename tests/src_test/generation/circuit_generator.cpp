@@ -0,0 +1,164 @@
+#include "src/generation/circuit_generator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <vector>
+
+#include "src/common/csat_types.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+#include "src/structures/assignment/vector_assignment.hpp"
+#include "src/structures/circuit/dag.hpp"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::generation;
+
+/**
+ * @return value of outputs, read as a number from the least significant bit, on inputs
+ * assigned by bits of `inputs`.
+ */
+uint64_t evaluateNumber(DAG const& circuit, uint64_t inputs)
+{
+    VectorAssignment<> assignment{};
+    for (size_t input = 0; input < circuit.getInputGates().size(); ++input)
+    {
+        bool const value = ((inputs >> input) & 1U) != 0U;
+        assignment.assign(circuit.getInputGates()[input], value ? GateState::TRUE : GateState::FALSE);
+    }
+    auto const evaluation = circuit.evaluateCircuit(assignment);
+
+    uint64_t result = 0;
+    for (size_t output = 0; output < circuit.getOutputGates().size(); ++output)
+    {
+        GateId const gateId = circuit.getOutputGates()[output];
+        GateState const state =
+            assignment.isUndefined(gateId) ? evaluation->getGateState(gateId) : assignment.getGateState(gateId);
+        result |= static_cast<uint64_t>(state == GateState::TRUE) << output;
+    }
+    return result;
+}
+
+void checkArithmetic(Family family, Basis basis, std::function<uint64_t(uint64_t, uint64_t)> const& expected)
+{
+    size_t const bits        = 3;
+    DAG const circuit        = generateDAG({.family = family, .basis = basis, .size = bits});
+    uint64_t const max_value = 1U << bits;
+    ASSERT_EQ(circuit.getInputGates().size(), 2 * bits);
+    for (uint64_t lhs = 0; lhs < max_value; ++lhs)
+    {
+        for (uint64_t rhs = 0; rhs < max_value; ++rhs)
+        {
+            ASSERT_EQ(evaluateNumber(circuit, lhs | (rhs << bits)), expected(lhs, rhs));
+        }
+    }
+    for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        GateType const type = circuit.getGateType(gateId);
+        if (basis == Basis::AIG)
+        {
+            ASSERT_TRUE(type == GateType::INPUT || type == GateType::AND || type == GateType::NOT);
+        }
+    }
+}
+
+TEST(CircuitGeneratorTest, Arithmetic)
+{
+    for (Basis const basis : {Basis::AIG, Basis::BENCH})
+    {
+        checkArithmetic(Family::ADDER, basis, std::plus<>());
+        checkArithmetic(Family::MULTIPLIER, basis, std::multiplies<>());
+        // Miter of equivalent multipliers is never satisfied.
+        checkArithmetic(Family::MULTIPLIER_MITER, basis, [](uint64_t, uint64_t) { return 0; });
+    }
+}
+
+TEST(CircuitGeneratorTest, ArithmeticOfZeroBitsIsRejected)
+{
+    ASSERT_DEATH(generateDAG({.family = Family::ADDER, .size = 0}), "at least one bit");
+    ASSERT_DEATH(generateDAG({.family = Family::MULTIPLIER, .size = 0}), "at least one bit");
+    ASSERT_DEATH(generateDAG({.family = Family::MULTIPLIER_MITER, .size = 0}), "at least one bit");
+}
+
+TEST(CircuitGeneratorTest, Parity)
+{
+    DAG const full = generateDAG({.family = Family::PARITY, .size = 5, .outputs = 1});
+    for (uint64_t inputs = 0; inputs < 32; ++inputs)
+    {
+        ASSERT_EQ(evaluateNumber(full, inputs), static_cast<uint64_t>(__builtin_popcountll(inputs) % 2));
+    }
+
+    // Trees of two distinct inputs.
+    DAG const pairs = generateDAG({.family = Family::PARITY, .size = 5, .outputs = 3, .width = 2});
+    ASSERT_EQ(pairs.getOutputGates().size(), 3);
+    for (GateId const output : pairs.getOutputGates())
+    {
+        ASSERT_EQ(pairs.getGateType(output), GateType::XOR);
+        GateIdSpan const operands = pairs.getGateOperands(output);
+        ASSERT_NE(operands[0], operands[1]);
+        ASSERT_EQ(pairs.getGateType(operands[0]), GateType::INPUT);
+        ASSERT_EQ(pairs.getGateType(operands[1]), GateType::INPUT);
+    }
+}
+
+TEST(CircuitGeneratorTest, RandomCircuitShape)
+{
+    GeneratorParameters const parameters{
+        .family = Family::RANDOM, .size = 1'000, .inputs = 10, .outputs = 5, .depth = 20, .max_fanout = 4};
+    DAG const circuit = generateDAG(parameters);
+    ASSERT_GE(circuit.getNumberOfGates(), 1'010);
+    ASSERT_EQ(circuit.getInputGates().size(), 10);
+    ASSERT_EQ(circuit.getOutputGates().size(), 5);
+
+    // Each operation is a gate, which may be negated by an additional one.
+    std::vector<size_t> depth(circuit.getNumberOfGates(), 0);
+    for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        for (GateId const operand : circuit.getGateOperands(gateId))
+        {
+            depth[gateId] = std::max(depth[gateId], depth[operand] + 1);
+        }
+    }
+    size_t const circuit_depth = *std::max_element(depth.begin(), depth.end());
+    ASSERT_GE(circuit_depth, 20);
+    ASSERT_LE(circuit_depth, 40);
+
+    // Generation is determined by the seed.
+    DAG const same_circuit = generateDAG(parameters);
+    ASSERT_EQ(same_circuit.getNumberOfGates(), circuit.getNumberOfGates());
+    for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(same_circuit.getGateType(gateId), circuit.getGateType(gateId));
+        ASSERT_TRUE(std::ranges::equal(same_circuit.getGateOperands(gateId), circuit.getGateOperands(gateId)));
+    }
+}
+
+TEST(CircuitGeneratorTest, BenchSinkMatchesDAGSink)
+{
+    GeneratorParameters const parameters{.family = Family::MULTIPLIER_MITER, .basis = Basis::AIG, .size = 4};
+    DAG const circuit = generateDAG(parameters);
+
+    std::stringstream stream{};
+    BenchSink sink(stream);
+    generateCircuit(sink, parameters);
+    sink.finish();
+    ASSERT_EQ(sink.getNumberOfGates(), circuit.getNumberOfGates());
+
+    csat::parser::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+    auto const parsed = parser.instantiate();
+    ASSERT_EQ(parsed->getNumberOfGates(), circuit.getNumberOfGates());
+    ASSERT_TRUE(std::ranges::equal(parsed->getOutputGates(), circuit.getOutputGates()));
+    for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(parsed->getGateType(gateId), circuit.getGateType(gateId));
+        ASSERT_TRUE(std::ranges::equal(parsed->getGateOperands(gateId), circuit.getGateOperands(gateId)));
+    }
+}
+
+}  // namespace
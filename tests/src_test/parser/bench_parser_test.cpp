@@ -2,6 +2,8 @@
 #include "src/parser/bench_to_circuit.hpp"
 #include "src/structures/circuit/dag.hpp"
 
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -181,4 +183,79 @@ TEST(BenchParser, VDD)
     ASSERT_TRUE(circuit->getGateType(3) == csat::GateType::MUX);
 }
 
+TEST(BenchParser, MappedFile)
+{
+    // The last line has no trailing newline on purpose.
+    std::string const test_case = "# Comment Line\n"
+                                  "INPUT(X)\n"
+                                  "INPUT(Y)\n"
+                                  "\n"
+                                  "OUTPUT(Z)\n"
+                                  "W = NOT(X)\n"
+                                  "Z = AND(W, Y, X)";
+
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "csat_bench_parser_test.bench";
+    {
+        std::ofstream file(path);
+        file << test_case;
+    }
+
+    csat::parser::BenchToCircuit<csat::DAG> file_parser;
+    ASSERT_EQ(file_parser.parseFile(path.string()), test_case.size());
+    std::filesystem::remove(path);
+    auto file_circuit = file_parser.instantiate();
+
+    std::istringstream stream(test_case);
+    csat::parser::BenchToCircuit<csat::DAG> stream_parser;
+    stream_parser.parseStream(stream);
+    auto stream_circuit = stream_parser.instantiate();
+
+    ASSERT_EQ(file_circuit->getNumberOfGates(), 4);
+    ASSERT_EQ(file_circuit->getNumberOfGates(), stream_circuit->getNumberOfGates());
+    ASSERT_EQ(file_circuit->getOutputGates(), stream_circuit->getOutputGates());
+    for (csat::GateId gateId = 0; gateId < file_circuit->getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(file_circuit->getGateType(gateId), stream_circuit->getGateType(gateId));
+        ASSERT_EQ(file_circuit->getGateOperands(gateId), stream_circuit->getGateOperands(gateId));
+        ASSERT_EQ(file_parser.encoder.decodeGate(gateId), stream_parser.encoder.decodeGate(gateId));
+    }
+}
+
+TEST(BenchParser, ParallelMatchesSequential)
+{
+    std::string const test_case = "# Comment Line\n"
+                                  "INPUT(X)\n"
+                                  "INPUT(Y)\n"
+                                  "OUTPUT(Z)\n"
+                                  "OUTPUT(V)\n"
+                                  "W = NOT(X)\n"
+                                  "\n"
+                                  "C0 = CONST(0)\n"
+                                  " V = vdd\n"
+                                  "Z = AND(W, U, C0)\n"
+                                  "U = OR(  Y , X )\n"
+                                  "T = MUX(U, W, V)\n";
+
+    std::istringstream stream(test_case);
+    csat::parser::BenchToCircuit<csat::DAG> sequential_parser;
+    sequential_parser.parseStream(stream);
+    auto sequential_circuit = sequential_parser.instantiate();
+
+    for (size_t threads_number : {2, 3, 5, 64})
+    {
+        csat::parser::BenchToCircuit<csat::DAG> parallel_parser;
+        parallel_parser.parseBufferParallel(test_case, threads_number);
+        auto parallel_circuit = parallel_parser.instantiate();
+
+        ASSERT_EQ(parallel_circuit->getNumberOfGates(), sequential_circuit->getNumberOfGates());
+        ASSERT_EQ(parallel_circuit->getOutputGates(), sequential_circuit->getOutputGates());
+        for (csat::GateId gateId = 0; gateId < sequential_circuit->getNumberOfGates(); ++gateId)
+        {
+            ASSERT_EQ(parallel_circuit->getGateType(gateId), sequential_circuit->getGateType(gateId));
+            ASSERT_EQ(parallel_circuit->getGateOperands(gateId), sequential_circuit->getGateOperands(gateId));
+            ASSERT_EQ(parallel_parser.encoder.decodeGate(gateId), sequential_parser.encoder.decodeGate(gateId));
+        }
+    }
+}
+
 } // namespace
@@ -1,9 +1,11 @@
 #include "src/common/csat_types.hpp"
+#include "src/generation/circuit_generator.hpp"
 #include "src/structures/circuit/dag.hpp"
 #include "src/parser/bench_to_circuit.hpp"
 
 #include "src/simplification/composition.hpp"
 #include "src/simplification/strategy.hpp"
+#include "src/utility/thread_pool.hpp"
 
 #include <string>
 
@@ -213,4 +215,33 @@ TEST(DuplicateGatesCleaner, SeveralLevelsMUX)
     ASSERT_EQ(circuit->getGateOperands(10), GateIdContainer({6, 9}));
 }
 
+
+TEST(DuplicateGatesCleaner, ParallelHashingMatchesSequential)
+{
+    // Few inputs make many gates duplicate.
+    auto const circuit = std::make_unique<DAG>(generation::generateDAG(
+        {.family = generation::Family::RANDOM, .size = 20'000, .inputs = 6, .outputs = 20, .depth = 30}));
+    auto const encoder = generation::makeGateEncoder(circuit->getNumberOfGates());
+
+    SimplificationContext sequential_context{};
+    auto [sequential, sequential_encoder] =
+        Composition<DAG, DuplicateGatesCleaner_<DAG>>().apply(*circuit, encoder, sequential_context);
+
+    utils::ThreadPool pool(4);
+    SimplificationContext parallel_context{};
+    parallel_context.thread_pool = &pool;
+    auto [parallel, parallel_encoder] =
+        Composition<DAG, DuplicateGatesCleaner_<DAG>>().apply(*circuit, encoder, parallel_context);
+
+    ASSERT_LT(sequential->getNumberOfGates(), circuit->getNumberOfGates());
+    ASSERT_EQ(parallel->getNumberOfGates(), sequential->getNumberOfGates());
+    ASSERT_EQ(parallel->getOutputGates(), sequential->getOutputGates());
+    for (GateId gateId = 0; gateId < sequential->getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(parallel->getGateType(gateId), sequential->getGateType(gateId));
+        ASSERT_EQ(parallel->getGateOperands(gateId), sequential->getGateOperands(gateId));
+        ASSERT_EQ(parallel_encoder->decodeGate(gateId), sequential_encoder->decodeGate(gateId));
+    }
+}
+
 } // namespace
@@ -0,0 +1,85 @@
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+
+#include "src/simplification/composition.hpp"
+#include "src/simplification/strategy.hpp"
+#include "tests/src_test/simplification/utils/assert_equivalent.hpp"
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simplification;
+
+TEST(EquivalenceSweeper, EquivalentAndComplementaryGates)
+{
+    std::string const dag = "INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "OUTPUT(4)\n"
+                            "OUTPUT(5)\n"
+                            "OUTPUT(6)\n"
+                            "2 = NOT(0)\n"
+                            "3 = NOT(1)\n"
+                            "4 = AND(0, 1)\n"
+                            "5 = NOR(2, 3)\n"
+                            "6 = OR(2, 3)\n";
+
+    std::istringstream stream(dag);
+    csat::parser::BenchToCircuit<csat::DAG> parser;
+    parser.parseStream(stream);
+
+    std::unique_ptr<csat::DAG> csat_instance      = parser.instantiate();
+    csat::utils::GateEncoder<std::string> encoder = parser.getEncoder();
+
+    SimplificationContext context{};
+    auto [circuit, new_encoder] = Composition<DAG, EquivalenceSweeping<DAG>>().apply(*csat_instance, encoder, context);
+
+    // All outputs are expressed by a single AND gate and its negation.
+    ASSERT_EQ(context.sweep_stats.getMerges(), 2);
+    ASSERT_EQ(context.sweep_stats.unproven, 0);
+    ASSERT_EQ(circuit->getNumberOfGates(), 4);
+    ASSERT_EQ(circuit->getOutputGates()[0], circuit->getOutputGates()[1]);
+    test::assertEquivalent(*csat_instance, encoder, *circuit, *new_encoder);
+}
+
+TEST(EquivalenceSweeper, XorDecomposition)
+{
+    std::string const dag = "INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "INPUT(2)\n"
+                            "OUTPUT(8)\n"
+                            "OUTPUT(9)\n"
+                            "OUTPUT(10)\n"
+                            "3 = NOT(0)\n"
+                            "4 = NOT(1)\n"
+                            "5 = AND(0, 4)\n"
+                            "6 = AND(3, 1)\n"
+                            "7 = OR(5, 6)\n"
+                            "8 = AND(7, 2)\n"
+                            "9 = XOR(0, 1)\n"
+                            "10 = AND(0, 1, 2)\n";
+
+    std::istringstream stream(dag);
+    csat::parser::BenchToCircuit<csat::DAG> parser;
+    parser.parseStream(stream);
+
+    std::unique_ptr<csat::DAG> csat_instance      = parser.instantiate();
+    csat::utils::GateEncoder<std::string> encoder = parser.getEncoder();
+
+    SimplificationContext context{};
+    auto [circuit, new_encoder] = Composition<DAG, EquivalenceSweeping<DAG>>().apply(*csat_instance, encoder, context);
+
+    // Decomposed XOR is merged with the XOR gate, while non-equivalent AND is kept.
+    ASSERT_EQ(context.sweep_stats.getMerges(), 1);
+    ASSERT_LT(circuit->getNumberOfGates(), csat_instance->getNumberOfGates());
+    ASSERT_NE(circuit->getOutputGates()[1], circuit->getOutputGates()[2]);
+    test::assertEquivalent(*csat_instance, encoder, *circuit, *new_encoder);
+}
+
+}  // namespace
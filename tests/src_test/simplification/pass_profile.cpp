@@ -0,0 +1,139 @@
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+
+#include "src/simplification/composition.hpp"
+#include "src/simplification/nest.hpp"
+#include "src/simplification/pass_profile.hpp"
+#include "src/simplification/strategy.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simplification;
+
+std::string const CIRCUIT = "INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "OUTPUT(6)\n"
+                            "2 = AND(0, 1)\n"
+                            "3 = AND(1, 0)\n"
+                            "4 = OR(2, 3, 2)\n"
+                            "5 = NOT(4)\n"
+                            "6 = NOT(5)\n";
+
+TEST(PassProfile, CompositionAndNestRecordPasses)
+{
+    std::istringstream stream(CIRCUIT);
+    csat::parser::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+    auto circuit = parser.instantiate();
+
+    SimplificationContext context{};
+    using NestT = Nest<DAG, 2, RedundantGatesCleaner_<DAG>, DuplicateGatesCleaner_<DAG>>;
+    Composition<DAG, NestT, ReduceNotComposition_<DAG>>().apply(*circuit, parser.getEncoder(), context);
+
+    std::vector<PassRecord> const& passes = context.profile.getPasses();
+    std::vector<std::string> names{};
+    std::vector<std::size_t> depths{};
+    for (PassRecord const& pass : passes)
+    {
+        names.push_back(pass.name);
+        depths.push_back(pass.depth);
+        ASSERT_GE(pass.duration, 0);
+        ASSERT_GE(pass.peak_rss_delta_kb, 0);
+    }
+    ASSERT_EQ(
+        names,
+        std::vector<std::string>(
+            {"Nest",
+             "Nest iteration 0",
+             "RedundantGatesCleaner_",
+             "DuplicateGatesCleaner_",
+             "Nest iteration 1",
+             "RedundantGatesCleaner_",
+             "DuplicateGatesCleaner_",
+             "ReduceNotComposition_"}));
+    ASSERT_EQ(depths, std::vector<std::size_t>({0, 1, 2, 2, 1, 2, 2, 0}));
+
+    // Duplicate gate 3 is merged into gate 2 by the first iteration only.
+    ASSERT_EQ(passes[3].gates_before, 7);
+    ASSERT_EQ(passes[3].gates_after, 6);
+    ASSERT_EQ(passes[7].gates_before, 6);
+    ASSERT_EQ(passes[0].gates_before, 7);
+    ASSERT_EQ(passes[0].gates_after, 6);
+    // Nested passes are placed within enclosing ones.
+    ASSERT_GE(passes[2].start, passes[1].start);
+    ASSERT_LE(passes[2].start + passes[2].duration, passes[1].start + passes[1].duration + 1e-9);
+}
+
+TEST(PassProfile, Exports)
+{
+    PassRecord pass{};
+    pass.name         = "DuplicateGatesCleaner_";
+    pass.start        = 0.5;
+    pass.duration     = 0.25;
+    pass.gates_before = 7;
+    pass.gates_after  = 6;
+    std::vector<CircuitProfile> const profiles{{"dir/\"quoted\".bench", {pass}}, {"empty.bench", {}}};
+
+    std::ostringstream json;
+    writePassProfileJson(json, profiles);
+    ASSERT_EQ(
+        json.str(),
+        "[\n"
+        "  {\"circuit\": \"dir/\\\"quoted\\\".bench\", \"passes\": [\n"
+        "    {\"name\": \"DuplicateGatesCleaner_\", \"depth\": 0, \"start\": 0.5, \"duration\": 0.25, "
+        "\"peak_rss_delta_kb\": 0, \"gates_before\": 7, \"gates_after\": 6}\n"
+        "  ]},\n"
+        "  {\"circuit\": \"empty.bench\", \"passes\": []}\n"
+        "]\n");
+
+    std::ostringstream csv;
+    writePassProfileCsv(csv, profiles);
+    ASSERT_EQ(
+        csv.str(),
+        "Circuit,Pass,Depth,Start,Duration,Peak RSS delta KB,Gates before,Gates after\n"
+        "\"dir/\"\"quoted\"\".bench\",\"DuplicateGatesCleaner_\",0,0.5,0.25,0,7,6\n");
+
+    // Commas and line breaks are kept inside of quoted fields.
+    std::ostringstream separators_csv;
+    writePassProfileCsv(separators_csv, std::vector<CircuitProfile>{{"a,b\nc.bench", {pass}}}, false);
+    ASSERT_EQ(
+        separators_csv.str(),
+        "Circuit,Pass,Depth,Start,Duration,Gates before,Gates after\n"
+        "\"a,b\nc.bench\",\"DuplicateGatesCleaner_\",0,0.5,0.25,7,6\n");
+
+    std::ostringstream trace;
+    writeChromeTrace(trace, profiles);
+    ASSERT_NE(
+        trace.str().find("{\"name\": \"DuplicateGatesCleaner_\", \"cat\": \"pass\", \"ph\": \"X\", \"pid\": 1, "
+                         "\"tid\": 0, \"ts\": 500000.000, \"dur\": 250000.000"),
+        std::string::npos);
+    ASSERT_NE(trace.str().find("\"tid\": 1, \"args\": {\"name\": \"empty.bench\"}"), std::string::npos);
+
+    // Peak RSS is omitted, if circuits were simplified concurrently.
+    std::ostringstream concurrent_csv;
+    writePassProfileCsv(concurrent_csv, profiles, false);
+    ASSERT_EQ(
+        concurrent_csv.str(),
+        "Circuit,Pass,Depth,Start,Duration,Gates before,Gates after\n"
+        "\"dir/\"\"quoted\"\".bench\",\"DuplicateGatesCleaner_\",0,0.5,0.25,7,6\n");
+
+    std::ostringstream concurrent_json;
+    writePassProfileJson(concurrent_json, profiles, false);
+    ASSERT_EQ(concurrent_json.str().find("peak_rss_delta_kb"), std::string::npos);
+
+    std::ostringstream concurrent_trace;
+    writeChromeTrace(concurrent_trace, profiles, false);
+    ASSERT_EQ(concurrent_trace.str().find("peak_rss_delta_kb"), std::string::npos);
+}
+
+}  // namespace
@@ -0,0 +1,147 @@
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+
+#include "src/simplification/composition.hpp"
+#include "src/simplification/nest.hpp"
+#include "src/simplification/script.hpp"
+#include "src/simplification/strategy.hpp"
+#include "src/simplification/transformer_registry.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simplification;
+
+/**
+ * Transformer, which leaves circuit as is and counts its applications.
+ */
+class Counter : public ITransformer<DAG>
+{
+    std::size_t& applications_;
+
+  public:
+    explicit Counter(std::size_t& applications)
+        : applications_(applications)
+    {
+    }
+
+    CircuitAndEncoder<DAG, std::string> transform(
+        std::unique_ptr<DAG> circuit,
+        std::unique_ptr<GateEncoder<std::string>> encoder,
+        SimplificationContext&) override
+    {
+        ++applications_;
+        return {std::move(circuit), std::move(encoder)};
+    }
+};
+
+std::pair<std::unique_ptr<DAG>, csat::utils::GateEncoder<std::string>> parse(std::string const& dag)
+{
+    std::istringstream stream(dag);
+    csat::parser::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+    return {parser.instantiate(), parser.getEncoder()};
+}
+
+std::string const CIRCUIT = "INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "OUTPUT(6)\n"
+                            "2 = AND(0, 1)\n"
+                            "3 = AND(1, 0)\n"
+                            "4 = OR(2, 3, 2)\n"
+                            "5 = NOT(4)\n"
+                            "6 = NOT(5)\n";
+
+/**
+ * Applies script, built from the registry with a counting transformer, and returns number of its applications.
+ */
+std::size_t countApplications(std::string const& script)
+{
+    std::size_t applications          = 0;
+    TransformerRegistry<DAG> registry = makeTransformerRegistry<DAG>(Basis::AIG);
+    registry.registerTransformer("count", [&applications]() { return std::make_unique<Counter>(applications); });
+
+    auto [circuit, encoder] = parse(CIRCUIT);
+    buildScript<DAG>(script, registry)->apply(*circuit, encoder);
+    return applications;
+}
+
+TEST(Script, ParseNestedStatements)
+{
+    std::vector<ScriptStatement> const statements =
+        ScriptParser("dup_ops; repeat(until_fixpoint, max=20, time=1.5, gates=100){ dup_ops ; repeat(2){3in_min} }; "
+                     "dup_ops;")
+            .parse();
+
+    ASSERT_EQ(statements.size(), 3);
+    ASSERT_EQ(statements[0].transformer, "dup_ops");
+    ASSERT_EQ(statements[2].transformer, "dup_ops");
+
+    ScriptStatement const& loop = statements[1];
+    ASSERT_TRUE(loop.transformer.empty());
+    ASSERT_TRUE(loop.repeat.until_fixpoint);
+    ASSERT_EQ(loop.repeat.max_iterations, 20);
+    ASSERT_DOUBLE_EQ(loop.repeat.time_limit, 1.5);
+    ASSERT_EQ(loop.repeat.max_gates, 100);
+    ASSERT_EQ(loop.body.size(), 2);
+    ASSERT_EQ(loop.body[1].repeat.max_iterations, 2);
+    ASSERT_FALSE(loop.body[1].repeat.until_fixpoint);
+    ASSERT_EQ(loop.body[1].body.size(), 1);
+    ASSERT_EQ(loop.body[1].body[0].transformer, "3in_min");
+}
+
+TEST(Script, RepeatBudgets)
+{
+    ASSERT_EQ(countApplications("count; count"), 2);
+    ASSERT_EQ(countApplications("repeat(3){count; repeat(2){count}}"), 9);
+    // Counter doesn't decrease number of gates, so fixpoint is reached after the first iteration.
+    ASSERT_EQ(countApplications("repeat(until_fixpoint){count}"), 1);
+    ASSERT_EQ(countApplications("repeat(until_fixpoint, max=0){count}"), 0);
+    ASSERT_EQ(countApplications("repeat(4, gates=7){count}"), 4);
+    ASSERT_EQ(countApplications("repeat(4, gates=6){count}"), 0);
+    ASSERT_EQ(countApplications("repeat(4, time=0){count}"), 0);
+}
+
+TEST(Script, MatchesCompileTimeComposition)
+{
+    auto [circuit, encoder] = parse(CIRCUIT);
+
+    auto [expected, expected_encoder] =
+        Composition<DAG, Nest<DAG, 2, DuplicateOperandsCleaner<DAG>>, ReduceNotComposition<DAG>>().apply(
+            *circuit, encoder);
+    auto [result, result_encoder] =
+        buildScript<DAG>("repeat(2){dup_ops}; reduce_not", makeTransformerRegistry<DAG>(Basis::AIG))
+            ->apply(*circuit, encoder);
+
+    ASSERT_EQ(result->getNumberOfGates(), expected->getNumberOfGates());
+    for (GateId gateId = 0; gateId < result->getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(result->getGateType(gateId), expected->getGateType(gateId));
+        GateIdSpan const operands          = result->getGateOperands(gateId);
+        GateIdSpan const expected_operands = expected->getGateOperands(gateId);
+        ASSERT_TRUE(std::ranges::equal(operands, expected_operands));
+        ASSERT_EQ(result_encoder->decodeGate(gateId), expected_encoder->decodeGate(gateId));
+    }
+    ASSERT_EQ(result->getOutputGates(), expected->getOutputGates());
+}
+
+TEST(ScriptDeathTest, MalformedScripts)
+{
+    TransformerRegistry<DAG> const registry = makeTransformerRegistry<DAG>(Basis::AIG);
+    ASSERT_DEATH(buildScript<DAG>("dup_ops; unknown", registry), "Unknown transformer");
+    ASSERT_DEATH(ScriptParser("repeat(3){dup_ops").parse(), "expected \"}\"");
+    ASSERT_DEATH(ScriptParser("repeat(gates=3){dup_ops}").parse(), "repeat requires");
+    ASSERT_DEATH(ScriptParser("repeat(max=x){dup_ops}").parse(), "expected a number");
+    ASSERT_DEATH(ScriptParser("dup_ops}").parse(), "unexpected");
+}
+
+}  // namespace
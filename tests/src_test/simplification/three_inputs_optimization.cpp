@@ -0,0 +1,92 @@
+#include "src/common/csat_types.hpp"
+#include "src/generation/circuit_generator.hpp"
+#include "src/structures/circuit/dag.hpp"
+
+#include "src/simplification/composition.hpp"
+#include "src/simplification/three_inputs_optimization.hpp"
+#include "src/utility/thread_pool.hpp"
+#include "tests/src_test/simplification/utils/single_circuit_db.hpp"
+
+#include <cstdint>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simplification;
+
+/**
+ * Builds AIG circuit of many overlapping subcircuits OR(AND(x, y), AND(x, z)) of random gates,
+ * each of which may be expressed by two AND gates instead of three.
+ */
+std::unique_ptr<DAG> buildOverlappingSubcircuits(size_t inputs, size_t subcircuits)
+{
+    GateInfoContainer gate_info(inputs, GateInfo(GateType::INPUT, {}));
+    uint64_t state         = 42;
+    auto const random_gate = [&state, &gate_info]()
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<GateId>((state >> 33) % gate_info.size());
+    };
+    auto const add_gate = [&gate_info](GateType type, GateIdContainer operands)
+    {
+        gate_info.emplace_back(type, std::move(operands));
+        return static_cast<GateId>(gate_info.size() - 1);
+    };
+
+    GateIdContainer outputs{};
+    for (size_t subcircuit = 0; subcircuit < subcircuits; ++subcircuit)
+    {
+        GateId const x      = random_gate();
+        GateId const y      = random_gate();
+        GateId const z      = random_gate();
+        GateId const first  = add_gate(GateType::AND, {x, y});
+        GateId const second = add_gate(GateType::AND, {x, z});
+        GateId const both   = add_gate(
+            GateType::AND, {add_gate(GateType::NOT, {first}), add_gate(GateType::NOT, {second})});
+        outputs.push_back(add_gate(GateType::NOT, {both}));
+    }
+    return std::make_unique<DAG>(std::move(gate_info), std::move(outputs));
+}
+
+TEST(ThreeInputsSubcircuitMinimization, ParallelAnalysisMatchesSequential)
+{
+    test::ScopedAigDB const db_guard(test::makeSingleCircuitDB());
+
+    auto const circuit = buildOverlappingSubcircuits(40, 3'000);
+    auto const encoder = generation::makeGateEncoder(circuit->getNumberOfGates());
+
+    SimplificationContext sequential_context{};
+    auto [sequential, sequential_encoder] =
+        Composition<DAG, ThreeInputsSubcircuitMinimization<DAG>>().apply(*circuit, encoder, sequential_context);
+
+    utils::ThreadPool pool(4);
+    SimplificationContext parallel_context{};
+    parallel_context.thread_pool = &pool;
+    auto [parallel, parallel_encoder] =
+        Composition<DAG, ThreeInputsSubcircuitMinimization<DAG>>().apply(*circuit, encoder, parallel_context);
+
+    // Subcircuits share gates, so improvements of some of them conflict with each other.
+    IterationStats const stats = sequential_context.stats.getIterations().at(0);
+    ASSERT_GT(stats.reduced_subcircuits, 0);
+    ASSERT_GT(stats.skipped_subcircuits, 0);
+
+    IterationStats const parallel_stats = parallel_context.stats.getIterations().at(0);
+    ASSERT_EQ(parallel_stats.reduced_subcircuits, stats.reduced_subcircuits);
+    ASSERT_EQ(parallel_stats.skipped_subcircuits, stats.skipped_subcircuits);
+    ASSERT_EQ(parallel_stats.simplified_gates, stats.simplified_gates);
+
+    ASSERT_EQ(parallel->getNumberOfGates(), sequential->getNumberOfGates());
+    ASSERT_EQ(parallel->getOutputGates(), sequential->getOutputGates());
+    for (GateId gateId = 0; gateId < sequential->getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(parallel->getGateType(gateId), sequential->getGateType(gateId));
+        ASSERT_EQ(parallel->getGateOperands(gateId), sequential->getGateOperands(gateId));
+        ASSERT_EQ(parallel_encoder->decodeGate(gateId), sequential_encoder->decodeGate(gateId));
+    }
+}
+
+} // namespace
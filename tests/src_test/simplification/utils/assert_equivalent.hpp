@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "src/common/csat_types.hpp"
+#include "src/structures/assignment/vector_assignment.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/utility/encoder.hpp"
+
+#include "gtest/gtest.h"
+
+namespace csat::test
+{
+
+/**
+ * Checks that circuits compute the same outputs on all assignments of inputs, which are matched by names.
+ * Inputs of the left circuit may be absent in the right one, e.g. if they were removed as redundant.
+ */
+inline void assertEquivalent(
+    DAG const& lhs,
+    utils::GateEncoder<std::string> const& lhs_encoder,
+    DAG const& rhs,
+    utils::GateEncoder<std::string> rhs_encoder)
+{
+    ASSERT_LE(rhs.getInputGates().size(), lhs.getInputGates().size());
+    ASSERT_EQ(lhs.getOutputGates().size(), rhs.getOutputGates().size());
+    size_t const inputs_number = lhs.getInputGates().size();
+    for (size_t mask = 0; mask < (size_t{1} << inputs_number); ++mask)
+    {
+        VectorAssignment<> lhs_assignment{};
+        VectorAssignment<> rhs_assignment{};
+        for (size_t input = 0; input < inputs_number; ++input)
+        {
+            GateState const state = ((mask >> input) & 1U) != 0U ? GateState::TRUE : GateState::FALSE;
+            lhs_assignment.assign(lhs.getInputGates()[input], state);
+            std::string const name = lhs_encoder.decodeGate(lhs.getInputGates()[input]);
+            if (rhs_encoder.keyExists(name))
+            {
+                rhs_assignment.assign(rhs_encoder.encodeGate(name), state);
+            }
+        }
+        auto const lhs_result = lhs.evaluateCircuit(lhs_assignment);
+        auto const rhs_result = rhs.evaluateCircuit(rhs_assignment);
+        for (size_t output = 0; output < lhs.getOutputGates().size(); ++output)
+        {
+            ASSERT_EQ(
+                lhs_result->getGateState(lhs.getOutputGates()[output]),
+                rhs_result->getGateState(rhs.getOutputGates()[output]));
+        }
+    }
+}
+
+}  // namespace csat::test
@@ -0,0 +1,114 @@
+#include "src/simplification/utils/circuits_db.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simplification;
+
+TEST(CircuitDBTest, PackedLookup)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "csat_circuits_db_test.txt";
+    {
+        std::ofstream file(path);
+        file << "3 1 0 4 NOT 0 AND 0 3\n"
+                "3 2 15 192 3 4 NOT 0 AND 0 1\n"
+                "3 1 192 3 AND 0 1\n";
+    }
+    CircuitDB const db(path, Basis::AIG);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(db.size(), 3);
+
+    // The last circuit with the same outputs is indexed.
+    std::vector<int32_t> const and_patterns{192};
+    ASSERT_EQ(db.findPattern(CircuitDB::packPatterns(and_patterns)), 2);
+    ASSERT_EQ(db.getOperatorsNumber(2), 1);
+    ASSERT_EQ(db.getGates(2).size(), 1);
+    ASSERT_EQ(db.getGates(2)[0].type, GateType::AND);
+    ASSERT_EQ(std::vector<uint16_t>(db.getGates(2)[0].getOperands().begin(), db.getGates(2)[0].getOperands().end()),
+              std::vector<uint16_t>({0, 1}));
+
+    std::vector<int32_t> const two_patterns{15, 192};
+    int32_t const index = db.findPattern(CircuitDB::packPatterns(two_patterns));
+    ASSERT_EQ(index, 1);
+    ASSERT_EQ(std::vector<uint16_t>(db.getOutputs(index).begin(), db.getOutputs(index).end()),
+              std::vector<uint16_t>({3, 4}));
+    ASSERT_EQ(db.getGates(index)[0].type, GateType::NOT);
+    ASSERT_EQ(db.getGates(index)[0].getOperands().size(), 1);
+
+    // Keys depend on the number and the order of patterns.
+    std::vector<int32_t> const swapped_patterns{192, 15};
+    std::vector<int32_t> const zero_patterns{0, 192};
+    ASSERT_EQ(db.findPattern(CircuitDB::packPatterns(swapped_patterns)), CircuitDB::NOT_FOUND);
+    ASSERT_EQ(db.findPattern(CircuitDB::packPatterns(zero_patterns)), CircuitDB::NOT_FOUND);
+    ASSERT_NE(CircuitDB::packPatterns(and_patterns), CircuitDB::packPatterns(zero_patterns));
+
+    std::vector<int32_t> const too_many_patterns{1, 2, 3, 4};
+    ASSERT_EQ(CircuitDB::packPatterns(too_many_patterns), CircuitDB::INVALID_KEY);
+    ASSERT_EQ(db.findPattern(CircuitDB::INVALID_KEY), CircuitDB::NOT_FOUND);
+}
+
+TEST(CircuitDBTest, BinaryImage)
+{
+    std::filesystem::path const text_path  = std::filesystem::temp_directory_path() / "csat_circuits_db_image.txt";
+    std::filesystem::path const image_path = std::filesystem::temp_directory_path() / "csat_circuits_db_image.bin";
+    {
+        std::ofstream file(text_path);
+        file << "3 1 0 4 NOT 0 AND 0 3\n"
+                "3 2 15 192 3 4 NOT 0 AND 0 1\n"
+                "3 1 60 3 XOR 0 1\n";
+    }
+    CircuitDB const text_db(text_path, Basis::BENCH);
+    std::filesystem::remove(text_path);
+    text_db.writeImage(image_path);
+
+    ASSERT_TRUE(CircuitDB::isCompatibleImage(image_path, Basis::BENCH));
+    ASSERT_FALSE(CircuitDB::isCompatibleImage(image_path, Basis::AIG));
+
+    CircuitDB const image_db(image_path, Basis::BENCH);
+    ASSERT_FALSE(text_db.isMapped());
+    ASSERT_TRUE(image_db.isMapped());
+    ASSERT_EQ(image_db.size(), text_db.size());
+    for (int32_t index = 0; index < static_cast<int32_t>(text_db.size()); ++index)
+    {
+        ASSERT_EQ(image_db.getOperatorsNumber(index), text_db.getOperatorsNumber(index));
+        ASSERT_TRUE(std::ranges::equal(image_db.getOutputs(index), text_db.getOutputs(index)));
+        ASSERT_EQ(image_db.getGates(index).size(), text_db.getGates(index).size());
+        for (size_t gate = 0; gate < text_db.getGates(index).size(); ++gate)
+        {
+            ASSERT_EQ(image_db.getGates(index)[gate].type, text_db.getGates(index)[gate].type);
+            ASSERT_TRUE(std::ranges::equal(
+                image_db.getGates(index)[gate].getOperands(), text_db.getGates(index)[gate].getOperands()));
+        }
+    }
+    for (int32_t pattern = 0; pattern <= UINT8_MAX; ++pattern)
+    {
+        std::vector<int32_t> const patterns{pattern};
+        uint32_t const key = CircuitDB::packPatterns(patterns);
+        ASSERT_EQ(image_db.findPattern(key), text_db.findPattern(key));
+    }
+    std::vector<int32_t> const two_patterns{15, 192};
+    ASSERT_EQ(image_db.findPattern(CircuitDB::packPatterns(two_patterns)), 1);
+
+    // Images of another version are rejected.
+    {
+        std::fstream file(image_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(CircuitDB::IMAGE_MAGIC.size()));
+        uint32_t const version = CircuitDB::IMAGE_VERSION + 1;
+        file.write(reinterpret_cast<char const*>(&version), sizeof(version));
+    }
+    ASSERT_FALSE(CircuitDB::isCompatibleImage(image_path, Basis::BENCH));
+    std::filesystem::remove(image_path);
+    ASSERT_FALSE(CircuitDB::isCompatibleImage(image_path, Basis::BENCH));
+}
+
+}  // namespace
@@ -0,0 +1,75 @@
+#include "src/common/csat_types.hpp"
+
+#include "src/simplification/utils/parents_hash_map.hpp"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::utils;
+
+TEST(ParentsHashMap, TwoAndThreeParentsAreDistinct)
+{
+    ParentsHashMap map;
+    map.insert(1, 2, 0);
+    map.insert(1, 2, 3, 1);
+    map.insert(2, 1, 2);
+
+    ASSERT_EQ(map.size(), 3);
+    ASSERT_EQ(map.find(1, 2), 0);
+    ASSERT_EQ(map.find(1, 2, 3), 1);
+    ASSERT_EQ(map.find(2, 1), 2);
+    ASSERT_EQ(map.find(1, 3), ParentsHashMap::NOT_FOUND);
+    ASSERT_EQ(map.find(1, 2, 4), ParentsHashMap::NOT_FOUND);
+    ASSERT_EQ(map.find(0, 1, 2), ParentsHashMap::NOT_FOUND);
+}
+
+TEST(ParentsHashMap, ColorsAreKeptOnGrowth)
+{
+    ParentsHashMap map;
+    ColorId color = 0;
+    for (GateId first = 0; first < 50; ++first)
+    {
+        for (GateId second = first + 1; second < 50; ++second)
+        {
+            map.insert(first, second, color++);
+            map.insert(first, second, second + 1, color++);
+        }
+    }
+
+    ASSERT_EQ(map.size(), color);
+    color = 0;
+    for (GateId first = 0; first < 50; ++first)
+    {
+        for (GateId second = first + 1; second < 50; ++second)
+        {
+            ASSERT_EQ(map.find(first, second), color++);
+            ASSERT_EQ(map.find(first, second, second + 1), color++);
+            ASSERT_EQ(map.find(first, second, second + 2), ParentsHashMap::NOT_FOUND);
+        }
+    }
+}
+
+TEST(ParentsHashMap, LargeGateIds)
+{
+    GateId const large = (GateId{1} << 32) - 2;
+    ParentsHashMap map;
+    map.insert(0, large, 0);
+    map.insert(large - 1, large, 1);
+    map.insert(0, 1, large, 2);
+
+    ASSERT_EQ(map.find(0, large), 0);
+    ASSERT_EQ(map.find(large - 1, large), 1);
+    ASSERT_EQ(map.find(0, 1, large), 2);
+    ASSERT_EQ(map.find(1, large), ParentsHashMap::NOT_FOUND);
+}
+
+TEST(ParentsHashMap, ThirdParentCannotBeSentinel)
+{
+    ParentsHashMap map;
+    ASSERT_DEATH(map.insert(0, 1, ParentsHashMap::NO_PARENT, 0), "supports gate ids less than");
+}
+
+} // namespace
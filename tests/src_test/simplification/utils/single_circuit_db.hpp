@@ -0,0 +1,67 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <utility>
+
+#include "src/simplification/utils/circuits_db.hpp"
+
+namespace csat::test
+{
+
+/**
+ * Circuit of three AND gates: OR(AND(0, 1), AND(0, 2)), which single circuit database expresses by two.
+ */
+inline constexpr char const* THREE_AND_GATES_CIRCUIT = "INPUT(0)\n"
+                                                       "INPUT(1)\n"
+                                                       "INPUT(2)\n"
+                                                       "OUTPUT(8)\n"
+                                                       "3 = AND(0, 1)\n"
+                                                       "4 = AND(0, 2)\n"
+                                                       "5 = NOT(3)\n"
+                                                       "6 = NOT(4)\n"
+                                                       "7 = AND(5, 6)\n"
+                                                       "8 = NOT(7)\n";
+
+/**
+ * @return AIG database of a single circuit: AND(0, OR(1, 2)), expressed by two AND gates.
+ */
+inline std::shared_ptr<simplification::CircuitDB> makeSingleCircuitDB()
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "csat_single_circuit_db.txt";
+    {
+        std::ofstream file(path);
+        file << "3 1 224 7 NOT 1 NOT 2 AND 3 4 NOT 5 AND 0 6\n";
+    }
+    auto db = std::make_shared<simplification::CircuitDB>(path, Basis::AIG);
+    std::filesystem::remove(path);
+    return db;
+}
+
+/**
+ * Installs AIG database into `DBSingleton` for the lifetime of the guard, and restores
+ * the previous one on destruction, even if the test is stopped by a failed assertion.
+ */
+class ScopedAigDB
+{
+  protected:
+    std::shared_ptr<simplification::CircuitDB> previous_db_;
+
+  public:
+    explicit ScopedAigDB(std::shared_ptr<simplification::CircuitDB> db)
+        : previous_db_(std::move(simplification::DBSingleton::getInstance().aig_db))
+    {
+        simplification::DBSingleton::getInstance().aig_db = std::move(db);
+    }
+
+    ScopedAigDB(ScopedAigDB const&)            = delete;
+    ScopedAigDB& operator=(ScopedAigDB const&) = delete;
+
+    ~ScopedAigDB()
+    {
+        simplification::DBSingleton::getInstance().aig_db = std::move(previous_db_);
+    }
+};
+
+}  // namespace csat::test
@@ -0,0 +1,72 @@
+#include "src/simplification/utils/structural_hash_table.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simplification;
+
+TEST(StructuralHashTableTest, FindOrInsert)
+{
+    StructuralHashTable table;
+    GateIdContainer const and_operands{0, 1};
+    GateIdContainer const or_operands{0, 1};
+    GateIdContainer const swapped_operands{1, 0};
+
+    ASSERT_EQ(table.find(GateType::AND, and_operands), StructuralHashTable::NOT_FOUND);
+    ASSERT_EQ(table.findOrInsert(GateType::AND, and_operands, 2), 2);
+    ASSERT_EQ(table.findOrInsert(GateType::AND, and_operands, 3), 2);
+    ASSERT_EQ(table.findOrInsert(GateType::OR, or_operands, 3), 3);
+    // Operands are compared as is, normalization is up to the caller.
+    ASSERT_EQ(table.findOrInsert(GateType::AND, swapped_operands, 4), 4);
+    ASSERT_EQ(table.findOrInsert(GateType::NOT, GateIdContainer{0}, 5), 5);
+    ASSERT_EQ(table.findOrInsert(GateType::CONST_TRUE, GateIdContainer{}, 6), 6);
+
+    ASSERT_EQ(table.size(), 5);
+    ASSERT_EQ(table.find(GateType::AND, and_operands), 2);
+    ASSERT_EQ(table.find(GateType::OR, or_operands), 3);
+    ASSERT_EQ(table.find(GateType::CONST_TRUE, GateIdContainer{}), 6);
+    ASSERT_EQ(table.find(GateType::NOT, GateIdContainer{1}), StructuralHashTable::NOT_FOUND);
+}
+
+TEST(StructuralHashTableTest, EraseAndRehash)
+{
+    StructuralHashTable table;
+    size_t const size = 10'000;
+    for (GateId gateId = 0; gateId < size; ++gateId)
+    {
+        ASSERT_EQ(table.findOrInsert(GateType::AND, GateIdContainer{gateId, gateId + 1}, gateId), gateId);
+    }
+    ASSERT_EQ(table.size(), size);
+
+    // Erase every other structure, the rest must stay reachable.
+    for (GateId gateId = 0; gateId < size; gateId += 2)
+    {
+        ASSERT_TRUE(table.erase(GateType::AND, GateIdContainer{gateId, gateId + 1}));
+    }
+    ASSERT_FALSE(table.erase(GateType::AND, GateIdContainer{0, 1}));
+    ASSERT_EQ(table.size(), size / 2);
+    for (GateId gateId = 0; gateId < size; ++gateId)
+    {
+        GateId const expected = gateId % 2 == 0 ? StructuralHashTable::NOT_FOUND : gateId;
+        ASSERT_EQ(table.find(GateType::AND, GateIdContainer{gateId, gateId + 1}), expected);
+    }
+
+    // Reinsertion after erasure and growth beyond initial capacity.
+    for (GateId gateId = 0; gateId < 2 * size; ++gateId)
+    {
+        GateId const expected = gateId < size && gateId % 2 == 1 ? gateId : gateId + size;
+        ASSERT_EQ(table.findOrInsert(GateType::AND, GateIdContainer{gateId, gateId + 1}, gateId + size), expected);
+    }
+    ASSERT_EQ(table.size(), 2 * size);
+
+    table.clear();
+    ASSERT_EQ(table.size(), 0);
+    ASSERT_EQ(table.find(GateType::AND, GateIdContainer{1, 2}), StructuralHashTable::NOT_FOUND);
+}
+
+}  // namespace
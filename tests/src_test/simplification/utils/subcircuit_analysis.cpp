@@ -0,0 +1,136 @@
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+
+#include "src/simplification/utils/subcircuit_analysis.hpp"
+#include "tests/src_test/simplification/utils/single_circuit_db.hpp"
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simplification;
+using namespace csat::utils;
+
+TEST(SubcircuitAnalysis, SmallerSubcircuitIsFound)
+{
+    auto const db = test::makeSingleCircuitDB();
+
+    std::istringstream stream(test::THREE_AND_GATES_CIRCUIT);
+    csat::parser::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+    std::unique_ptr<DAG> circuit = parser.instantiate();
+    GateEncoder<std::string> encoder = parser.getEncoder();
+
+    TwoColoring const two_coloring(*circuit);
+    ThreeColoring const three_coloring(*circuit);
+    ASSERT_EQ(three_coloring.colors.size(), 1);
+
+    SubcircuitAnalysis analysis{};
+    analyzeSubcircuit(
+        *circuit, three_coloring.colors[0], two_coloring, three_coloring.negationUsers, *db, Basis::AIG, analysis);
+
+    ASSERT_TRUE(analysis.closed);
+    ASSERT_EQ(analysis.verdict, SubcircuitAnalysis::Verdict::FOUND);
+    ASSERT_EQ(analysis.operators_number, 3);
+    ASSERT_EQ(analysis.gates.size(), 6);
+    ASSERT_EQ(analysis.all_outputs, GateIdContainer({encoder.encodeGate("8")}));
+    ASSERT_EQ(analysis.pattern_output_gates, GateIdContainer({encoder.encodeGate("8")}));
+    ASSERT_TRUE(analysis.rewrites.empty());
+
+    // Tables of subcircuit are kept within the analysis.
+    size_t const output = analysis.findMember(encoder.encodeGate("8"));
+    ASSERT_NE(output, SIZE_MAX);
+    ASSERT_TRUE(analysis.evaluated[output]);
+    ASSERT_EQ(analysis.tables[output], 224);
+}
+
+TEST(SubcircuitAnalysis, OutputsAreRewritten)
+{
+    auto const db = test::makeSingleCircuitDB();
+
+    // Output 6 is a copy of output 5, and output 7 is a negation of a parent.
+    std::string const dag = "INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "INPUT(2)\n"
+                            "OUTPUT(5)\n"
+                            "OUTPUT(6)\n"
+                            "OUTPUT(7)\n"
+                            "3 = AND(0, 1)\n"
+                            "4 = AND(0, 2)\n"
+                            "5 = AND(3, 4)\n"
+                            "6 = AND(4, 3)\n"
+                            "7 = NOT(0)\n";
+    std::istringstream stream(dag);
+    csat::parser::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+    std::unique_ptr<DAG> circuit = parser.instantiate();
+    GateEncoder<std::string> encoder = parser.getEncoder();
+
+    TwoColoring const two_coloring(*circuit);
+    ThreeColoring const three_coloring(*circuit);
+    ASSERT_EQ(three_coloring.colors.size(), 1);
+
+    SubcircuitAnalysis analysis{};
+    analyzeSubcircuit(
+        *circuit, three_coloring.colors[0], two_coloring, three_coloring.negationUsers, *db, Basis::AIG, analysis);
+
+    ASSERT_TRUE(analysis.closed);
+    ASSERT_EQ(analysis.rewrites.size(), 2);
+    // Negation of a parent is kept as is, so it is not counted as modified.
+    ASSERT_EQ(analysis.rewrites[0].gate, encoder.encodeGate("7"));
+    ASSERT_EQ(analysis.rewrites[0].type, GateType::NOT);
+    ASSERT_EQ(analysis.rewrites[0].first_operand, encoder.encodeGate("0"));
+    ASSERT_FALSE(analysis.rewrites[0].modified);
+    ASSERT_EQ(analysis.rewrites[1].gate, encoder.encodeGate("6"));
+    ASSERT_EQ(analysis.rewrites[1].type, GateType::AND);
+    ASSERT_EQ(analysis.rewrites[1].first_operand, encoder.encodeGate("5"));
+    ASSERT_TRUE(analysis.rewrites[1].modified);
+    ASSERT_TRUE(analysis.primitive_gates.empty());
+    // AND(0, 1, 2) is not in database.
+    ASSERT_EQ(analysis.verdict, SubcircuitAnalysis::Verdict::NOT_IN_DB);
+}
+
+TEST(SubcircuitAnalysis, SubcircuitReadingOutsideGatesIsNotClosed)
+{
+    auto const db = test::makeSingleCircuitDB();
+
+    // Parent 1 has two negations, and only the last one is a member of subcircuit,
+    // so gate 5 reads truth table of gate 3, which is not evaluated within it.
+    std::string const dag = "INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "INPUT(2)\n"
+                            "OUTPUT(5)\n"
+                            "OUTPUT(6)\n"
+                            "OUTPUT(7)\n"
+                            "3 = NOT(1)\n"
+                            "4 = AND(1, 2)\n"
+                            "5 = AND(3, 4)\n"
+                            "6 = AND(0, 4)\n"
+                            "7 = NOT(1)\n";
+    std::istringstream stream(dag);
+    csat::parser::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+    std::unique_ptr<DAG> circuit = parser.instantiate();
+    GateEncoder<std::string> encoder = parser.getEncoder();
+
+    TwoColoring const two_coloring(*circuit);
+    ThreeColoring const three_coloring(*circuit);
+    ASSERT_EQ(three_coloring.colors.size(), 1);
+
+    SubcircuitAnalysis analysis{};
+    analyzeSubcircuit(
+        *circuit, three_coloring.colors[0], two_coloring, three_coloring.negationUsers, *db, Basis::AIG, analysis);
+
+    ASSERT_EQ(analysis.findMember(encoder.encodeGate("3")), SIZE_MAX);
+    ASSERT_FALSE(analysis.closed);
+    ASSERT_TRUE(analysis.rewrites.empty());
+    ASSERT_TRUE(analysis.primitive_gates.empty());
+}
+
+} // namespace
@@ -0,0 +1,62 @@
+#include "src/simplification/utils/truth_table.hpp"
+
+#include <array>
+#include <cstddef>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::utils;
+
+// Evaluates `f = (x AND NOT y) XOR z` on the given truth tables of its inputs.
+TruthTable3 evaluateSample(TruthTable3 x, TruthTable3 y, TruthTable3 z)
+{
+    TruthTable3 not_y     = 0;
+    TruthTable3 x_and_not = 0;
+    TruthTable3 result    = 0;
+    evaluateTruthTable(GateType::NOT, y, y, not_y);
+    evaluateTruthTable(GateType::AND, x, not_y, x_and_not);
+    evaluateTruthTable(GateType::XOR, x_and_not, z, result);
+    return result;
+}
+
+TEST(TruthTableTest, PermutationsMatchReevaluation)
+{
+    TruthTable3 const identity = evaluateSample(FIRST_INPUT_TT, SECOND_INPUT_TT, THIRD_INPUT_TT);
+    for (size_t permutation = 0; permutation < INPUTS_PERMUTATIONS_NUMBER; ++permutation)
+    {
+        auto const& inputs = INPUTS_PERMUTATIONS[permutation];
+        ASSERT_EQ(permuteTruthTable(permutation, identity), evaluateSample(inputs[0], inputs[1], inputs[2]));
+    }
+}
+
+TEST(TruthTableTest, PermutationsAreBijections)
+{
+    for (size_t permutation = 0; permutation < INPUTS_PERMUTATIONS_NUMBER; ++permutation)
+    {
+        std::array<bool, 256> seen{};
+        for (size_t table = 0; table < 256; ++table)
+        {
+            TruthTable3 const permuted = permuteTruthTable(permutation, static_cast<TruthTable3>(table));
+            ASSERT_FALSE(seen[permuted]);
+            seen[permuted] = true;
+            // Permutation of inputs preserves the number of satisfying assignments.
+            ASSERT_EQ(__builtin_popcount(permuted), __builtin_popcount(table));
+        }
+    }
+}
+
+TEST(TruthTableTest, Evaluation)
+{
+    TruthTable3 result = 0;
+    ASSERT_TRUE(evaluateTruthTable(GateType::NAND, FIRST_INPUT_TT, SECOND_INPUT_TT, result));
+    ASSERT_EQ(result, 0b00111111);
+    ASSERT_TRUE(evaluateTruthTable(GateType::NXOR, SECOND_INPUT_TT, THIRD_INPUT_TT, result));
+    ASSERT_EQ(result, 0b10011001);
+    ASSERT_FALSE(evaluateTruthTable(GateType::MUX, FIRST_INPUT_TT, SECOND_INPUT_TT, result));
+}
+
+}  // namespace
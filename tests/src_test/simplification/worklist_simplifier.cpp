@@ -0,0 +1,175 @@
+#include "src/common/csat_types.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+
+#include "src/simplification/composition.hpp"
+#include "src/simplification/strategy.hpp"
+#include "tests/src_test/simplification/utils/assert_equivalent.hpp"
+#include "tests/src_test/simplification/utils/single_circuit_db.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simplification;
+
+/**
+ * Parses circuit and simplifies it by worklist simplification only.
+ */
+struct Simplified
+{
+    std::unique_ptr<DAG> original;
+    csat::utils::GateEncoder<std::string> original_encoder;
+    std::unique_ptr<DAG> circuit;
+    std::unique_ptr<csat::utils::GateEncoder<std::string>> encoder;
+    SimplificationContext context{};
+
+    explicit Simplified(std::string const& dag)
+    {
+        std::istringstream stream(dag);
+        csat::parser::BenchToCircuit<DAG> parser;
+        parser.parseStream(stream);
+        original         = parser.instantiate();
+        original_encoder = parser.getEncoder();
+        std::tie(circuit, encoder) =
+            Composition<DAG, WorklistSimplifier_<DAG>>().apply(*original, original_encoder, context);
+    }
+};
+
+TEST(WorklistSimplifier, ConstantsAndNotFolding)
+{
+    Simplified const result("INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "OUTPUT(7)\n"
+                            "2 = NOT(0)\n"
+                            "3 = AND(0, 2)\n"
+                            "4 = OR(3, 1)\n"
+                            "5 = NOT(4)\n"
+                            "6 = NOT(5)\n"
+                            "7 = XOR(6, 3, 0)\n");
+
+    // AND(x, NOT(x)) is false, so the output is XOR(1, 0).
+    ASSERT_EQ(result.circuit->getNumberOfGates(), 3);
+    ASSERT_EQ(result.circuit->getGateType(result.circuit->getOutputGates()[0]), GateType::XOR);
+    test::assertEquivalent(*result.original, result.original_encoder, *result.circuit, *result.encoder);
+}
+
+TEST(WorklistSimplifier, DuplicateAndOppositeOperands)
+{
+    Simplified const result("INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "OUTPUT(5)\n"
+                            "OUTPUT(6)\n"
+                            "2 = NOT(1)\n"
+                            "3 = AND(0, 0, 1)\n"
+                            "4 = XOR(1, 2, 0)\n"
+                            "5 = NAND(3, 3)\n"
+                            "6 = AND(4, 4)\n");
+
+    // NAND(AND(x, y), AND(x, y)) is NOT(AND(x, y)), and XOR(x, NOT(x), y) is NOT(y).
+    DAG const& circuit = *result.circuit;
+    GateId const first = circuit.getOutputGates()[0];
+    ASSERT_EQ(circuit.getGateType(first), GateType::NOT);
+    ASSERT_EQ(circuit.getGateType(circuit.getGateOperands(first)[0]), GateType::AND);
+    ASSERT_EQ(circuit.getGateOperands(circuit.getGateOperands(first)[0]).size(), 2);
+    ASSERT_EQ(circuit.getGateType(circuit.getOutputGates()[1]), GateType::NOT);
+    test::assertEquivalent(*result.original, result.original_encoder, circuit, *result.encoder);
+}
+
+TEST(WorklistSimplifier, StructuralHashingAfterRewrites)
+{
+    Simplified const result("INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "OUTPUT(6)\n"
+                            "2 = NOT(0)\n"
+                            "3 = NOT(2)\n"
+                            "4 = AND(0, 1)\n"
+                            "5 = AND(1, 3)\n"
+                            "6 = XOR(4, 5)\n");
+
+    // Gate 5 becomes a duplicate of gate 4 once NOT(NOT(0)) is folded, so XOR of them is false.
+    DAG const& circuit = *result.circuit;
+    ASSERT_EQ(circuit.getGateType(circuit.getOutputGates()[0]), GateType::CONST_FALSE);
+    ASSERT_GT(result.context.worklist_stats.replaced_gates, 0);
+    test::assertEquivalent(*result.original, result.original_encoder, circuit, *result.encoder);
+}
+
+TEST(WorklistSimplifier, ResubstitutionByDatabase)
+{
+    test::ScopedAigDB const db_guard(test::makeSingleCircuitDB());
+    Simplified const result(test::THREE_AND_GATES_CIRCUIT);
+
+    size_t and_gates = 0;
+    for (GateId gateId = 0; gateId < result.circuit->getNumberOfGates(); ++gateId)
+    {
+        and_gates += result.circuit->getGateType(gateId) == GateType::AND ? 1 : 0;
+    }
+    ASSERT_EQ(and_gates, 2);
+    ASSERT_EQ(result.context.worklist_stats.resubstituted_gates, 1);
+    test::assertEquivalent(*result.original, result.original_encoder, *result.circuit, *result.encoder);
+}
+
+TEST(WorklistSimplifier, LongChainsOfRemovedGates)
+{
+    // Removal of a chain must not recurse once per gate, otherwise it overflows the call stack.
+    size_t const chain_length = 300'000;
+    std::ostringstream dag;
+    dag << "INPUT(0)\n"
+           "INPUT(1)\n"
+           "INPUT(2)\n"
+           "OUTPUT(a)\n"
+           "OUTPUT(b)\n"
+           "a = AND(0, 1)\n"
+           "n = NOT(0)\n"
+           "b = AND(c" << chain_length - 1 << ", 0, n)\n"
+           "c0 = AND(0, 1)\n"
+           "d0 = AND(0, 1)\n";
+    for (size_t i = 1; i < chain_length; ++i)
+    {
+        // Chain `c` is removed once output `b` becomes false, chain `d` is not reachable from outputs.
+        dag << "c" << i << " = XOR(c" << i - 1 << ", " << i % 3 << ")\n";
+        dag << "d" << i << " = XOR(d" << i - 1 << ", " << i % 3 << ")\n";
+    }
+
+    Simplified const result(dag.str());
+
+    DAG const& circuit = *result.circuit;
+    ASSERT_EQ(circuit.getNumberOfGates(), 5);
+    ASSERT_EQ(circuit.getGateType(circuit.getOutputGates()[0]), GateType::AND);
+    ASSERT_EQ(circuit.getGateType(circuit.getOutputGates()[1]), GateType::CONST_FALSE);
+}
+
+TEST(WorklistSimplifier, IncrementalSimplificationStrategy)
+{
+    std::string const dag = "INPUT(0)\n"
+                            "INPUT(1)\n"
+                            "INPUT(2)\n"
+                            "OUTPUT(7)\n"
+                            "OUTPUT(8)\n"
+                            "3 = AND(0, 1)\n"
+                            "4 = NOT(0)\n"
+                            "5 = AND(4, 0)\n"
+                            "6 = OR(5, 3)\n"
+                            "7 = AND(6, 2, 2)\n"
+                            "8 = OR(5, 5)\n";
+
+    std::istringstream stream(dag);
+    csat::parser::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+    std::unique_ptr<DAG> csat_instance            = parser.instantiate();
+    csat::utils::GateEncoder<std::string> encoder = parser.getEncoder();
+
+    auto [circuit, new_encoder] = IncrementalSimplification<DAG>().apply(*csat_instance, encoder);
+
+    // The second output is constant, and is replaced by a gadget of two gates.
+    ASSERT_EQ(circuit->getNumberOfGatesWithoutInputs(), 4);
+    test::assertEquivalent(*csat_instance, encoder, *circuit, *new_encoder);
+}
+
+}  // namespace
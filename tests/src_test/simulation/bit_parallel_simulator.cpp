@@ -0,0 +1,122 @@
+#include "src/simulation/bit_parallel_simulator.hpp"
+
+#include <array>
+#include <cstdint>
+
+#include "src/common/csat_types.hpp"
+#include "src/generation/circuit_generator.hpp"
+#include "src/structures/assignment/vector_assignment.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/utility/thread_pool.hpp"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+using namespace csat::simulation;
+
+DAG buildAllTypesCircuit()
+{
+    return DAG(
+        {
+            {GateType::INPUT, {}},
+            {GateType::INPUT, {}},
+            {GateType::INPUT, {}},
+            {GateType::NOT, {0}},
+            {GateType::AND, {0, 1, 2}},
+            {GateType::NAND, {0, 1}},
+            {GateType::OR, {1, 2}},
+            {GateType::NOR, {0, 1, 2}},
+            {GateType::XOR, {0, 1, 2}},
+            {GateType::NXOR, {3, 2}},
+            {GateType::IFF, {6}},
+            {GateType::MUX, {0, 5, 8}},
+            {GateType::CONST_FALSE, {}},
+            {GateType::CONST_TRUE, {}},
+            {GateType::OR, {12, 4}},
+            {GateType::AND, {13, 11}},
+        },
+        {3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15});
+}
+
+TEST(BitParallelSimulatorTest, MatchesEvaluation)
+{
+    DAG const circuit = buildAllTypesCircuit();
+    BitParallelSimulator<1> simulator(circuit);
+    // Patterns `j` and `j + 8` assign bits of `j % 8` to inputs.
+    std::array<BitParallelSimulator<1>::Patterns, 3> const inputs{
+        {{0xF0F0F0F0F0F0F0F0ULL}, {0xCCCCCCCCCCCCCCCCULL}, {0xAAAAAAAAAAAAAAAAULL}}};
+    simulator.simulate(inputs);
+
+    for (size_t pattern = 0; pattern < 8; ++pattern)
+    {
+        VectorAssignment<> assignment{};
+        for (GateId input = 0; input < 3; ++input)
+        {
+            bool const value = ((inputs[input][0] >> pattern) & 1U) != 0U;
+            assignment.assign(input, value ? GateState::TRUE : GateState::FALSE);
+        }
+        auto const evaluation = circuit.evaluateCircuit(assignment);
+        for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+        {
+            bool const value = ((simulator.getValues(gateId)[0] >> pattern) & 1U) != 0U;
+            ASSERT_EQ(evaluation->getGateState(gateId), value ? GateState::TRUE : GateState::FALSE)
+                << "gate " << gateId << ", pattern " << pattern;
+        }
+    }
+}
+
+TEST(BitParallelSimulatorTest, RandomSignatures)
+{
+    DAG const circuit(
+        {
+            {GateType::INPUT, {}},
+            {GateType::INPUT, {}},
+            {GateType::AND, {0, 1}},
+            {GateType::NOT, {0}},
+            {GateType::NOT, {1}},
+            {GateType::OR, {3, 4}},
+            {GateType::XOR, {0, 1}},
+        },
+        {2, 5, 6});
+    BitParallelSimulator<4> simulator(circuit);
+    simulator.simulateRandom(1);
+    std::array<uint64_t, 4> const first_values{
+        simulator.getValues(6)[0], simulator.getValues(6)[1], simulator.getValues(6)[2], simulator.getValues(6)[3]};
+
+    // AND and OR of negations are complementary, but are not equivalent.
+    ASSERT_TRUE(simulator.mayBeComplementary(2, 5));
+    ASSERT_FALSE(simulator.mayBeEquivalent(2, 5));
+    ASSERT_TRUE(simulator.mayBeEquivalent(2, 2));
+    ASSERT_FALSE(simulator.mayBeEquivalent(2, 6));
+
+    // Simulation is reproducible.
+    simulator.simulateRandom(2);
+    simulator.simulateRandom(1);
+    for (size_t word = 0; word < 4; ++word)
+    {
+        ASSERT_EQ(simulator.getValues(6)[word], first_values[word]);
+    }
+}
+
+
+TEST(BitParallelSimulatorTest, ParallelMatchesSequential)
+{
+    DAG const circuit = generation::generateDAG(
+        {.family = generation::Family::RANDOM, .size = 20'000, .inputs = 100, .outputs = 10, .depth = 50});
+    utils::ThreadPool pool(4);
+    BitParallelSimulator<2> sequential(circuit);
+    BitParallelSimulator<2> parallel(circuit, &pool);
+    sequential.simulateRandom(3);
+    parallel.simulateRandom(3);
+    for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        ASSERT_TRUE(parallel.mayBeEquivalent(gateId, gateId));
+        ASSERT_EQ(parallel.getValues(gateId)[0], sequential.getValues(gateId)[0]) << "gate " << gateId;
+        ASSERT_EQ(parallel.getValues(gateId)[1], sequential.getValues(gateId)[1]) << "gate " << gateId;
+    }
+}
+
+}  // namespace
@@ -0,0 +1,160 @@
+#include "src/common/csat_types.hpp"
+#include "src/algo.hpp"
+#include "src/parser/bench_to_circuit.hpp"
+#include "src/simplification/strategy.hpp"
+#include "src/structures/circuit/csr_dag.hpp"
+#include "src/structures/circuit/dag.hpp"
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(CsrDAGTest, SimpleConstruction)
+{
+    auto dag = csat::CsrDAG(
+        {
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::AND, {0, 1}}
+        },
+        {2});
+    ASSERT_TRUE(dag.getNumberOfGates() == 3);
+    ASSERT_TRUE(dag.getNumberOfGatesWithoutInputs() == 1);
+    ASSERT_TRUE(dag.getGateType(2) == csat::GateType::AND);
+    ASSERT_TRUE(dag.getGateOperands(0) == csat::GateIdContainer({}));
+    ASSERT_TRUE(dag.getGateOperands(2) == csat::GateIdContainer({0, 1}));
+    ASSERT_TRUE(dag.getGateUsers(0) == csat::GateIdContainer({2}));
+    ASSERT_TRUE(dag.getGateUsers(1) == csat::GateIdContainer({2}));
+    ASSERT_TRUE(dag.getGateUsers(2) == csat::GateIdContainer({}));
+    ASSERT_TRUE(dag.getInputGates() == csat::GateIdContainer({0, 1}));
+    ASSERT_TRUE(dag.isOutputGate(2));
+    ASSERT_FALSE(dag.isOutputGate(0));
+}
+
+TEST(CsrDAGTest, SameTopologyAsDAG)
+{
+    csat::GateInfoContainer const gate_info{
+        {csat::GateType::INPUT, {}},
+        {csat::GateType::INPUT, {}},
+        {csat::GateType::INPUT, {}},
+        {csat::GateType::NOT, {1}},
+        {csat::GateType::AND, {0, 3}},
+        {csat::GateType::OR, {2, 3}},
+        {csat::GateType::XOR, {4, 5, 4}},
+        {csat::GateType::MUX, {6, 1, 2}}
+    };
+    auto dag     = csat::DAG(gate_info, {6, 7});
+    auto csr_dag = csat::CsrDAG(gate_info, {6, 7});
+
+    ASSERT_EQ(dag.getNumberOfGates(), csr_dag.getNumberOfGates());
+    ASSERT_EQ(dag.getOutputGates(), csr_dag.getOutputGates());
+    for (csat::GateId gateId = 0; gateId < dag.getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(dag.getGateType(gateId), csr_dag.getGateType(gateId));
+        ASSERT_EQ(dag.getGateOperands(gateId), csr_dag.getGateOperands(gateId));
+        ASSERT_EQ(dag.getGateUsers(gateId), csr_dag.getGateUsers(gateId));
+        ASSERT_EQ(dag.isOutputGate(gateId), csr_dag.isOutputGate(gateId));
+    }
+    ASSERT_EQ(
+        csat::algo::TopSortAlgorithm<csat::algo::DFSTopSort>::sorting(dag),
+        csat::algo::TopSortAlgorithm<csat::algo::DFSTopSort>::sorting(csr_dag));
+}
+
+TEST(CsrDAGTest, Calculation)
+{
+    auto dag = csat::CsrDAG(
+        {
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::OR, {0, 1}},
+            {csat::GateType::AND, {0, 1}}
+        },
+        {2, 3});
+
+    auto asmt = csat::VectorAssignment<>{};
+    ASSERT_TRUE(dag.evaluateCircuit(asmt)->getGateState(2) == csat::GateState::UNDEFINED);
+    asmt.assign(0, csat::GateState::TRUE);
+    ASSERT_TRUE(dag.evaluateCircuit(asmt)->getGateState(2) == csat::GateState::TRUE);
+    ASSERT_TRUE(dag.evaluateCircuit(asmt)->getGateState(3) == csat::GateState::UNDEFINED);
+    asmt.assign(1, csat::GateState::FALSE);
+    ASSERT_TRUE(dag.evaluateCircuit(asmt)->getGateState(2) == csat::GateState::TRUE);
+    ASSERT_TRUE(dag.evaluateCircuit(asmt)->getGateState(3) == csat::GateState::FALSE);
+}
+
+TEST(CsrDAGTest, Simplification)
+{
+    std::string const bench = "INPUT(0)\n"
+                              "INPUT(1)\n"
+                              "INPUT(2)\n"
+                              "OUTPUT(6)\n"
+                              "3 = NOT(0)\n"
+                              "4 = AND(3, 3)\n"
+                              "5 = AND(0, 4)\n"
+                              "6 = OR(1, 2, 5)\n";
+
+    std::istringstream dag_stream(bench);
+    csat::parser::BenchToCircuit<csat::DAG> dag_parser;
+    dag_parser.parseStream(dag_stream);
+    auto [dag, dag_encoder] = csat::simplification::DuplicateOperandsCleaner<csat::DAG>().apply(
+        *dag_parser.instantiate(), dag_parser.getEncoder());
+
+    std::istringstream csr_stream(bench);
+    csat::parser::BenchToCircuit<csat::CsrDAG> csr_parser;
+    csr_parser.parseStream(csr_stream);
+    auto [csr_dag, csr_encoder] = csat::simplification::DuplicateOperandsCleaner<csat::CsrDAG>().apply(
+        *csr_parser.instantiate(), csr_parser.getEncoder());
+
+    ASSERT_EQ(csr_dag->getNumberOfGates(), 3);
+    ASSERT_EQ(dag->getNumberOfGates(), csr_dag->getNumberOfGates());
+    ASSERT_EQ(dag->getOutputGates(), csr_dag->getOutputGates());
+    for (csat::GateId gateId = 0; gateId < dag->getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(dag->getGateType(gateId), csr_dag->getGateType(gateId));
+        ASSERT_EQ(dag->getGateOperands(gateId), csr_dag->getGateOperands(gateId));
+        ASSERT_EQ(dag_encoder->decodeGate(gateId), csr_encoder->decodeGate(gateId));
+    }
+}
+
+TEST(CsrDAGTest, InPlaceModification)
+{
+    auto dag = csat::CsrDAG(
+        {
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::AND, {1, 0}},
+            {csat::GateType::AND, {0, 1}},
+            {csat::GateType::OR, {2, 3}}
+        },
+        {4});
+    ASSERT_EQ(dag.getGateOperands(2), csat::GateIdContainer({0, 1}));
+
+    csat::GateId const not_id = dag.addGate(csat::GateType::NOT, {4});
+    ASSERT_EQ(not_id, 5);
+    ASSERT_EQ(dag.getGateUsers(4), csat::GateIdContainer({5}));
+    dag.setOutputGates({not_id});
+
+    dag.redirectUsers(3, 2);
+    dag.markDead(3);
+    ASSERT_TRUE(dag.hasDeadGates());
+    ASSERT_EQ(dag.getGateOperands(4), csat::GateIdContainer({2, 2}));
+    ASSERT_EQ(dag.getGateUsers(2), csat::GateIdContainer({4, 4}));
+
+    ASSERT_FALSE(dag.updateGate(4, csat::GateType::OR, {2, 2}));
+    ASSERT_TRUE(dag.updateGate(4, csat::GateType::XOR, {2, 0}));
+    ASSERT_EQ(dag.getGateOperands(4), csat::GateIdContainer({0, 2}));
+    ASSERT_EQ(dag.getGateUsers(0), csat::GateIdContainer({2, 3, 4}));
+
+    csat::GateIdContainer const old_to_new = dag.compact();
+    ASSERT_EQ(old_to_new, csat::GateIdContainer({0, 1, 2, SIZE_MAX, 3, 4}));
+    ASSERT_FALSE(dag.hasDeadGates());
+    ASSERT_EQ(dag.getNumberOfGates(), 5);
+    ASSERT_EQ(dag.getGateOperands(3), csat::GateIdContainer({0, 2}));
+    ASSERT_EQ(dag.getGateOperands(4), csat::GateIdContainer({3}));
+    ASSERT_EQ(dag.getGateUsers(0), csat::GateIdContainer({2, 3}));
+    ASSERT_EQ(dag.getOutputGates(), csat::GateIdContainer({4}));
+}
+
+}  // namespace
@@ -176,4 +176,81 @@ TEST(DAGTest, CalculationManyOperands)
     ASSERT_TRUE(dag.getGateUsers(4) == csat::GateIdContainer({}));
 }
 
+TEST(DAGTest, CalculationSharedConeAndAssignedGates)
+{
+    auto dag = csat::DAG(
+        {
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::AND, {0, 1, 2}},
+            {csat::GateType::NXOR, {0, 1, 2}},
+            {csat::GateType::MUX, {0, 3, 4}},
+            {csat::GateType::NOT, {3}},
+            {csat::GateType::OR, {3, 5}}
+        },
+        {5, 6, 7});
+
+    auto asmt = csat::VectorAssignment<>{};
+    asmt.assign(0, csat::GateState::TRUE);
+    asmt.assign(1, csat::GateState::TRUE);
+    asmt.assign(2, csat::GateState::FALSE);
+    auto result = dag.evaluateCircuit(asmt);
+    ASSERT_TRUE(result->getGateState(3) == csat::GateState::FALSE);
+    ASSERT_TRUE(result->getGateState(4) == csat::GateState::TRUE);
+    ASSERT_TRUE(result->getGateState(5) == csat::GateState::TRUE);
+    ASSERT_TRUE(result->getGateState(6) == csat::GateState::TRUE);
+    ASSERT_TRUE(result->getGateState(7) == csat::GateState::TRUE);
+
+    // Operands of assigned gates are not evaluated.
+    auto partial_asmt = csat::VectorAssignment<>{};
+    partial_asmt.assign(0, csat::GateState::FALSE);
+    partial_asmt.assign(3, csat::GateState::TRUE);
+    auto partial_result = dag.evaluateCircuit(partial_asmt);
+    ASSERT_TRUE(partial_result->getGateState(3) == csat::GateState::TRUE);
+    ASSERT_TRUE(partial_result->getGateState(4) == csat::GateState::UNDEFINED);
+    ASSERT_TRUE(partial_result->getGateState(5) == csat::GateState::TRUE);
+    ASSERT_TRUE(partial_result->getGateState(6) == csat::GateState::FALSE);
+    ASSERT_TRUE(partial_result->getGateState(7) == csat::GateState::TRUE);
+}
+
+TEST(DAGTest, InPlaceModification)
+{
+    auto dag = csat::DAG(
+        {
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::INPUT, {}},
+            {csat::GateType::AND, {1, 0}},
+            {csat::GateType::AND, {0, 1}},
+            {csat::GateType::OR, {2, 3}}
+        },
+        {4});
+    ASSERT_EQ(dag.getGateOperands(2), csat::GateIdContainer({0, 1}));
+
+    csat::GateId const not_id = dag.addGate(csat::GateType::NOT, {4});
+    ASSERT_EQ(not_id, 5);
+    ASSERT_EQ(dag.getGateUsers(4), csat::GateIdContainer({5}));
+    dag.setOutputGates({not_id});
+
+    dag.redirectUsers(3, 2);
+    dag.markDead(3);
+    ASSERT_TRUE(dag.hasDeadGates());
+    ASSERT_EQ(dag.getGateOperands(4), csat::GateIdContainer({2, 2}));
+    ASSERT_EQ(dag.getGateUsers(2), csat::GateIdContainer({4, 4}));
+
+    ASSERT_FALSE(dag.updateGate(4, csat::GateType::OR, {2, 2}));
+    ASSERT_TRUE(dag.updateGate(4, csat::GateType::XOR, {2, 0}));
+    ASSERT_EQ(dag.getGateOperands(4), csat::GateIdContainer({0, 2}));
+    ASSERT_EQ(dag.getGateUsers(0), csat::GateIdContainer({2, 3, 4}));
+
+    csat::GateIdContainer const old_to_new = dag.compact();
+    ASSERT_EQ(old_to_new, csat::GateIdContainer({0, 1, 2, SIZE_MAX, 3, 4}));
+    ASSERT_FALSE(dag.hasDeadGates());
+    ASSERT_EQ(dag.getNumberOfGates(), 5);
+    ASSERT_EQ(dag.getGateOperands(3), csat::GateIdContainer({0, 2}));
+    ASSERT_EQ(dag.getGateOperands(4), csat::GateIdContainer({3}));
+    ASSERT_EQ(dag.getGateUsers(0), csat::GateIdContainer({2, 3}));
+    ASSERT_EQ(dag.getOutputGates(), csat::GateIdContainer({4}));
+}
+
 } // namespace
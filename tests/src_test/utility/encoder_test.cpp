@@ -41,34 +41,38 @@ TEST(EncoderTest, EncodeDecode)
 }
 
 
-TEST(EncoderTest, Merge)
+TEST(EncoderTest, Renumber)
 {
-    logger.info("Testing simple encoder merging cases");
-    
-    GateEncoder<std::string> first;
-    first.encodeGate("a");
-    first.encodeGate("b");
-    first.encodeGate("c");
-    first.encodeGate("d");
-    first.encodeGate("e");
-    
-    GateEncoder<GateId> second;
-    second.encodeGate(0);
-    second.encodeGate(2);
-    second.encodeGate(3);
-    
-    auto merged = mergeGateEncoders(first, second);
-    
-    ASSERT_TRUE(merged->size() == 3);
+    logger.info("Testing renumbering of gates");
 
-    ASSERT_TRUE(merged->decodeGate(0) == "a");
-    ASSERT_TRUE(merged->encodeGate("a") == second.encodeGate(first.encodeGate("a")));
-    
-    ASSERT_TRUE(merged->decodeGate(1) == "c");
-    ASSERT_TRUE(merged->encodeGate("c") == second.encodeGate(first.encodeGate("c")));
-    
-    ASSERT_TRUE(merged->decodeGate(2) == "d");
-    ASSERT_TRUE(merged->encodeGate("d") == second.encodeGate(first.encodeGate("d")));
+    GateEncoder<std::string> enc;
+    for (std::string const name : {"a", "b", "c", "d", "e"})
+    {
+        enc.encodeGate(name);
+    }
+
+    enc.renumber({2, SIZE_MAX, 0, SIZE_MAX, 1});
+
+    ASSERT_TRUE(enc.size() == 3);
+    ASSERT_TRUE(enc.decodeGate(0) == "c");
+    ASSERT_TRUE(enc.decodeGate(1) == "e");
+    ASSERT_TRUE(enc.decodeGate(2) == "a");
+    ASSERT_TRUE(enc.encodeGate("a") == 2);
+    ASSERT_FALSE(enc.keyExists("b"));
+    ASSERT_FALSE(enc.keyExists("d"));
+
+    // Dropped names get new ids, when encoded again.
+    ASSERT_TRUE(enc.encodeGate("d") == 3);
+    ASSERT_TRUE(enc.keyExists("d"));
+    ASSERT_TRUE(enc.decodeGate(3) == "d");
+
+    // Renumbering, that drops most of names, compacts their storage.
+    enc.renumber({SIZE_MAX, SIZE_MAX, SIZE_MAX, 0});
+    ASSERT_TRUE(enc.size() == 1);
+    ASSERT_TRUE(enc.decodeGateView(0) == "d");
+    ASSERT_TRUE(enc.encodeGate("f") == 1);
+    ASSERT_TRUE(enc.encodeGate("d") == 0);
+    ASSERT_FALSE(enc.keyExists("a"));
 }
 
 } // namespace
@@ -0,0 +1,96 @@
+#include "src/utility/levelization.hpp"
+
+#include <vector>
+
+#include "src/algo.hpp"
+#include "src/common/csat_types.hpp"
+#include "src/generation/circuit_generator.hpp"
+#include "src/structures/assignment/vector_assignment.hpp"
+#include "src/structures/circuit/dag.hpp"
+#include "src/utility/thread_pool.hpp"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat;
+
+TEST(LevelizationTest, GatesAreGroupedByDepth)
+{
+    DAG const circuit(
+        {
+            {GateType::AND, {3, 4}},
+            {GateType::NOT, {0}},
+            {GateType::INPUT, {}},
+            {GateType::INPUT, {}},
+            {GateType::NOT, {2}},
+            {GateType::CONST_TRUE, {}},
+            {GateType::OR, {1, 5}},
+        },
+        {6});
+    utils::Levelization const levels = algo::levelize(circuit);
+    ASSERT_EQ(levels.getNumberOfLevels(), 5);
+    ASSERT_EQ(levels.getGates().size(), circuit.getNumberOfGates());
+    // Gates of a level keep their topological order.
+    std::vector<GateIdContainer> const expected{{3, 2, 5}, {4}, {0}, {1}, {6}};
+    for (size_t level = 0; level < levels.getNumberOfLevels(); ++level)
+    {
+        GateIdSpan const gates = levels.getLevel(level);
+        ASSERT_EQ(GateIdContainer(gates.begin(), gates.end()), expected[level]) << "level " << level;
+    }
+
+    ASSERT_EQ(utils::Levelization().getNumberOfLevels(), 0);
+}
+
+TEST(LevelizationTest, OperandsAreProcessedBeforeUsers)
+{
+    DAG const circuit = generation::generateDAG(
+        {.family = generation::Family::RANDOM, .size = 20'000, .inputs = 100, .outputs = 10, .depth = 50});
+    utils::Levelization const levels = algo::levelize(circuit);
+
+    utils::ThreadPool pool(4);
+    std::vector<size_t> depth(circuit.getNumberOfGates(), SIZE_MAX);
+    utils::parallelForEachLevel(
+        pool,
+        levels,
+        [&circuit, &depth](GateId gateId)
+        {
+            size_t gate_depth = 0;
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                // Operand must already be processed.
+                gate_depth = std::max(gate_depth, depth[operand] + 1);
+            }
+            depth[gateId] = gate_depth;
+        },
+        16);
+    for (size_t level = 0; level < levels.getNumberOfLevels(); ++level)
+    {
+        for (GateId const gateId : levels.getLevel(level))
+        {
+            ASSERT_EQ(depth[gateId], level);
+        }
+    }
+}
+
+TEST(LevelizationTest, ParallelEvaluation)
+{
+    DAG const circuit = generation::generateDAG(
+        {.family = generation::Family::RANDOM, .size = 20'000, .inputs = 100, .outputs = 50, .depth = 50});
+    VectorAssignment<> assignment{};
+    for (size_t input = 0; input < circuit.getInputGates().size(); input += 2)
+    {
+        assignment.assign(circuit.getInputGates()[input], input % 4 == 0 ? GateState::TRUE : GateState::FALSE);
+    }
+
+    utils::ThreadPool pool(4);
+    auto const sequential = circuit.evaluateCircuit(assignment);
+    auto const parallel   = circuit.evaluateCircuit(assignment, &pool);
+    for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        ASSERT_EQ(parallel->getGateState(gateId), sequential->getGateState(gateId)) << "gate " << gateId;
+    }
+}
+
+}  // namespace
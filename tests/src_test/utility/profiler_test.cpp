@@ -0,0 +1,66 @@
+#include "src/utility/profiler.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat::profiling;
+
+TEST(ProfilerTest, SectionsAreSharedByName)
+{
+    Section& section = Profiler::getInstance().getSection("ProfilerTest::shared");
+    ASSERT_EQ(&section, &Profiler::getInstance().getSection("ProfilerTest::shared"));
+    ASSERT_NE(&section, &Profiler::getInstance().getSection("ProfilerTest::other"));
+}
+
+TEST(ProfilerTest, ScopedTimersFromSeveralThreads)
+{
+    Section& section = Profiler::getInstance().getSection("ProfilerTest::timer");
+    Profiler::getInstance().reset();
+
+    std::vector<std::thread> threads{};
+    for (size_t thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back(
+            [&section]()
+            {
+                for (size_t call = 0; call < 1000; ++call)
+                {
+                    ScopedTimer const timer(section);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(section.calls.load(), 4000);
+
+    Profiler::getInstance().getSection("ProfilerTest::counter").count += 42;
+    std::ostringstream report;
+    Profiler::getInstance().report(report);
+    ASSERT_NE(report.str().find("ProfilerTest::timer"), std::string::npos);
+    ASSERT_NE(report.str().find("ProfilerTest::counter"), std::string::npos);
+    // Sections, which were neither executed nor counted, are not reported.
+    ASSERT_EQ(report.str().find("ProfilerTest::other"), std::string::npos);
+
+    Profiler::getInstance().reset();
+    ASSERT_EQ(section.calls.load(), 0);
+    ASSERT_EQ(section.nanoseconds.load(), 0);
+}
+
+TEST(ProfilerTest, CountedValueIsEvaluatedWithoutProfiling)
+{
+    // Value is used regardless of ENABLE_PROFILING, so it triggers no unused variable warnings.
+    size_t evaluations = 0;
+    CSAT_PROFILE_COUNT("ProfilerTest::evaluated", ++evaluations);
+    ASSERT_EQ(evaluations, 1);
+}
+
+}  // namespace
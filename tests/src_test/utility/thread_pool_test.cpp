@@ -0,0 +1,85 @@
+#include "src/utility/thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace csat::utils;
+
+TEST(ThreadPoolTest, EachIndexIsVisitedOnce)
+{
+    for (size_t const threads : {1, 2, 4})
+    {
+        ThreadPool pool(threads);
+        ASSERT_EQ(pool.getNumberOfThreads(), threads);
+        for (size_t const size : {0, 1, 7, 1000, 100'000})
+        {
+            std::vector<std::atomic<int>> visits(size);
+            pool.parallelFor(size, [&visits](size_t index) { ++visits[index]; }, 16);
+            for (size_t index = 0; index < size; ++index)
+            {
+                ASSERT_EQ(visits[index], 1) << "size " << size << ", index " << index;
+            }
+        }
+    }
+}
+
+TEST(ThreadPoolTest, RangesAreDisjointAndAtLeastGrain)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10'000);
+    std::atomic<size_t> short_ranges{0};
+    pool.parallelForRanges(
+        visits.size(),
+        100,
+        [&](size_t begin, size_t end)
+        {
+            short_ranges += (end - begin < 100) ? 1 : 0;
+            for (size_t index = begin; index < end; ++index)
+            {
+                ++visits[index];
+            }
+        });
+    ASSERT_EQ(short_ranges, 0);
+    for (auto const& visit : visits)
+    {
+        ASSERT_EQ(visit, 1);
+    }
+}
+
+TEST(ThreadPoolTest, ConcurrentAndNestedLoops)
+{
+    ThreadPool pool(3);
+    std::atomic<size_t> sum{0};
+
+    // Several threads share the pool, and each of them runs loops with nested loops.
+    std::vector<std::thread> threads{};
+    for (size_t thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back(
+            [&pool, &sum]()
+            {
+                for (size_t loop = 0; loop < 20; ++loop)
+                {
+                    pool.parallelFor(
+                        64,
+                        [&pool, &sum](size_t)
+                        { pool.parallelFor(100, [&sum](size_t index) { sum += index; }, 1); },
+                        1);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(sum, 4 * 20 * 64 * (99 * 100 / 2));
+}
+
+}  // namespace